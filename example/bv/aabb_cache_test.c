@@ -0,0 +1,51 @@
+#include <zeo/zeo.h>
+
+#define N 10000
+#define M 1000
+
+void frame_create_rand(zFrame3D *f)
+{
+  zVec3D aa;
+
+  zVec3DCreate( zFrame3DPos(f), zRandF(-5,5), zRandF(-5,5), zRandF(-5,5) );
+  zVec3DCreate( &aa, zRandF(-zPI,zPI), zRandF(-zPI,zPI), zRandF(-zPI,zPI) );
+  zMat3DFromAA( zFrame3DAtt(f), &aa );
+}
+
+bool aabox_include(zAABox3D *b1, zAABox3D *b2)
+{
+  return zAABox3DPointIsInside( b1, &b2->min, true ) &&
+         zAABox3DPointIsInside( b1, &b2->max, true );
+}
+
+int main(void)
+{
+  zVec3D v[N];
+  zAABBCache loose, tight;
+  zAABox3D bb, bb_loose, bb_tight;
+  zFrame3D f;
+  clock_t c[3] = { 0, 0, 0 }, c0;
+  int err_loose = 0, err_tight = 0;
+  register int i;
+
+  zRandInit();
+  for( i=0; i<N; i++ )
+    zVec3DCreatePolar( &v[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  zAABBCacheCreate( &loose, v, N, false );
+  zAABBCacheCreate( &tight, v, N, true );
+  printf( "number of vertices of convex hull = %d\n", zPH3DVertNum(&tight.hull) );
+  for( i=0; i<M; i++ ){
+    frame_create_rand( &f );
+    c0 = clock(); zAABBXform( &bb, v, N, &f ); c[0] += clock() - c0;
+    c0 = clock(); zAABBCacheXform( &loose, &f, &bb_loose ); c[1] += clock() - c0;
+    c0 = clock(); zAABBCacheXform( &tight, &f, &bb_tight ); c[2] += clock() - c0;
+    if( !aabox_include( &bb_loose, &bb ) ) err_loose++;
+    if( !zVec3DEqual( &bb_tight.min, &bb.min ) || !zVec3DEqual( &bb_tight.max, &bb.max ) ) err_tight++;
+  }
+  printf( "all points: %g msec\n", (double)c[0] / CLOCKS_PER_SEC * 1000 );
+  printf( "loose     : %g msec, %d failures\n", (double)c[1] / CLOCKS_PER_SEC * 1000, err_loose );
+  printf( "tight     : %g msec, %d failures\n", (double)c[2] / CLOCKS_PER_SEC * 1000, err_tight );
+  zAABBCacheDestroy( &loose );
+  zAABBCacheDestroy( &tight );
+  return 0;
+}
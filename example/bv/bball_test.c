@@ -0,0 +1,40 @@
+#include <zeo/zeo_bv.h>
+
+#define N 10000
+
+/* check if all points are inside of a ball */
+int check(zSphere3D *bb, zVec3D p[], int n)
+{
+  int err = 0;
+  register int i;
+
+  for( i=0; i<n; i++ )
+    if( !zSphere3DPointIsInside( bb, &p[i], true ) ) err++;
+  return err;
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D p[N], *vp[4];
+  zSphere3D bb;
+  clock_t c;
+  int num;
+  register int i;
+
+  zRandInit();
+  for( i=0; i<N; i++ ){
+    zVec3DCreatePolar( &p[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+    p[i].c.x = 3 * p[i].c.x + 1;
+    p[i].c.y = 2 * p[i].c.y - 1;
+  }
+  c = clock();
+  num = zBBall( &bb, p, N, vp );
+  printf( "smallest   : radius %g, %d points outside, %g msec\n", zSphere3DRadius(&bb), check(&bb,p,N), (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  printf( "center: " ); zVec3DPrint( zSphere3DCenter(&bb) );
+  for( i=0; i<num; i++ )
+    printf( "support point #%d: distance to the center %g\n", i, zVec3DDist( zSphere3DCenter(&bb), vp[i] ) );
+  c = clock();
+  zBBallFast( &bb, p, N );
+  printf( "approximate: radius %g, %d points outside, %g msec\n", zSphere3DRadius(&bb), check(&bb,p,N), (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,60 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+#define M 1000
+
+/* random points in a rotated thin box */
+void points_create_rand(zVec3D p[], int n)
+{
+  zVec3D c, aa;
+  zMat3D r;
+  register int i;
+
+  zVec3DCreate( &c, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+  zVec3DCreate( &aa, zRandF(-zPI,zPI), zRandF(-zPI,zPI), zRandF(-zPI,zPI) );
+  zMat3DFromAA( &r, &aa );
+  for( i=0; i<n; i++ ){
+    zVec3DCreate( &aa, zRandF(-1,1), zRandF(-0.1,0.1), zRandF(-0.1,0.1) );
+    zMulMat3DVec3D( &r, &aa, &p[i] );
+    zVec3DAddDRC( &p[i], &c );
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D p[2][N];
+  zAABox3D aabb[2];
+  zKDOP3D kdop[2];
+  zPH3D ph;
+  int k[] = { 14, 18, 26 }, col[4], err = 0;
+  register int i, j, l;
+
+  zRandInit();
+  /* containment and volume */
+  points_create_rand( p[0], N );
+  zAABB( &aabb[0], p[0], N, NULL );
+  printf( "AABB    : volume %g\n", zAABox3DVolume(&aabb[0]) );
+  for( j=0; j<3; j++ ){
+    zKDOP( &kdop[0], k[j], p[0], N );
+    for( i=0; i<N; i++ )
+      if( !zKDOP3DPointIsInside( &kdop[0], &p[0][i], true ) ) err++;
+    zKDOP3DToPH3D( &kdop[0], &ph );
+    printf( "%d-DOP  : volume %g, %d vertices, %d faces, %d points outside\n", k[j], zPH3DVolume(&ph), zPH3DVertNum(&ph), zPH3DFaceNum(&ph), err );
+    zPH3DDestroy( &ph );
+  }
+  /* culling rate */
+  for( j=0; j<4; j++ ) col[j] = 0;
+  for( l=0; l<M; l++ ){
+    for( i=0; i<2; i++ ){
+      points_create_rand( p[i], N );
+      zAABB( &aabb[i], p[i], N, NULL );
+    }
+    if( zColChkAABox3D( &aabb[0], &aabb[1] ) ) col[0]++;
+    for( j=0; j<3; j++ ){
+      for( i=0; i<2; i++ ) zKDOP( &kdop[i], k[j], p[i], N );
+      if( zColChkKDOP3D( &kdop[0], &kdop[1] ) ) col[j+1]++;
+    }
+  }
+  printf( "overlapping pairs in %d: AABB %d, 14-DOP %d, 18-DOP %d, 26-DOP %d\n", M, col[0], col[1], col[2], col[3] );
+  return EXIT_SUCCESS;
+}
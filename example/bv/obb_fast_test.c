@@ -0,0 +1,43 @@
+#include <zeo/zeo_bv.h>
+
+#define N 10000
+
+/* check if all points are inside of a box */
+int check(zBox3D *box, zVec3D p[], int n)
+{
+  int err = 0;
+  register int i;
+
+  for( i=0; i<n; i++ )
+    if( !zBox3DPointIsInside( box, &p[i], true ) && zBox3DPointDist( box, &p[i] ) > 1.0e-10 ) err++;
+  return err;
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D p[N], d, org;
+  zMat3D ori;
+  zBox3D obb;
+  clock_t c;
+  int iter;
+  register int i;
+
+  zRandInit();
+  zVec3DCreate( &org, 1, 2, 3 );
+  zMat3DFromZYX( &ori, zDeg2Rad(10), zDeg2Rad(20), zDeg2Rad(30) );
+  for( i=0; i<N; i++ ){
+    zVec3DCreatePolar( &d, zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+    d.c.x *= 3; d.c.y *= 2;
+    zMulMat3DVec3DDRC( &ori, &d );
+    zVec3DAdd( &org, &d, &p[i] );
+  }
+  c = clock();
+  zOBB( &obb, p, N );
+  printf( "exact     : volume %g, %d points outside, %g msec\n", zBox3DVolume(&obb), check(&obb,p,N), (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  for( iter=0; iter<=8; iter+=4 ){
+    c = clock();
+    zOBBFast( &obb, p, N, iter );
+    printf( "fast (%d) : volume %g, %d points outside, %g msec\n", iter, zBox3DVolume(&obb), check(&obb,p,N), (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  }
+  return EXIT_SUCCESS;
+}
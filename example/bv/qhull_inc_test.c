@@ -0,0 +1,38 @@
+#include <zeo/zeo_bv.h>
+
+#define N     100000
+#define BATCH 500
+
+int main(int argc, char *argv[])
+{
+  zVec3D *v;
+  zCH3DInc inc;
+  zPH3D ch1, ch2;
+  clock_t c;
+  int n;
+  register int i;
+
+  n = argc > 1 ? atoi( argv[1] ) : N;
+  if( !( v = zAlloc( zVec3D, n ) ) ) return EXIT_FAILURE;
+  zRandInit();
+  for( i=0; i<n; i++ )
+    zVec3DCreatePolar( &v[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  /* points arrive in batches */
+  zCH3DIncInit( &inc );
+  c = clock();
+  for( i=0; i<n; i+=BATCH )
+    if( zCH3DIncAdd( &inc, v+i, _zMin( BATCH, n-i ) ) < 0 ) return EXIT_FAILURE;
+  printf( "incremental: %g msec for %d batches\n", (double)( clock() - c ) / CLOCKS_PER_SEC * 1000, ( n - 1 ) / BATCH + 1 );
+  if( !zCH3DInc2PH3D( &inc, &ch1 ) ) return EXIT_FAILURE;
+  zCH3DIncDestroy( &inc );
+  /* from scratch */
+  c = clock();
+  if( !zCH3D( &ch2, v, n ) ) return EXIT_FAILURE;
+  printf( "from scratch: %g msec\n", (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  printf( "incremental : %d vertices, %d faces, volume %g\n", zPH3DVertNum(&ch1), zPH3DFaceNum(&ch1), zPH3DVolume(&ch1) );
+  printf( "from scratch: %d vertices, %d faces, volume %g\n", zPH3DVertNum(&ch2), zPH3DFaceNum(&ch2), zPH3DVolume(&ch2) );
+  zPH3DDestroy( &ch1 );
+  zPH3DDestroy( &ch2 );
+  zFree( v );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,32 @@
+#include <zeo/zeo_bv.h>
+
+#define N 1000000
+
+int main(int argc, char *argv[])
+{
+  zVec3D *v;
+  zPH3D ch;
+  clock_t c;
+  int n, err = 0;
+  register int i, j;
+
+  n = argc > 1 ? atoi( argv[1] ) : N;
+  if( !( v = zAlloc( zVec3D, n ) ) ) return EXIT_FAILURE;
+  zRandInit();
+  for( i=0; i<n; i++ )
+    zVec3DCreatePolar( &v[i], zRandF(0,1), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  c = clock();
+  if( !zCH3D( &ch, v, n ) ) return EXIT_FAILURE;
+  printf( "%d points -> %d vertices, %d faces in %g msec\n", n, zPH3DVertNum(&ch), zPH3DFaceNum(&ch), (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  /* check if sampled points are inside of the convex hull */
+  for( i=0; i<n; i+=n/1000+1 )
+    for( j=0; j<zPH3DFaceNum(&ch); j++ )
+      if( zTri3DPointDist( zPH3DFace(&ch,j), &v[i] ) > zTOL ){
+        err++;
+        break;
+      }
+  printf( "%d points outside\n", err );
+  zPH3DDestroy( &ch );
+  zFree( v );
+  return EXIT_SUCCESS;
+}
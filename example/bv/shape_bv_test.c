@@ -0,0 +1,68 @@
+#include <zeo/zeo.h>
+
+void bv_print(zShape3D *s)
+{
+  zAABox3D *aabb;
+  zBox3D *obb;
+  zSphere3D *bb;
+  zPH3D *ch;
+
+  ch = zShape3DCH( s );
+  printf( "convex hull: %d vertices, volume %g\n", zPH3DVertNum(ch), zPH3DVolume(ch) );
+  aabb = zShape3DAABB( s );
+  printf( "AABB: volume %g\n", zAABox3DVolume(aabb) );
+  printf( " min: " ); zVec3DPrint( &aabb->min );
+  printf( " max: " ); zVec3DPrint( &aabb->max );
+  obb = zShape3DOBB( s );
+  printf( "OBB: volume %g\n", zBox3DVolume(obb) );
+  printf( " center: " ); zVec3DPrint( zBox3DCenter(obb) );
+  bb = zShape3DBBall( s );
+  printf( "bounding ball: radius %g\n", zSphere3DRadius(bb) );
+  printf( " center: " ); zVec3DPrint( zSphere3DCenter(bb) );
+}
+
+int main(void)
+{
+  zMShape3D ms;
+  zShape3D s, *sp;
+  zVec3D c1 = { { 0, 0, 0 } }, c2 = { { 0.1,-0.1, 0.3 } };
+  zFrame3D f;
+  zAABox3D aabb;
+  zSphere3D bb;
+  clock_t c;
+
+  zShape3DInit( &s );
+  zShape3DCylCreate( &s, &c1, &c2, 0.06, 64 );
+  zNameSet( &s, "cylinder" );
+  c = clock();
+  zShape3DAABB( &s );
+  printf( "first request: %g msec\n", (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  c = clock();
+  zShape3DAABB( &s );
+  printf( "cached request: %g msec\n", (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  printf( "[original]\n" );
+  bv_print( &s );
+
+  /* bounding volumes of a transformed shape */
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, 2 );
+  sp = zMShape3DShape(&ms,0);
+  zShape3DClone( &s, sp, NULL );
+  zShape3DClone( &s, zMShape3DShape(&ms,1), NULL );
+  zShape3DAABB( sp );
+  zFrame3DFromZYX( &f, 0.5, 0, 0, zDeg2Rad(90), 0, 0 );
+  zShape3DXform( &s, &f, sp );
+  printf( "[transformed]\n" );
+  bv_print( sp );
+
+  /* bounding volumes of multiple shapes */
+  printf( "[multiple shapes]\n" );
+  zMShape3DAABB( &ms, &aabb );
+  printf( "AABB: volume %g\n", zAABox3DVolume(&aabb) );
+  zMShape3DBBall( &ms, &bb );
+  printf( "bounding ball: radius %g\n", zSphere3DRadius(&bb) );
+
+  zMShape3DDestroy( &ms );
+  zShape3DDestroy( &s );
+  return 0;
+}
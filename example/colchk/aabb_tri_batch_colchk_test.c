@@ -0,0 +1,94 @@
+#include <zeo/zeo.h>
+
+#define N 100000
+
+void vec_create_rand(zVec3D *v, double r)
+{
+  zVec3DCreate( v, zRandF(-r,r), zRandF(-r,r), zRandF(-r,r) );
+}
+
+void aabox_create_rand(zAABox3D *box)
+{
+  zVec3D c;
+  double dx, dy, dz;
+
+  vec_create_rand( &c, 2 );
+  dx = zRandF(0.05,1);
+  dy = zRandF(0.05,1);
+  dz = zRandF(0.05,1);
+  zAABox3DCreate( box, c.c.x-dx, c.c.y-dy, c.c.z-dz, c.c.x+dx, c.c.y+dy, c.c.z+dz );
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D *v, n;
+  zTri3D *tri;
+  zPlane3D plane;
+  zAABox3D *box;
+  zTri3DSoA tsoa;
+  zAABox3DSoA bsoa;
+  unsigned char *mask;
+  int count, err;
+  clock_t c;
+  register int i;
+
+  zRandInit();
+  v = zAlloc( zVec3D, 3*N );
+  tri = zAlloc( zTri3D, N );
+  box = zAlloc( zAABox3D, N );
+  mask = zAlloc( unsigned char, zColChkBitmaskSize(N) );
+  zTri3DSoAAlloc( &tsoa, N );
+  zAABox3DSoAAlloc( &bsoa, N );
+  for( i=0; i<N; i++ ){
+    vec_create_rand( &v[3*i], 2 );
+    vec_create_rand( &v[3*i+1], 2 );
+    vec_create_rand( &v[3*i+2], 2 );
+    zTri3DCreate( &tri[i], &v[3*i], &v[3*i+1], &v[3*i+2] );
+    zTri3DSoASet( &tsoa, i, &tri[i] );
+    aabox_create_rand( &box[i] );
+    zAABox3DSoASet( &bsoa, i, &box[i] );
+  }
+  /* triangles vs. one box */
+  c = clock();
+  for( count=0, i=0; i<N; i++ )
+    if( zColChkTriAABox3D( &tri[i], &box[0] ) ) count++;
+  printf( "triangles (one by one): %d in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  c = clock();
+  count = zColChkTriAABox3DBatch( &tsoa, &box[0], mask );
+  printf( "triangles (batch)     : %d in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  for( err=0, i=0; i<N; i++ )
+    if( zColChkBitmaskIsSet( mask, i ) != zColChkTriAABox3D( &tri[i], &box[0] ) ) err++;
+  printf( "%d mismatches\n", err );
+  /* boxes vs. one triangle */
+  c = clock();
+  for( count=0, i=0; i<N; i++ )
+    if( zColChkTriAABox3D( &tri[0], &box[i] ) ) count++;
+  printf( "boxes (one by one)    : %d in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  c = clock();
+  count = zColChkAABox3DTriBatch( &bsoa, &tri[0], mask );
+  printf( "boxes (batch)         : %d in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  for( err=0, i=0; i<N; i++ )
+    if( zColChkBitmaskIsSet( mask, i ) != zColChkTriAABox3D( &tri[0], &box[i] ) ) err++;
+  printf( "%d mismatches\n", err );
+  /* boxes vs. one plane */
+  vec_create_rand( &n, 1 );
+  zVec3DNormalizeDRC( &n );
+  zPlane3DCreate( &plane, &v[0], &n );
+  c = clock();
+  for( count=0, i=0; i<N; i++ )
+    if( zColChkPlaneAABox3D( &plane, &box[i] ) ) count++;
+  printf( "plane (one by one)    : %d in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  c = clock();
+  count = zColChkPlaneAABox3DBatch( &plane, &bsoa, mask );
+  printf( "plane (batch)         : %d in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  for( err=0, i=0; i<N; i++ )
+    if( zColChkBitmaskIsSet( mask, i ) != zColChkPlaneAABox3D( &plane, &box[i] ) ) err++;
+  printf( "%d mismatches\n", err );
+  zTri3DSoAFree( &tsoa );
+  zAABox3DSoAFree( &bsoa );
+  zFree( v );
+  zFree( tri );
+  zFree( box );
+  zFree( mask );
+  return 0;
+}
@@ -0,0 +1,62 @@
+#include <zeo/zeo.h>
+
+#define N 100000
+
+void box_create_rand(zBox3D *box)
+{
+  zVec3D c, aa;
+
+  zVec3DCreate( &c, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+  zVec3DCreate( &aa, zRandF(-zPI,zPI), zRandF(-zPI,zPI), zRandF(-zPI,zPI) );
+  zBox3DInit( box );
+  zVec3DCopy( &c, zBox3DCenter(box) );
+  zMat3DFromAA( zFrame3DAtt(&box->f), &aa );
+  zBox3DSetDepth( box, zRandF(0.1,2) );
+  zBox3DSetWidth( box, zRandF(0.1,2) );
+  zBox3DSetHeight( box, zRandF(0.1,2) );
+}
+
+int main(int argc, char *argv[])
+{
+  zBox3D *b1, *b2;
+  zBox3DSoA soa1, soa2;
+  bool *result;
+  int count, err = 0;
+  clock_t c;
+  register int i;
+
+  zRandInit();
+  b1 = zAlloc( zBox3D, N );
+  b2 = zAlloc( zBox3D, N );
+  result = zAlloc( bool, N );
+  zBox3DSoAAlloc( &soa1, N );
+  zBox3DSoAAlloc( &soa2, N );
+  for( i=0; i<N; i++ ){
+    box_create_rand( &b1[i] );
+    box_create_rand( &b2[i] );
+    zBox3DSoASet( &soa1, i, &b1[i] );
+    zBox3DSoASet( &soa2, i, &b2[i] );
+  }
+  c = clock();
+  for( count=0, i=0; i<N; i++ )
+    if( zColChkBox3D( &b1[i], &b2[i] ) ) count++;
+  printf( "one by one: %d pairs in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  c = clock();
+  count = zColChkBox3DBatch( &soa1, &soa2, result );
+  printf( "batch     : %d pairs in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  for( i=0; i<N; i++ )
+    if( result[i] != zColChkBox3D( &b1[i], &b2[i] ) ) err++;
+  printf( "%d mismatches\n", err );
+  c = clock();
+  count = zColChkBox3DBatchOne( &b1[0], &soa2, result );
+  printf( "one to all: %d pairs in collision, %g msec\n", count, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  for( err=0, i=0; i<N; i++ )
+    if( result[i] != zColChkBox3D( &b1[0], &b2[i] ) ) err++;
+  printf( "%d mismatches\n", err );
+  zBox3DSoAFree( &soa1 );
+  zBox3DSoAFree( &soa2 );
+  zFree( b1 );
+  zFree( b2 );
+  zFree( result );
+  return 0;
+}
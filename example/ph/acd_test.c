@@ -0,0 +1,31 @@
+#include <zeo/zeo.h>
+
+#define DIV 32
+
+#define R1 1.0
+#define R2 0.3
+
+int main(int argc, char *argv[])
+{
+  zVec3D loop[DIV], axis;
+  zPH3D torus;
+  zMShape3D ms;
+  zACDParam param;
+  double vol = 0;
+  register int i;
+
+  for( i=0; i<DIV; i++ )
+    zVec3DCreate( &loop[i], R1 + R2*cos(zPIx2*i/DIV), 0, R2*sin(zPIx2*i/DIV) );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  if( !zPH3DTorus( &torus, loop, DIV, DIV, ZVEC3DZERO, &axis ) ) return EXIT_FAILURE;
+  zACDParamInit( &param );
+  param.concavity = 0.02;
+  if( !zPH3DConvexDecompCache( &torus, &param, &ms, "." ) ) return EXIT_FAILURE;
+  for( i=0; i<zMShape3DShapeNum(&ms); i++ )
+    vol += zPH3DVolume( zShape3DPH(zMShape3DShape(&ms,i)) );
+  printf( "%d pieces\n", zMShape3DShapeNum(&ms) );
+  printf( "volume: torus=%g, pieces=%g\n", zPH3DVolume(&torus), vol );
+  zMShape3DDestroy( &ms );
+  zPH3DDestroy( &torus );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+#include <zeo/zeo.h>
+
+#define DIV 64
+#define N   10000
+
+#define R1 1.0
+#define R2 0.3
+
+/* signed distance to the exact torus */
+double torus_dist(zVec3D *p)
+{
+  return sqrt( zSqr( sqrt( zSqr(p->c.x) + zSqr(p->c.y) ) - R1 ) + zSqr(p->c.z) ) - R2;
+}
+
+int main(int argc, char *argv[])
+{
+  zVec3D loop[DIV], axis, p[N];
+  bool inside[N];
+  zPH3D torus;
+  zPH3DBVH bvh;
+  double theta;
+  int n, err = 0;
+  register int i;
+
+  zRandInit();
+  for( i=0; i<DIV; i++ ){
+    theta = zPIx2 * i / DIV;
+    zVec3DCreate( &loop[i], R1 + R2*cos(theta), 0, R2*sin(theta) );
+  }
+  zVec3DCreate( &axis, 0, 0, 1 );
+  if( !zPH3DTorus( &torus, loop, DIV, DIV, ZVEC3DZERO, &axis ) ||
+      !zPH3DBVHBuild( &bvh, &torus ) ) return EXIT_FAILURE;
+  for( i=0; i<N; i++ )
+    zVec3DCreate( &p[i], zRandF(-1.5,1.5), zRandF(-1.5,1.5), zRandF(-0.5,0.5) );
+  n = zPH3DBVHPointArrayIsInside( &bvh, p, N, false, inside );
+  for( i=0; i<N; i++ ) /* points close to the surface are skipped due to the discretization */
+    if( fabs( torus_dist( &p[i] ) ) > 0.01 && inside[i] != ( torus_dist( &p[i] ) < 0 ) ) err++;
+  printf( "%d/%d points inside, %d misjudged\n", n, N, err );
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &torus );
+  return EXIT_SUCCESS;
+}
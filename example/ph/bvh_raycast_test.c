@@ -0,0 +1,42 @@
+#include <zeo/zeo.h>
+#include <time.h>
+
+#define N 10000
+
+int main(int argc, char *argv[])
+{
+  zSphere3D sphere;
+  zPH3D ph;
+  zPH3DBVH bvh;
+  zRay3D ray;
+  zVec3D org, dir, n1, n2;
+  double d1, d2, err = 0;
+  bool h1, h2;
+  int miss = 0;
+  clock_t t1 = 0, t2 = 0, t;
+  register int i;
+
+  zRandInit();
+  zSphere3DCreate( &sphere, ZVEC3DZERO, 1.0, argc > 1 ? atoi( argv[1] ) : 128 );
+  if( !zSphere3DToPH( &sphere, &ph ) ) return EXIT_FAILURE;
+  if( !zPH3DBVHBuild( &bvh, &ph ) ) return EXIT_FAILURE;
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &org, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+    zVec3DCreate( &dir, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    if( !zRay3DCreate( &ray, &org, &dir ) ) continue;
+    d1 = d2 = HUGE_VAL;
+    t = clock();
+    h1 = zPH3DRaycast( &ph, &ray, &d1, &n1 );
+    t1 += clock() - t;
+    t = clock();
+    h2 = zPH3DBVHRaycast( &bvh, &ray, &d2, &n2 );
+    t2 += clock() - t;
+    if( h1 != h2 ) miss++;
+    else if( h1 )
+      err = zMax( err, fabs( d1 - d2 ) + zVec3DDist( &n1, &n2 ) );
+  }
+  printf( "brute force: %g sec., BVH: %g sec., mismatch: %d, max error: %g\n", (double)t1 / CLOCKS_PER_SEC, (double)t2 / CLOCKS_PER_SEC, miss, err );
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &ph );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,36 @@
+#include <zeo/zeo.h>
+#include <time.h>
+
+#define N 1000
+
+int main(int argc, char *argv[])
+{
+  zSphere3D sphere;
+  zPH3D ph;
+  zPH3DBVH bvh;
+  zVec3D p, cp1, cp2;
+  double d1, d2, err = 0;
+  clock_t t1 = 0, t2 = 0, t;
+  register int i;
+
+  zRandInit();
+  zSphere3DCreate( &sphere, ZVEC3DZERO, 1.0, argc > 1 ? atoi( argv[1] ) : 128 );
+  if( !zSphere3DToPH( &sphere, &ph ) ) return EXIT_FAILURE;
+  t = clock();
+  if( !zPH3DBVHBuild( &bvh, &ph ) ) return EXIT_FAILURE;
+  printf( "%d faces, %d nodes, built in %g sec.\n", zPH3DFaceNum(&ph), bvh.nodenum, (double)( clock() - t ) / CLOCKS_PER_SEC );
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &p, zRandF(-2,2), zRandF(-2,2), zRandF(-2,2) );
+    t = clock();
+    d1 = zPH3DClosest( &ph, &p, &cp1 );
+    t1 += clock() - t;
+    t = clock();
+    d2 = zPH3DBVHClosest( &bvh, &p, &cp2 );
+    t2 += clock() - t;
+    err = zMax( err, fabs( d1 - d2 ) + zVec3DDist( &cp1, &cp2 ) );
+  }
+  printf( "brute force: %g sec., BVH: %g sec., max error: %g\n", (double)t1 / CLOCKS_PER_SEC, (double)t2 / CLOCKS_PER_SEC, err );
+  zPH3DBVHDestroy( &bvh );
+  zPH3DDestroy( &ph );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+#include <zeo/zeo.h>
+
+#define N 4
+
+void check(zPH3D *ph, char *name)
+{
+  zPH3DHE he;
+  int nb[16], *loop, n;
+  register int i;
+
+  printf( "[%s] %d vertices, %d faces\n", name, zPH3DVertNum(ph), zPH3DFaceNum(ph) );
+  if( !zPH3DHEBuild( &he, ph ) ) return;
+  printf( " manifold: %s, closed: %s\n",
+    zBoolStr( zPH3DHEIsManifold( &he ) ), zBoolStr( zPH3DHEIsClosed( &he ) ) );
+  n = zPH3DHEVertNeighbor( &he, 0, nb, 16 );
+  printf( " one-ring of vertex 0:" );
+  for( i=0; i<n; i++ ) printf( " %d", nb[i] );
+  printf( "\n faces neighboring to face 0: %d %d %d\n",
+    zPH3DHEFaceNeighbor( &he, 0, 0 ), zPH3DHEFaceNeighbor( &he, 0, 1 ), zPH3DHEFaceNeighbor( &he, 0, 2 ) );
+  loop = zAlloc( int, zPH3DHENum(&he) );
+  printf( " %d boundary loops\n", zPH3DHEBoundaryLoop( &he, loop ) );
+  zFree( loop );
+  zPH3DHEDestroy( &he );
+}
+
+int main(int argc, char *argv[])
+{
+  zPH3D ph;
+  zVec3D loop[N], center, axis;
+  register int i, j, k;
+
+  /* closed torus */
+  for( i=0; i<N; i++ )
+    zVec3DCreate( &loop[i], 2+cos(zPIx2*i/N), 0, sin(zPIx2*i/N) );
+  zVec3DCreate( &center, 0, 0, 0 );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  zPH3DTorus( &ph, loop, N, 8, &center, &axis );
+  check( &ph, "torus" );
+  zPH3DDestroy( &ph );
+
+  /* open grid */
+  zPH3DAlloc( &ph, (N+1)*(N+1), 2*N*N );
+  for( i=0; i<=N; i++ )
+    for( j=0; j<=N; j++ )
+      zVec3DCreate( zPH3DVert(&ph,i*(N+1)+j), i, j, 0 );
+  for( k=0, i=0; i<N; i++ )
+    for( j=0; j<N; j++ ){
+      zTri3DCreate( zPH3DFace(&ph,k++), zPH3DVert(&ph,i*(N+1)+j), zPH3DVert(&ph,(i+1)*(N+1)+j), zPH3DVert(&ph,(i+1)*(N+1)+j+1) );
+      zTri3DCreate( zPH3DFace(&ph,k++), zPH3DVert(&ph,i*(N+1)+j), zPH3DVert(&ph,(i+1)*(N+1)+j+1), zPH3DVert(&ph,i*(N+1)+j+1) );
+    }
+  check( &ph, "grid" );
+  zPH3DDestroy( &ph );
+
+  /* three faces sharing an edge */
+  zPH3DAlloc( &ph, 5, 3 );
+  zVec3DCreate( zPH3DVert(&ph,0), 0, 0, 0 );
+  zVec3DCreate( zPH3DVert(&ph,1), 0, 0, 1 );
+  zVec3DCreate( zPH3DVert(&ph,2), 1, 0, 0 );
+  zVec3DCreate( zPH3DVert(&ph,3), 0, 1, 0 );
+  zVec3DCreate( zPH3DVert(&ph,4), -1, -1, 0 );
+  for( i=0; i<3; i++ )
+    zTri3DCreate( zPH3DFace(&ph,i), zPH3DVert(&ph,0), zPH3DVert(&ph,1), zPH3DVert(&ph,i+2) );
+  check( &ph, "fin" );
+  zPH3DDestroy( &ph );
+
+  /* square with a degenerate face on an edge */
+  zPH3DAlloc( &ph, 4, 3 );
+  zVec3DCreate( zPH3DVert(&ph,0), 0, 0, 0 );
+  zVec3DCreate( zPH3DVert(&ph,1), 1, 0, 0 );
+  zVec3DCreate( zPH3DVert(&ph,2), 1, 1, 0 );
+  zVec3DCreate( zPH3DVert(&ph,3), 0, 1, 0 );
+  zTri3DCreate( zPH3DFace(&ph,0), zPH3DVert(&ph,0), zPH3DVert(&ph,1), zPH3DVert(&ph,2) );
+  zTri3DCreate( zPH3DFace(&ph,1), zPH3DVert(&ph,0), zPH3DVert(&ph,2), zPH3DVert(&ph,3) );
+  zTri3DCreate( zPH3DFace(&ph,2), zPH3DVert(&ph,0), zPH3DVert(&ph,0), zPH3DVert(&ph,1) );
+  check( &ph, "degenerate" );
+  zPH3DDestroy( &ph );
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <zeo/zeo.h>
+
+#define N 200
+
+int main(int argc, char *argv[])
+{
+  zPH3D ph, ph2;
+  zPH3DIdx iph;
+  zVec3D loop[N], center, axis, p, cp1, cp2, c1, c2;
+  double d1, d2;
+  clock_t c;
+  register int i;
+
+  zRandInit();
+  /* a torus with 2*N*N faces */
+  for( i=0; i<N; i++ )
+    zVec3DCreate( &loop[i], 2+cos(zPIx2*i/N), 0, sin(zPIx2*i/N) );
+  zVec3DCreate( &center, 0.1, -0.2, 0.3 );
+  zVec3DCreate( &axis, 0, 0, 1 );
+  zPH3DTorus( &ph, loop, N, N, &center, &axis );
+  zPH3DToIdx( &ph, &iph, false );
+  printf( "faces: %d\n", zPH3DFaceNum(&ph) );
+  printf( "memory for faces: %d bytes (zPH3D), %d bytes (zPH3DIdx)\n",
+    (int)sizeof(zTri3D)*zPH3DFaceNum(&ph), (int)sizeof(int32_t)*3*zPH3DIdxFaceNum(&iph) );
+
+  c = clock();
+  d1 = zPH3DVolume( &ph );
+  zPH3DBarycenter( &ph, &c1 );
+  printf( "zPH3D   : volume = %.10g, %g msec\n", d1, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  c = clock();
+  d2 = zPH3DIdxVolume( &iph );
+  zPH3DIdxBarycenter( &iph, &c2 );
+  printf( "zPH3DIdx: volume = %.10g, %g msec\n", d2, (double)( clock() - c ) / CLOCKS_PER_SEC * 1000 );
+  printf( "barycenter: " ); zVec3DPrint( &c1 );
+  printf( "barycenter: " ); zVec3DPrint( &c2 );
+
+  zVec3DCreate( &p, zRandF(-4,4), zRandF(-4,4), zRandF(-4,4) );
+  d1 = zPH3DClosest( &ph, &p, &cp1 );
+  d2 = zPH3DIdxClosest( &iph, &p, &cp2 );
+  printf( "closest point: " ); zVec3DPrint( &cp1 );
+  printf( "closest point: " ); zVec3DPrint( &cp2 );
+  printf( "distance = %g, %g\n", d1, d2 );
+
+  zPH3DIdxToPH3D( &iph, &ph2 );
+  printf( "restored volume = %.10g\n", zPH3DVolume( &ph2 ) );
+  zPH3DDestroy( &ph );
+  zPH3DDestroy( &ph2 );
+  zPH3DIdxDestroy( &iph );
+  return 0;
+}
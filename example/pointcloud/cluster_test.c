@@ -0,0 +1,39 @@
+#include <zeo/zeo.h>
+
+#define NB 3
+#define N  1000
+
+int main(int argc, char *argv[])
+{
+  zVec3D p[NB*N], c[NB];
+  int label[NB*N];
+  zVec3DAddrList *list;
+  zAABox3D bb;
+  int nc;
+  register int i, j;
+
+  zRandInit();
+  /* blobs */
+  for( j=0; j<NB; j++ ){
+    zVec3DCreate( &c[j], 2*(j-1), j%2, 0 );
+    for( i=0; i<N; i++ ){
+      zVec3DCreatePolar( &p[j*N+i], zRandF(0,0.5), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+      zVec3DAddDRC( &p[j*N+i], &c[j] );
+    }
+  }
+  /* isolated points */
+  zVec3DCreate( &p[0], 10, 0, 0 );
+  zVec3DCreate( &p[N], -10, 0, 0 );
+
+  nc = zVec3DCluster( p, NB*N, NULL, 0.2, 10, label );
+  printf( "%d clusters (labels of isolated points: %d, %d)\n", nc, label[0], label[N] );
+  if( !( list = zVec3DClusterAddrList( p, NB*N, label, nc ) ) ) return EXIT_FAILURE;
+  for( i=0; i<nc; i++ ){
+    zAABBPL( &bb, &list[i], NULL );
+    printf( "cluster %d: %d points\n", i, zListSize(&list[i]) );
+    printf( "min: " ); zVec3DPrint( &bb.min );
+    printf( "max: " ); zVec3DPrint( &bb.max );
+  }
+  zVec3DClusterAddrListDestroy( list, nc );
+  return EXIT_SUCCESS;
+}
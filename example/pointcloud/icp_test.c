@@ -0,0 +1,38 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+
+int main(int argc, char *argv[])
+{
+  zVec3D dest[N], src[N], norm[N];
+  zFrame3D f, fans, finv;
+  zICPParam param;
+  zICPReport report;
+  zVec6D err;
+  int i;
+
+  zRandInit();
+  /* points on an ellipsoid with radii 1, 2 and 3 */
+  for( i=0; i<N; i++ ){
+    zVec3DCreatePolar( &dest[i], 1.0, zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+    zVec3DCreate( &norm[i], dest[i].c.x, dest[i].c.y/2, dest[i].c.z/3 );
+    zVec3DNormalizeDRC( &norm[i] );
+    dest[i].c.y *= 2;
+    dest[i].c.z *= 3;
+  }
+  /* deformed scan */
+  zFrame3DFromZYX( &fans, zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-0.1,0.1), zRandF(-0.2,0.2), zRandF(-0.2,0.2), zRandF(-0.2,0.2) );
+  zFrame3DInv( &fans, &finv );
+  for( i=0; i<N; i++ )
+    zXform3D( &finv, &dest[i], &src[i] );
+
+  zICPParamInit( &param );
+  param.metric = argc > 1 ? ZEO_ICP_POINT_TO_PLANE : ZEO_ICP_POINT_TO_POINT;
+  param.trim = 0.1;
+  zFrame3DIdent( &f );
+  if( !zICPArray( src, N, dest, N, norm, &param, &f, &report ) ) return EXIT_FAILURE;
+  printf( "iter=%d, num=%d, RMSE=%g, converged=%s\n", report.iter, report.num, report.rmse, report.converged ? "yes" : "no" );
+  zFrame3DError( &f, &fans, &err );
+  printf( "error: " ); zVec6DPrint( &err );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+#include <zeo/zeo.h>
+
+#define NP 2000
+#define NS 1000
+#define NC 1000
+#define NO 200
+#define N  ( NP + NS + NC + NO )
+
+int main(int argc, char *argv[])
+{
+  zVec3D p[N];
+  zRANSACPrimList list;
+  zRANSACPrimListCell *cp;
+  zRANSACParam param;
+  double theta;
+  int i;
+
+  zRandInit();
+  /* floor */
+  for( i=0; i<NP; i++ )
+    zVec3DCreate( &p[i], zRandF(-2,2), zRandF(-2,2), zRandF(-0.002,0.002) );
+  /* ball */
+  for( ; i<NP+NS; i++ ){
+    zVec3DCreatePolar( &p[i], 0.3, zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+    p[i].c.x += 1.0; p[i].c.z += 0.5;
+  }
+  /* pole */
+  for( ; i<NP+NS+NC; i++ ){
+    theta = zRandF(-zPI,zPI);
+    zVec3DCreate( &p[i], 0.2*cos(theta)-1.0, 0.2*sin(theta), zRandF(0.1,1.5) );
+  }
+  /* outliers */
+  for( ; i<N; i++ )
+    zVec3DCreate( &p[i], zRandF(-2,2), zRandF(-2,2), zRandF(0,2) );
+
+  zRANSACParamInit( &param );
+  param.radius = 0.1;
+  zRANSACSegment( &list, p, N, NULL, &param );
+  zListForEach( &list, cp ){
+    switch( cp->data.type ){
+    case ZEO_RANSAC_PLANE:
+      printf( "plane (%d inliers)\n", cp->data.num );
+      zPlane3DPrint( &cp->data.plane );
+      break;
+    case ZEO_RANSAC_SPHERE:
+      printf( "sphere (%d inliers)\n", cp->data.num );
+      printf( "center: " ); zVec3DPrint( zSphere3DCenter(&cp->data.sphere) );
+      printf( "radius: %g\n", zSphere3DRadius(&cp->data.sphere) );
+      break;
+    case ZEO_RANSAC_CYL:
+      printf( "cylinder (%d inliers)\n", cp->data.num );
+      printf( "center: " ); zVec3DPrint( zCyl3DCenter(&cp->data.cyl,0) );
+      printf( "center: " ); zVec3DPrint( zCyl3DCenter(&cp->data.cyl,1) );
+      printf( "radius: %g\n", zCyl3DRadius(&cp->data.cyl) );
+      break;
+    default: ;
+    }
+  }
+  zRANSACPrimListDestroy( &list );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+#include <zeo/zeo.h>
+
+#define NS 7
+#define N  10000
+#define TOL 1.0e-6
+
+/* check if a ray enters a shape at the distance t. */
+bool check_hit(zShape3D *shape, zRay3D *ray, double t)
+{
+  zVec3D p;
+
+  zRay3DPoint( ray, t-TOL, &p );
+  if( zShape3DPointIsInside( shape, &p, false ) ) return false;
+  zRay3DPoint( ray, t+TOL, &p );
+  return zShape3DPointIsInside( shape, &p, true );
+}
+
+/* check if a ray does not pass through a shape (sampled). */
+bool check_miss(zShape3D *shape, zRay3D *ray)
+{
+  zVec3D p;
+  double t;
+
+  for( t=0; t<10; t+=0.001 )
+    if( zShape3DPointIsInside( shape, zRay3DPoint( ray, t, &p ), false ) ) return false;
+  return true;
+}
+
+void create_ray(zRay3D *ray)
+{
+  zVec3D org, dir;
+
+  zVec3DCreatePolar( &org, 3, zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+  zVec3DCreate( &dir, zRandF(-0.5,0.5), zRandF(-0.5,0.5), zRandF(-0.5,0.5) );
+  zVec3DSubDRC( &dir, &org );
+  zRay3DCreate( ray, &org, &dir );
+}
+
+void create_shapes(zMShape3D *ms)
+{
+  zVec3D c1, c2, ax, ay, az;
+
+  zMShape3DInit( ms );
+  zArrayAlloc( &ms->shape, zShape3D, NS );
+  zVec3DCreate( &c1, 0.1, 0.2,-0.1 );
+  zVec3DCreate( &ax, 1, 1, 0 ); zVec3DNormalizeDRC( &ax );
+  zVec3DCreate( &ay,-1, 1, 0 ); zVec3DNormalizeDRC( &ay );
+  zVec3DCreate( &az, 0, 0, 1 );
+  zShape3DBoxCreate( zMShape3DShape(ms,0), &c1, &ax, &ay, &az, 0.6, 0.4, 0.3 );
+  zVec3DCreate( &c1, 0.8, 0.0, 0.2 );
+  zShape3DSphereCreate( zMShape3DShape(ms,1), &c1, 0.3, 0 );
+  zVec3DCreate( &c1,-0.7, 0.5, 0.0 );
+  zShape3DEllipsCreate( zMShape3DShape(ms,2), &c1, &ax, &ay, &az, 0.4, 0.2, 0.3, 0 );
+  zVec3DCreate( &c1,-0.5,-0.6,-0.4 );
+  zVec3DCreate( &c2,-0.2,-0.5, 0.4 );
+  zShape3DCylCreate( zMShape3DShape(ms,3), &c1, &c2, 0.2, 0 );
+  zVec3DCreate( &c1, 0.5,-0.8,-0.3 );
+  zVec3DCreate( &c2, 0.7,-0.6, 0.2 );
+  zShape3DECylCreate( zMShape3DShape(ms,4), &c1, &c2, 0.3, 0.1, &az, 0 );
+  zVec3DCreate( &c1, 0.0, 0.8,-0.5 );
+  zVec3DCreate( &c2, 0.3, 0.9, 0.3 );
+  zShape3DConeCreate( zMShape3DShape(ms,5), &c1, &c2, 0.3, 0 );
+  zVec3DCreate( &c1, 0.0, 0.0, 0.8 );
+  zShape3DBoxCreate( zMShape3DShape(ms,6), &c1, &ax, &ay, &az, 0.3, 0.3, 0.2 );
+  zShape3DToPH( zMShape3DShape(ms,6) );
+}
+
+int main(int argc, char *argv[])
+{
+  zMShape3D ms;
+  zMShape3DRaycaster rc;
+  zRay3D ray[N];
+  double t[N], tb;
+  zVec3D norm;
+  int id[N], i, j, jb, err_shape = 0, err_scene = 0;
+
+  zRandInit();
+  create_shapes( &ms );
+  /* each shape */
+  for( i=0; i<N; i++ ){
+    create_ray( &ray[i] );
+    for( j=0; j<NS; j++ ){
+      t[i] = HUGE_VAL;
+      if( zShape3DRaycast( zMShape3DShape(&ms,j), &ray[i], &t[i], &norm ) ?
+          !check_hit( zMShape3DShape(&ms,j), &ray[i], t[i] ) :
+          !check_miss( zMShape3DShape(&ms,j), &ray[i] ) ){
+        eprintf( "%s: wrong intersection\n", zMShape3DShape(&ms,j)->com->typestr );
+        err_shape++;
+      }
+    }
+  }
+  /* scene: brute force vs. ray caster */
+  zMShape3DRaycasterBuild( &rc, &ms );
+  for( i=0; i<N; i++ ) t[i] = HUGE_VAL;
+  zMShape3DRaycasterPacket( &rc, ray, N, t, NULL, id );
+  for( i=0; i<N; i++ ){
+    for( jb=-1, tb=HUGE_VAL, j=0; j<NS; j++ )
+      if( zShape3DRaycast( zMShape3DShape(&ms,j), &ray[i], &tb, NULL ) ) jb = j;
+    if( id[i] != jb || ( jb >= 0 && !zIsTol( t[i]-tb, TOL ) ) ) err_scene++;
+    tb = HUGE_VAL;
+    if( zMShape3DRaycasterCast( &rc, &ray[i], &tb, NULL ) != jb ) err_scene++;
+  }
+  printf( "errors: %d (shapes), %d (scene)\n", err_shape, err_scene );
+  zMShape3DRaycasterDestroy( &rc );
+  zMShape3DDestroy( &ms );
+  return 0;
+}
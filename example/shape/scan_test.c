@@ -0,0 +1,54 @@
+#include <zeo/zeo.h>
+#include <time.h>
+
+#define W 160
+#define H 120
+#define FRAMES 100
+
+int main(int argc, char *argv[])
+{
+  zMShape3D ms;
+  zMShape3DRaycaster rc;
+  zRangeSensor3D camera, lidar;
+  zFrame3D pose;
+  zVec3D c, p[W*H];
+  double depth[W*H];
+  int i, n = 0;
+  clock_t t;
+
+  /* floor and a few objects */
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, 4 );
+  zVec3DCreate( &c, 0, 0,-0.05 );
+  zShape3DBoxCreateAlign( zMShape3DShape(&ms,0), &c, 10, 10, 0.1 );
+  zVec3DCreate( &c, 2.0, 0.5, 0.5 );
+  zShape3DSphereCreate( zMShape3DShape(&ms,1), &c, 0.5, 0 );
+  zVec3DCreate( &c, 3.0,-1.0, 0.5 );
+  zShape3DBoxCreateAlign( zMShape3DShape(&ms,2), &c, 1, 1, 1 );
+  zVec3DCreate( &c, 1.5,-0.2, 0.0 );
+  zShape3DSphereCreate( zMShape3DShape(&ms,3), &c, 0.2, 16 );
+  zShape3DToPH( zMShape3DShape(&ms,3) );
+  zMShape3DRaycasterBuild( &rc, &ms );
+
+  /* camera at 1m height looking along x-axis */
+  zRangeSensor3DCreatePinhole( &camera, W, H, 100, 100, 0.5*(W-1), 0.5*(H-1), 0.1, 10 );
+  zFrame3DFromZYX( &pose, 0, 0, 1.0, -0.5*zPI, 0, -0.5*zPI );
+  t = clock();
+  for( i=0; i<FRAMES; i++ )
+    n = zRangeSensor3DScan( &camera, &rc, &pose, depth, p );
+  printf( "camera: %d points, %g frames/sec.\n", n, FRAMES / ( (double)( clock() - t ) / CLOCKS_PER_SEC ) );
+  zVec3DArrayWritePCDFile( p, n, "camera.pcd" );
+
+  /* 16-channel lidar at 1m height */
+  zRangeSensor3DCreateLidar( &lidar, 360, 16, -zPI, zPI, zDeg2Rad(-15), zDeg2Rad(15), 0.1, 10 );
+  zFrame3DFromZYX( &pose, 0, 0, 1.0, 0, 0, 0 );
+  n = zRangeSensor3DScan( &lidar, &rc, &pose, NULL, p );
+  printf( "lidar: %d points\n", n );
+  zVec3DArrayWritePCDFile( p, n, "lidar.pcd" );
+
+  zRangeSensor3DDestroy( &camera );
+  zRangeSensor3DDestroy( &lidar );
+  zMShape3DRaycasterDestroy( &rc );
+  zMShape3DDestroy( &ms );
+  return 0;
+}
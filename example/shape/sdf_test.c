@@ -0,0 +1,67 @@
+#include <zeo/zeo.h>
+#include <time.h>
+
+#define N 100000
+
+int main(int argc, char *argv[])
+{
+  zShape3D sphere;
+  zMShape3D ms;
+  zSDF3D sdf, sdf_load;
+  zVec3D c, p, g;
+  double d, e, err_out = 0, err_in = 0, err_grad = 0;
+  clock_t t;
+  int i;
+
+  zRandInit();
+  zVec3DCreate( &c, 0.1, 0.2, 0.3 );
+  zShape3DSphereCreate( &sphere, &c, 0.5, 0 );
+  t = clock();
+  if( !zSDF3DFromShape( &sdf, &sphere, 0.02, 0.1 ) ) return EXIT_FAILURE;
+  printf( "%d x %d x %d grid built in %g sec.\n", sdf.num[0], sdf.num[1], sdf.num[2], (double)( clock() - t ) / CLOCKS_PER_SEC );
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &p, zRandF(-0.5,0.7), zRandF(-0.4,0.8), zRandF(-0.3,0.9) );
+    d = zSDF3DDist( &sdf, &p, &g );
+    zVec3DSubDRC( &p, &c );
+    e = zVec3DNorm( &p ) - 0.5;
+    if( e > 0 ) err_out = zMax( err_out, fabs( d - e ) );
+    else        err_in  = zMax( err_in,  fabs( d - e ) );
+    if( e > 0.05 ){
+      zVec3DNormalizeDRC( &p );
+      err_grad = zMax( err_grad, zVec3DDist( &g, &p ) );
+    }
+  }
+  printf( "max error: %g (outside), %g (inside), %g (gradient)\n", err_out, err_in, err_grad );
+
+  zSDF3DWriteFile( &sdf, "sphere.sdf" );
+  if( !zSDF3DReadFile( &sdf_load, "sphere.sdf" ) ) return EXIT_FAILURE;
+  for( i=0; i<N; i++ ){
+    zVec3DCreate( &p, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+    if( zSDF3DDist( &sdf, &p, NULL ) != zSDF3DDist( &sdf_load, &p, NULL ) ){
+      eprintf( "save/load mismatch\n" );
+      break;
+    }
+  }
+  zSDF3DDestroy( &sdf_load );
+  zSDF3DDestroy( &sdf );
+
+  /* multiple shapes */
+  zMShape3DInit( &ms );
+  zArrayAlloc( &ms.shape, zShape3D, 2 );
+  zVec3DCreate( &c, 0.1, 0.2, 0.3 );
+  zShape3DSphereCreate( zMShape3DShape(&ms,0), &c, 0.5, 0 );
+  zVec3DCreate( &c, 0.6, 0.0, 0.0 );
+  zShape3DBoxCreateAlign( zMShape3DShape(&ms,1), &c, 0.4, 0.4, 0.4 );
+  zShape3DToPH( zMShape3DShape(&ms,1) );
+  if( !zSDF3DFromMShape( &sdf, &ms, 0.02, 0.1 ) ) return EXIT_FAILURE;
+  for( err_out=0, i=0; i<N; i++ ){
+    zVec3DCreate( &p, zRandF(-0.5,0.9), zRandF(-0.4,0.8), zRandF(-0.3,0.9) );
+    if( zMShape3DPointIsInside( &ms, &p, true ) ) continue;
+    err_out = zMax( err_out, fabs( zSDF3DDist( &sdf, &p, NULL ) - zMShape3DClosest( &ms, &p, &c ) ) );
+  }
+  printf( "max error of multiple shapes: %g (outside)\n", err_out );
+  zSDF3DDestroy( &sdf );
+  zMShape3DDestroy( &ms );
+  zShape3DDestroy( &sphere );
+  return EXIT_SUCCESS;
+}
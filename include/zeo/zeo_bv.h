@@ -7,12 +7,14 @@
 #ifndef __ZEO_BV_H__
 #define __ZEO_BV_H__
 
-#include <zeo/zeo_shape.h>
+#include <zeo/zeo_mshape.h>
 
 #include <zeo/zeo_bv_ch2.h>
 #include <zeo/zeo_bv_aabb.h>
 #include <zeo/zeo_bv_obb.h>
 #include <zeo/zeo_bv_bball.h>
+#include <zeo/zeo_bv_kdop.h>
 #include <zeo/zeo_bv_qhull.h>
+#include <zeo/zeo_bv_shape.h>
 
 #endif /* __ZEO_BV_H__ */
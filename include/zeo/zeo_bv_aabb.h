@@ -34,6 +34,9 @@ __EXPORT zAABox3D *zAABox3DMerge(zAABox3D *box, zAABox3D *b1, zAABox3D *b2);
 /*! \brief check if a point is inside of an axis-aligned box. */
 __EXPORT bool zAABox3DPointIsInside(zAABox3D *box, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and an axis-aligned box (see zShape3DRaycast()). */
+__EXPORT bool zAABox3DRaycast(zAABox3D *box, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief compute volume of an axis-aligned box. */
 __EXPORT double zAABox3DVolume(zAABox3D *box);
 
@@ -46,6 +49,21 @@ __EXPORT zBox3D *zAABox3DToBox3D(zAABox3D *aab, zBox3D *box);
 /*! \brief compute an axis-aligned box of a 3D box. */
 __EXPORT zAABox3D *zBox3DToAABox3D(zBox3D *box, zAABox3D *aabox);
 
+/*! \brief transform coordinates of an axis-aligned box.
+ *
+ * zAABox3DXform() computes the axis-aligned box that bounds an
+ * axis-aligned box \a src transformed by a frame \a f, and puts it
+ * into \a dst. Each half-length of edges of \a dst is computed from
+ * those of \a src weighted by the absolute values of components of
+ * the attitude matrix of \a f, so that the computation time is
+ * constant. The result bounds the transformed \a src tightly, while
+ * it is generally larger than the bounding box of the original
+ * points bounded by \a src.
+ * \return
+ * zAABox3DXform() returns a pointer \a dst.
+ */
+__EXPORT zAABox3D *zAABox3DXform(zAABox3D *src, zFrame3D *f, zAABox3D *dst);
+
 /* ********************************************************** */
 /* AABB - axis-aligned bounding box
  * ********************************************************** */
@@ -99,6 +117,54 @@ __EXPORT zAABox3D *zAABBPL(zAABox3D *bb, zVec3DList *pl, zVec3DListCell **vc);
 __EXPORT zAABox3D *zAABBXform(zAABox3D *bb, zVec3D p[], int num, zFrame3D *f);
 __EXPORT zAABox3D *zAABBXformPL(zAABox3D *bb, zVec3DList *pl, zFrame3D *f);
 
+/* ********************************************************** */
+/*! \brief cache of axis-aligned bounding box in a local frame.
+ *
+ * zAABBCache is a cache of the axis-aligned bounding box \a box
+ * of a set of points in a local frame, e.g. vertices of a shape
+ * attached to a moving body. It optionally has the convex hull
+ * \a hull of the points.
+ *//* ******************************************************* */
+typedef struct{
+  zAABox3D box; /*!< axis-aligned bounding box in the local frame */
+  zPH3D hull;   /*!< convex hull of points in the local frame */
+} zAABBCache;
+
+/*! \brief create, destroy and transform a cache of axis-aligned bounding box.
+ *
+ * zAABBCacheCreate() creates a cache \a cache of the axis-aligned
+ * bounding box of a set of points \a p in a local frame. \a num is
+ * the number of the points. If the true value is given for \a tight,
+ * the convex hull of the points is also cached.
+ *
+ * zAABBCacheCreatePL() also creates a cache \a cache for a set of
+ * points given by a list \a pl.
+ *
+ * zAABBCacheDestroy() destroys \a cache.
+ *
+ * zAABBCacheXform() computes the axis-aligned bounding box of the
+ * cached points transformed by a frame \a f, and puts it into \a bb.
+ * If the convex hull is cached, the result is the exact bounding
+ * box computed from vertices of the hull, which are usually much
+ * fewer than the original points. Otherwise, it is computed from
+ * the cached box by zAABox3DXform() in a constant time, which bounds
+ * all the points but is looser.
+ * \return
+ * zAABBCacheCreate() and zAABBCacheCreatePL() return a pointer
+ * \a cache, or the null pointer if no points are given. If it fails
+ * to compute the convex hull, the cache is created without it.
+ *
+ * zAABBCacheDestroy() returns no value.
+ *
+ * zAABBCacheXform() returns a pointer \a bb.
+ * \sa
+ * zAABox3DXform, zAABBXform, zCH3D
+ */
+__EXPORT zAABBCache *zAABBCacheCreate(zAABBCache *cache, zVec3D p[], int num, bool tight);
+__EXPORT zAABBCache *zAABBCacheCreatePL(zAABBCache *cache, zVec3DList *pl, bool tight);
+__EXPORT void zAABBCacheDestroy(zAABBCache *cache);
+__EXPORT zAABox3D *zAABBCacheXform(zAABBCache *cache, zFrame3D *f, zAABox3D *bb);
+
 __END_DECLS
 
 #endif /* __ZEO_BV_AABB_H__ */
@@ -27,8 +27,18 @@ __BEGIN_DECLS
  * The pointers to points on the sphere will be stored into the
  * array pointed by \a vp, unless \a vp is the null pointer.
  *
- * The algorithm is according to E. Welzl(1991).
+ * The algorithm is according to E. Welzl(1991), where the recursion
+ * is unrolled on an array of pointers to the points with the
+ * move-to-front heuristics by B. Gaertner(1999), and the points are
+ * shuffled by a pseudo-random sequence with a fixed seed in advance.
+ * Hence, the recursion is not deeper than four, and the expected
+ * computation time is linear to the number of points. The result
+ * is reproducible, and the random number generator of ZEDA is not
+ * affected.
  * \notes
+ * The array of pointers, which is reordered during the computation,
+ * is internally allocated for each call, so that the given set of
+ * points is not modified.
  * For the robustness against numerical error, the radius of
  * \a bb has a margine of zTOL to the actual distance from its
  * center to the furthest point.
@@ -39,6 +49,31 @@ __BEGIN_DECLS
 __EXPORT int zBBall(zSphere3D *bb, zVec3D p[], int num, zVec3D **vp);
 __EXPORT int zBBallPL(zSphere3D *bb, zVec3DList *p, zVec3D **vp);
 
+/*! \brief approximate bounding ball of points.
+ *
+ * zBBallFast() computes an approximate bounding ball of a set of
+ * points \a p in one pass according to J. Ritter(1990). \a num is
+ * the number of points. The result is put into \a bb.
+ * An initial ball is spanned by the most distant pair of the
+ * extreme points along the x-, y- and z-axes, and then grown to
+ * include each point outside of it.
+ *
+ * zBBallFastPL() also computes an approximate bounding ball of a
+ * set of points given by a vector list \a pl.
+ *
+ * The resulting ball bounds all the points, while it is typically
+ * several percent larger than the smallest one by zBBall(). They
+ * are suitable for real-time applications in which the bounding
+ * ball has to be updated frequently.
+ * \return
+ * zBBallFast() and zBBallFastPL() return a pointer \a bb, or the
+ * null pointer if no points are given.
+ * \sa
+ * zBBall, zBBallPL
+ */
+__EXPORT zSphere3D *zBBallFast(zSphere3D *bb, zVec3D p[], int num);
+__EXPORT zSphere3D *zBBallFastPL(zSphere3D *bb, zVec3DList *pl);
+
 __END_DECLS
 
 #endif /* __ZEO_BV_BBALL_H__ */
@@ -0,0 +1,128 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_bv_kdop - bounding volume: discrete oriented polytope.
+ */
+
+#ifndef __ZEO_BV_KDOP_H__
+#define __ZEO_BV_KDOP_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief discrete oriented polytope class.
+ *
+ * zKDOP3D is a discrete oriented polytope (k-DOP), which is bounded
+ * by k/2 pairs of parallel planes with fixed normal vectors. \a k is
+ * either 14, 18 or 26, where the normal vectors are chosen as
+ *  14-DOP: (1,0,0), (0,1,0), (0,0,1),
+ *          (1,1,1), (1,1,-1), (1,-1,1), (1,-1,-1),
+ *  18-DOP: (1,0,0), (0,1,0), (0,0,1),
+ *          (1,1,0), (1,-1,0), (1,0,1), (1,0,-1), (0,1,1), (0,1,-1),
+ *  26-DOP: all of the above.
+ * \a min[i] and \a max[i] are the minimum and maximum values of
+ * inner products of points in the polytope with the i-th normal
+ * vector. Note that the normal vectors are not normalized.
+ *//* ******************************************************* */
+#define ZEO_KDOP_MAX_AXIS 13
+
+typedef struct{
+  int k;                         /*!< number of faces */
+  double min[ZEO_KDOP_MAX_AXIS]; /*!< minimum projections */
+  double max[ZEO_KDOP_MAX_AXIS]; /*!< maximum projections */
+} zKDOP3D;
+
+#define zKDOP3DAxisNum(kdop) ( (kdop)->k / 2 )
+
+/*! \brief initialize a k-DOP.
+ *
+ * zKDOP3DInit() initializes a k-DOP \a kdop. \a k is the number of
+ * faces, which has to be either 14, 18 or 26.
+ * \return
+ * zKDOP3DInit() returns a pointer \a kdop, or the null pointer if
+ * an invalid \a k is given.
+ */
+__EXPORT zKDOP3D *zKDOP3DInit(zKDOP3D *kdop, int k);
+
+/*! \brief normal vector of a pair of faces of a k-DOP.
+ *
+ * zKDOP3DAxis() puts the i-th normal vector of faces of a k-DOP
+ * \a kdop into \a axis.
+ * \return
+ * zKDOP3DAxis() returns a pointer \a axis, or the null pointer if
+ * \a i is out of range.
+ */
+__EXPORT zVec3D *zKDOP3DAxis(zKDOP3D *kdop, int i, zVec3D *axis);
+
+/*! \brief copy and merge k-DOPs.
+ *
+ * zKDOP3DCopy() copies a k-DOP \a src to \a dst.
+ *
+ * zKDOP3DMerge() computes the k-DOP that bounds two k-DOPs \a src1
+ * and \a src2, and puts it into \a dst. \a src1 and \a src2 have to
+ * have the same number of faces.
+ * \return
+ * zKDOP3DCopy() returns a pointer \a dst.
+ *
+ * zKDOP3DMerge() returns a pointer \a dst, or the null pointer if
+ * \a src1 and \a src2 have different numbers of faces.
+ */
+__EXPORT zKDOP3D *zKDOP3DCopy(zKDOP3D *src, zKDOP3D *dst);
+__EXPORT zKDOP3D *zKDOP3DMerge(zKDOP3D *dst, zKDOP3D *src1, zKDOP3D *src2);
+
+/*! \brief check if a point is inside of a k-DOP. */
+__EXPORT bool zKDOP3DPointIsInside(zKDOP3D *kdop, zVec3D *p, bool rim);
+
+/*! \brief check if two k-DOPs overlap.
+ *
+ * zColChkKDOP3D() checks if two k-DOPs \a kdop1 and \a kdop2
+ * overlap. It only compares the minimum and maximum projections of
+ * them along k/2 axes, so that its computation cost is almost the
+ * same with that of zColChkAABox3D(). Like other bounding volumes,
+ * the test is conservative; it could report overlap of two
+ * polytopes which are separated along an axis other than normal
+ * vectors of their faces.
+ * \return
+ * zColChkKDOP3D() returns the true value if \a kdop1 and \a kdop2
+ * overlap, or the false value otherwise. If \a kdop1 and \a kdop2
+ * have different numbers of faces, the false value is returned.
+ */
+__EXPORT bool zColChkKDOP3D(zKDOP3D *kdop1, zKDOP3D *kdop2);
+
+/*! \brief convert a k-DOP to a polyhedron.
+ *
+ * zKDOP3DToPH3D() converts a k-DOP \a kdop to a polyhedron \a ph,
+ * which is mainly for visualization and debugging.
+ * \return
+ * zKDOP3DToPH3D() returns a pointer \a ph, or the null pointer if
+ * it fails to allocate memory or \a kdop is degenerated.
+ */
+__EXPORT zPH3D *zKDOP3DToPH3D(zKDOP3D *kdop, zPH3D *ph);
+
+/* ********************************************************** */
+/* k-DOP - bounding discrete oriented polytope
+ * ********************************************************** */
+
+/*! \brief bounding k-DOP of points.
+ *
+ * zKDOP() computes the bounding k-DOP of a set of points \a p.
+ * \a num is the number of points, and \a k is the number of faces.
+ * The result is put into \a kdop.
+ *
+ * zKDOPPL() also computes the bounding k-DOP of a set of points
+ * given by a list of pointers to points \a pl.
+ *
+ * zKDOPPH() computes the bounding k-DOP of a polyhedron \a ph.
+ * \return
+ * zKDOP(), zKDOPPL() and zKDOPPH() return a pointer \a kdop, or
+ * the null pointer if an invalid \a k or no point is given.
+ */
+__EXPORT zKDOP3D *zKDOP(zKDOP3D *kdop, int k, zVec3D p[], int num);
+__EXPORT zKDOP3D *zKDOPPL(zKDOP3D *kdop, int k, zVec3DList *pl);
+__EXPORT zKDOP3D *zKDOPPH(zKDOP3D *kdop, int k, zPH3D *ph);
+
+__END_DECLS
+
+#endif /* __ZEO_BV_KDOP_H__ */
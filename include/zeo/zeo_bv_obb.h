@@ -27,6 +27,34 @@ __BEGIN_DECLS
 __EXPORT zBox3D *zOBB(zBox3D *obb, zVec3D p[], int n);
 __EXPORT zBox3D *zOBBPL(zBox3D *obb, zVec3DList *pl);
 
+/*! \brief approximate oriented bounding box of points.
+ *
+ * zOBBFast() computes an approximate oriented bounding box of a set
+ * of points \a p in linear time without the convex hull. \a n is the
+ * number of points. The result is put into \a obb.
+ * The extreme points along 7 directions of a 14-DOP are found in a
+ * pass over \a p. Candidate axes are made from edges and normal
+ * vectors of a ditetrahedron spanned by the extreme points (DiTO-14
+ * by T. Larsson and L. Kallberg, 2011) and the principal axes of
+ * \a p (see zVec3DBaryPCA()), and those which minimize the surface
+ * area of the box bounding the extreme points are chosen.
+ * If \a iter is positive, the axes are refined \a iter times by
+ * rotating them about each axis with a halving angle, where each
+ * iteration needs another pass over \a p.
+ * The box is finally fitted to all points along the axes, so that
+ * it always bounds \a p even though it is not the tightest.
+ *
+ * zOBBFastPL() also computes an approximate oriented bounding box
+ * of a set of points given by a list \a pl.
+ * \return
+ * zOBBFast() and zOBBFastPL() return a pointer \a obb, or the null
+ * pointer if no points are given or they fail to allocate memory.
+ * \sa
+ * zOBB, zOBBPL
+ */
+__EXPORT zBox3D *zOBBFast(zBox3D *obb, zVec3D p[], int n, int iter);
+__EXPORT zBox3D *zOBBFastPL(zBox3D *obb, zVec3DList *pl, int iter);
+
 __END_DECLS
 
 #endif /* __ZEO_BV_OBB_H__ */
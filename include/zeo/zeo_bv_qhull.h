@@ -24,10 +24,21 @@ __BEGIN_DECLS
  * of points is given as a vector list \a pl.
  *
  * The algorithm is according to quickhull by C. Barber,
- * D. Dobkin and H. Huhdanpaa(1996).
+ * D. Dobkin and H. Huhdanpaa(1996). Points are referred by
+ * indices, and each facet has a list of outside points linked
+ * through an index array, so that no memory is allocated for
+ * each point. Facets are taken from a pool which grows by
+ * doubling and recycles facets removed from the hull. The
+ * furthest outside point of each facet is kept so that it is
+ * picked up without scanning the list.
+ * Points within a tolerance relative to the extent of the set
+ * of points from the hull are regarded as inside of the hull.
+ * Points strictly inside of the octahedron spanned by the extreme
+ * points along the axes are discarded before the hull is computed,
+ * since they cannot be vertices of the hull.
  * \notes
- * In the cource of computation, \a pl is partially destroyed
- * but not freed by zCH3DPL().
+ * zCH3DPL() copies the points in \a pl to an internal array,
+ * and \a pl is kept unchanged.
  * \return
  * zCH3DPL() and zCH3D() return a pointer \a ch if succeeding
  * to compute the convex hull. If failing to allocate working
@@ -37,6 +48,112 @@ __BEGIN_DECLS
 __EXPORT zPH3D *zCH3D(zPH3D *ch, zVec3D p[], int num);
 __EXPORT zPH3D *zCH3DPL(zPH3D *ch, zVec3DList *pl);
 
+/* ********************************************************** */
+/*! \brief workspace of quickhull.
+ *
+ * zQH is a workspace of quickhull algorithm, which is internally
+ * used by zCH3D() and its variations. Points are referred by indices
+ * of an array \a p. A facet zQHFacet refers its three vertices and
+ * three contiguous facets by indices, and keeps a list of outside
+ * points linked through \a next. Facets are allocated from a pool
+ * \a facet, and removed facets are recycled.
+ * Users do not have to access members of them directly.
+ *//* ******************************************************* */
+typedef struct{
+  int size; /*!< size of buffer */
+  int num;  /*!< number of indices */
+  int *buf; /*!< buffer */
+} zQHIndex;
+
+typedef struct{
+  int v[3];     /*!< vertices */
+  int c[3];     /*!< contiguous facets, where c[i] shares the edge from v[i] to v[(i+1)%3] */
+  zVec3D n;     /*!< normal vector */
+  double d;     /*!< offset of the facet plane */
+  int op;       /*!< head of the outside point set */
+  int far;      /*!< furthest outside point */
+  double d_max; /*!< furthest point distance */
+  int visit;    /*!< stamp of visit */
+} zQHFacet;
+
+typedef struct{
+  zVec3D *p;        /*!< points */
+  int num;          /*!< number of points */
+  int *next;        /*!< links of outside point sets */
+  int *vstamp;      /*!< stamps of horizon vertices */
+  int *vmap;        /*!< map from horizon vertices to new facets */
+  zQHFacet *facet;  /*!< pool of facets */
+  int fsize;        /*!< size of the pool */
+  int fnum;         /*!< number of facets used in the pool */
+  int ffree;        /*!< head of recycled facets */
+  int stamp;        /*!< current stamp */
+  double tol;       /*!< tolerance of distance */
+  zQHIndex pending; /*!< facets to be processed */
+  zQHIndex vs;      /*!< visible set */
+  zQHIndex horizon; /*!< horizon ridges (pairs of facet and edge) */
+  zQHIndex cone;    /*!< new facets */
+} zQH;
+
+/* ********************************************************** */
+/*! \brief incremental convex hull.
+ *
+ * zCH3DInc is a convex hull which grows as points are added. It
+ * owns copies of points on the hull and the facets of the hull in
+ * a workspace of quickhull \a qh. \a center is a point inside of
+ * the hull, \a radius is the radius of the largest ball at \a center
+ * inside of the hull, and \a last is the facet lastly visited.
+ *//* ******************************************************* */
+typedef struct{
+  zQH qh;        /*!< workspace of quickhull */
+  int size;      /*!< size of the array of points */
+  int dim;       /*!< dimension of the set of points */
+  zVec3D center; /*!< a point inside of the hull */
+  double radius; /*!< radius of the inscribed ball */
+  int last;      /*!< facet lastly visited */
+} zCH3DInc;
+
+/*! \brief incremental convex hull of points.
+ *
+ * zCH3DIncInit() initializes an incremental convex hull \a ch.
+ *
+ * zCH3DIncDestroy() destroys \a ch.
+ *
+ * zCH3DIncAdd() adds points \a p to \a ch. \a num is the number of
+ * points. For each point, the facet which the ray from \a center to
+ * the point passes is found by walking on the hull from the facet
+ * lastly visited. The point is skipped if it is inside of the ball
+ * inscribed in the hull or beneath the facet.
+ * Otherwise, the facets visible from the point are replaced with a
+ * cone of the point and the horizon ridges in the same way with
+ * quickhull. Hence, the computation time is proportional to the
+ * number of changed facets rather than the number of all points.
+ * Until four points that are not on a common plane are given, the
+ * points are just stored in \a ch. After that, points that are not
+ * vertices of the hull are discarded at the end of every call, so
+ * that \a ch does not grow with the number of points given.
+ *
+ * zCH3DInc2PH3D() converts \a ch to a polyhedron \a ph.
+ * \return
+ * zCH3DIncInit() returns a pointer \a ch.
+ *
+ * zCH3DIncDestroy() returns no value.
+ *
+ * zCH3DIncAdd() returns the number of points stored in \a ch after
+ * the call, namely, the number of vertices of the hull, or the number
+ * of all points given so far if the hull is not created yet. -1 is
+ * returned if it fails to allocate memory.
+ *
+ * zCH3DInc2PH3D() returns a pointer \a ph, or the null pointer if
+ * the points are degenerated onto a line or it fails to allocate
+ * memory.
+ * \sa
+ * zCH3D
+ */
+__EXPORT zCH3DInc *zCH3DIncInit(zCH3DInc *ch);
+__EXPORT void zCH3DIncDestroy(zCH3DInc *ch);
+__EXPORT int zCH3DIncAdd(zCH3DInc *ch, zVec3D p[], int num);
+__EXPORT zPH3D *zCH3DInc2PH3D(zCH3DInc *ch, zPH3D *ph);
+
 __END_DECLS
 
 #endif /* __ZEO_BV_QHULL_H__ */
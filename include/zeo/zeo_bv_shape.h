@@ -0,0 +1,84 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_bv_shape - bounding volume: cached bounding volumes of shapes.
+ */
+
+#ifndef __ZEO_BV_SHAPE_H__
+#define __ZEO_BV_SHAPE_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief cached bounding volumes of a 3D shape.
+ *
+ * zShape3DBV is a set of bounding volumes of a 3D shape, which are
+ * computed on demand and kept until the shape is modified.
+ * \a flag tells which of them are valid.
+ *//* ******************************************************* */
+#define ZEO_SHAPE_BV_CH    0x1
+#define ZEO_SHAPE_BV_AABB  0x2
+#define ZEO_SHAPE_BV_OBB   0x4
+#define ZEO_SHAPE_BV_BBALL 0x8
+
+typedef struct _zShape3DBV{
+  int flag;        /*!< flags of valid bounding volumes */
+  zPH3D ch;        /*!< convex hull */
+  zAABox3D aabb;   /*!< axis-aligned bounding box */
+  zBox3D obb;      /*!< oriented bounding box */
+  zSphere3D bball; /*!< bounding ball */
+} zShape3DBV;
+
+/*! \brief bounding volumes of a 3D shape.
+ *
+ * zShape3DCH(), zShape3DAABB(), zShape3DOBB() and zShape3DBBall()
+ * return the convex hull, the axis-aligned bounding box, the
+ * oriented bounding box and the bounding ball of a 3D shape
+ * \a shape, respectively.
+ * They are computed from vertices of the polyhedral approximation
+ * of \a shape (see zShape3DToPH()) when requested for the first
+ * time, and cached in \a shape. The convex hull is computed first,
+ * and the others are computed from its vertices, which are usually
+ * much fewer than those of \a shape.
+ * The cache is invalidated when \a shape is transformed or modified
+ * (see zShape3DBVInvalidate()).
+ * \return
+ * zShape3DCH(), zShape3DAABB(), zShape3DOBB() and zShape3DBBall()
+ * return pointers to the cached bounding volumes, which must not be
+ * modified or freed by the caller. The null pointer is returned if
+ * they fail to allocate memory.
+ * zShape3DCH() also returns the null pointer if the vertices of
+ * \a shape are degenerated, for which the others are computed from
+ * all the vertices.
+ */
+__EXPORT zPH3D *zShape3DCH(zShape3D *shape);
+__EXPORT zAABox3D *zShape3DAABB(zShape3D *shape);
+__EXPORT zBox3D *zShape3DOBB(zShape3D *shape);
+__EXPORT zSphere3D *zShape3DBBall(zShape3D *shape);
+
+/*! \brief bounding volumes of multiple 3D shapes.
+ *
+ * zMShape3DAABB() computes the axis-aligned bounding box of multiple
+ * 3D shapes \a ms, and puts it into \a bb. It merges the cached
+ * bounding boxes of shapes in \a ms.
+ *
+ * zMShape3DCH(), zMShape3DOBB() and zMShape3DBBall() compute the
+ * convex hull, the oriented bounding box and the bounding ball of
+ * \a ms from vertices of the cached convex hulls of shapes in \a ms,
+ * and put them into \a ch, \a obb and \a bb, respectively.
+ * \return
+ * zMShape3DAABB(), zMShape3DCH(), zMShape3DOBB() and zMShape3DBBall()
+ * return pointers \a bb, \a ch, \a obb and \a bb, respectively, or
+ * the null pointer if \a ms has no shape or they fail to allocate
+ * memory.
+ */
+__EXPORT zAABox3D *zMShape3DAABB(zMShape3D *ms, zAABox3D *bb);
+__EXPORT zPH3D *zMShape3DCH(zMShape3D *ms, zPH3D *ch);
+__EXPORT zBox3D *zMShape3DOBB(zMShape3D *ms, zBox3D *obb);
+__EXPORT zSphere3D *zMShape3DBBall(zMShape3D *ms, zSphere3D *bb);
+
+__END_DECLS
+
+#endif /* __ZEO_BV_SHAPE_H__ */
@@ -44,6 +44,100 @@ __EXPORT bool zColChkTriAABox3D(zTri3D *t, zAABox3D *box);
  */
 __EXPORT int zIntersectTriAABox3D(zTri3D *t, zAABox3D *box, zVec3D ip[]);
 
+/* ********************************************************** */
+/*! \brief arrays of triangles and axis-aligned boxes in the
+ * structure-of-arrays layout.
+ *
+ * zTri3DSoA is an array of \a num triangles, where \a v[3*j+k][i]
+ * is the k-th component of the j-th vertex of the i-th triangle.
+ *
+ * zAABox3DSoA is an array of \a num axis-aligned boxes, where
+ * \a c[k][i] is the k-th component of the center of the i-th box
+ * and \a e[k][i] is the half length of the i-th box along the k-th
+ * axis.
+ *
+ * In both, all components share one memory block \a buf.
+ *//* ******************************************************* */
+typedef struct{
+  int num;        /*!< number of triangles */
+  double *v[9];   /*!< vertices */
+  double *buf;    /*!< memory block */
+} zTri3DSoA;
+
+typedef struct{
+  int num;        /*!< number of boxes */
+  double *c[3];   /*!< centers */
+  double *e[3];   /*!< half lengths of edges */
+  double *buf;    /*!< memory block */
+} zAABox3DSoA;
+
+/*! \brief allocate, free and set arrays of triangles and axis-aligned boxes.
+ *
+ * zTri3DSoAAlloc() allocates an array of \a num triangles \a soa.
+ * zTri3DSoAFree() frees \a soa.
+ * zTri3DSoASet() sets a triangle \a tri for the \a i-th element of \a soa.
+ * zTri3DSoAFromPH3D() allocates \a soa and sets all faces of a
+ * polyhedron \a ph to it.
+ *
+ * zAABox3DSoAAlloc(), zAABox3DSoAFree() and zAABox3DSoASet() are
+ * the counterparts for an array of axis-aligned boxes.
+ * \return
+ * zTri3DSoAAlloc(), zTri3DSoAFromPH3D() and zAABox3DSoAAlloc() return
+ * a pointer \a soa, or the null pointer if they fail to allocate memory.
+ *
+ * zTri3DSoAFree() and zAABox3DSoAFree() return no value.
+ *
+ * zTri3DSoASet() and zAABox3DSoASet() return a pointer \a soa, or the
+ * null pointer if \a i is out of range.
+ */
+__EXPORT zTri3DSoA *zTri3DSoAAlloc(zTri3DSoA *soa, int num);
+__EXPORT void zTri3DSoAFree(zTri3DSoA *soa);
+__EXPORT zTri3DSoA *zTri3DSoASet(zTri3DSoA *soa, int i, zTri3D *tri);
+__EXPORT zTri3DSoA *zTri3DSoAFromPH3D(zTri3DSoA *soa, zPH3D *ph);
+
+__EXPORT zAABox3DSoA *zAABox3DSoAAlloc(zAABox3DSoA *soa, int num);
+__EXPORT void zAABox3DSoAFree(zAABox3DSoA *soa);
+__EXPORT zAABox3DSoA *zAABox3DSoASet(zAABox3DSoA *soa, int i, zAABox3D *box);
+
+/*! \brief bitmask of results of a batch collision check.
+ *
+ * A result of a batch collision check of \a n pairs is stored in an
+ * array of zColChkBitmaskSize(n) bytes, where the i-th pair is in the
+ * (i%8)-th bit of the (i/8)-th byte.
+ * zColChkBitmaskIsSet() checks if the i-th bit of \a mask is set.
+ */
+#define zColChkBitmaskSize(n)       ( ( (n) + 7 ) / 8 )
+#define zColChkBitmaskIsSet(mask,i) ( ( (mask)[(i)/8] >> ( (i)%8 ) ) & 1 )
+
+/*! \brief check if triangles and axis-aligned boxes intersect in a batch.
+ *
+ * zColChkTriAABox3DBatch() checks if each triangle in an array \a tri
+ * intersects with an axis-aligned box \a box.
+ *
+ * zColChkAABox3DTriBatch() checks if each axis-aligned box in an array
+ * \a box intersects with a triangle \a tri.
+ *
+ * zColChkPlaneAABox3DBatch() checks if a plane \a p intersects with
+ * each axis-aligned box in an array \a box.
+ *
+ * The results are stored in a bitmask \a mask, which has to have
+ * zColChkBitmaskSize() bytes for the number of elements of the array.
+ * zColChkTriAABox3DBatch() and zColChkAABox3DTriBatch() apply the
+ * separating axis test with thirteen axes to every eight pairs in
+ * lockstep, namely, each axis is tested on the eight pairs in the
+ * innermost loop, so that the loop can be vectorized by the compiler.
+ * The test of a block stops as soon as all its pairs are separated.
+ * Unlike zColChkTriAABox3D() and zColChkPlaneAABox3D(), a triangle
+ * or a plane which only touches a box is judged to intersect it.
+ * \return
+ * These functions return the number of intersecting pairs.
+ * \sa
+ * zColChkTriAABox3D, zColChkPlaneAABox3D
+ */
+__EXPORT int zColChkTriAABox3DBatch(zTri3DSoA *tri, zAABox3D *box, unsigned char mask[]);
+__EXPORT int zColChkAABox3DTriBatch(zAABox3DSoA *box, zTri3D *tri, unsigned char mask[]);
+__EXPORT int zColChkPlaneAABox3DBatch(zPlane3D *p, zAABox3DSoA *box, unsigned char mask[]);
+
 /*! \brief check collision between two axis-aligned boxes.
  *
  * zColChkAABox3D() checks if two axis-aligned boxes \a b1
@@ -73,11 +167,85 @@ __EXPORT zAABox3D *zIntersectPH3DBox(zPH3D *ph1, zPH3D *ph2, zAABox3D *box);
  *
  * zColChkBox3D() checks if a box \a b1 and another
  * \a b2 collide with each other.
+ * The separating axis theorem is applied to fifteen axes, namely,
+ * three face normals of each box and nine cross products of edges
+ * of the boxes, based on the relative rotation matrix of the boxes
+ * computed once (S. Gottschalk et al., 1996).
  * \retval true \a b1 and \a b2 collide with each other.
  * \retval false \a b1 and \a b2 do not collide.
  */
 __EXPORT bool zColChkBox3D(zBox3D *b1, zBox3D *b2);
 
+/* ********************************************************** */
+/*! \brief array of boxes in the structure-of-arrays layout.
+ *
+ * zBox3DSoA is an array of \a num boxes, where each component of
+ * the boxes is stored in a separate array for batch processing.
+ * \a c[j][i] is the j-th component of the center of the i-th box,
+ * \a e[j][i] is the half length of the i-th box along its j-th axis,
+ * and \a ax[3*j+k][i] is the k-th component of the j-th axis of the
+ * i-th box. All of them share one memory block \a buf.
+ *//* ******************************************************* */
+#define ZEO_BOX3DSOA_ELEM_NUM 15
+
+typedef struct{
+  int num;        /*!< number of boxes */
+  double *c[3];   /*!< centers */
+  double *e[3];   /*!< half lengths of edges */
+  double *ax[9];  /*!< axes */
+  double *buf;    /*!< memory block */
+} zBox3DSoA;
+
+/*! \brief allocate, free, set and get boxes of a box array.
+ *
+ * zBox3DSoAAlloc() allocates an array of \a num boxes \a soa.
+ *
+ * zBox3DSoAFree() frees \a soa.
+ *
+ * zBox3DSoASet() sets a box \a box for the \a i-th element of \a soa.
+ *
+ * zBox3DSoAGet() gets the \a i-th element of \a soa and puts it into
+ * \a box.
+ * \return
+ * zBox3DSoAAlloc() returns a pointer \a soa, or the null pointer if
+ * it fails to allocate memory.
+ *
+ * zBox3DSoAFree() returns no value.
+ *
+ * zBox3DSoASet() returns a pointer \a soa, and zBox3DSoAGet() returns
+ * a pointer \a box. Both return the null pointer if \a i is out of
+ * range.
+ */
+__EXPORT zBox3DSoA *zBox3DSoAAlloc(zBox3DSoA *soa, int num);
+__EXPORT void zBox3DSoAFree(zBox3DSoA *soa);
+__EXPORT zBox3DSoA *zBox3DSoASet(zBox3DSoA *soa, int i, zBox3D *box);
+__EXPORT zBox3D *zBox3DSoAGet(zBox3DSoA *soa, int i, zBox3D *box);
+
+/*! \brief check collision between boxes in a batch.
+ *
+ * zColChkBox3DBatch() checks if the i-th boxes of two arrays \a soa1
+ * and \a soa2 collide with each other for every i. \a soa1 and \a soa2
+ * have to have the same number of boxes.
+ *
+ * zColChkBox3DBatchOne() checks if a box \a box collides with each
+ * box in an array \a soa.
+ *
+ * The result for the i-th pair is stored in \a result[i], which has
+ * to have as many elements as boxes in the arrays.
+ * The same test with zColChkBox3D() is applied to every four pairs
+ * in lockstep, so that the loops over the pairs can be vectorized by
+ * the compiler. The test of the four pairs is terminated as soon as
+ * all of them are found to be separated.
+ * \return
+ * zColChkBox3DBatch() and zColChkBox3DBatchOne() return the number of
+ * colliding pairs. zColChkBox3DBatch() returns -1 if the sizes of
+ * \a soa1 and \a soa2 mismatch.
+ * \sa
+ * zColChkBox3D
+ */
+__EXPORT int zColChkBox3DBatch(zBox3DSoA *soa1, zBox3DSoA *soa2, bool result[]);
+__EXPORT int zColChkBox3DBatchOne(zBox3D *box, zBox3DSoA *soa, bool result[]);
+
 __END_DECLS
 
 #endif /* __ZEO_COL_BOX_H__ */
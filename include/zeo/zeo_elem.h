@@ -19,6 +19,40 @@ typedef enum{
   ZEO_RIM_TIGHT, ZEO_RIM_STRICT, ZEO_RIM_LOOSE,
 } zRimType;
 
+/* ********************************************************** */
+/*! \brief 3D ray class.
+ *
+ * zRay3D is a half-line which starts from \a org toward a unit
+ * direction vector \a dir. \a idir is the element-wise reciprocal
+ * of \a dir, which is for fast intersection tests with
+ * axis-aligned boxes.
+ *//********************************************************* */
+typedef struct{
+  zVec3D org;  /*!< origin */
+  zVec3D dir;  /*!< unit direction vector */
+  zVec3D idir; /*!< reciprocal of the direction vector */
+} zRay3D;
+
+#define zRay3DOrg(r)  ( &(r)->org )
+#define zRay3DDir(r)  ( &(r)->dir )
+#define zRay3DIDir(r) ( &(r)->idir )
+
+/*! \brief create a 3D ray.
+ *
+ * zRay3DCreate() creates a 3D ray \a ray which starts from \a org
+ * toward a direction \a dir. \a dir does not have to be normalized.
+ *
+ * zRay3DPoint() calculates a point on \a ray at the distance \a t
+ * from the origin, and puts it into \a p.
+ * \return
+ * zRay3DCreate() returns a pointer \a ray, or the null pointer if
+ * \a dir is the zero vector.
+ *
+ * zRay3DPoint() returns a pointer \a p.
+ */
+__EXPORT zRay3D *zRay3DCreate(zRay3D *ray, zVec3D *org, zVec3D *dir);
+__EXPORT zVec3D *zRay3DPoint(zRay3D *ray, double t, zVec3D *p);
+
 /* ********************************************************** */
 /*! \brief 3D plane class.
  *//********************************************************* */
@@ -79,6 +113,21 @@ __EXPORT double zPlane3DProj(zPlane3D *p, zVec3D *v, zVec3D *cp);
  */
 __EXPORT zPlane3D *zPlane3DMean(zPlane3D *pl, zVec3D *pc, zVec3D v[], int n);
 
+/*! \brief intersection of a ray and a plane.
+ *
+ * zPlane3DRaycast() finds the intersection of a ray \a ray and a
+ * plane \a p. On input, \a t is the maximum distance of the
+ * intersection to be found. If the ray hits \a p at a distance
+ * less than \a t, the distance is stored in \a t, and the normal
+ * vector of \a p at the intersection is stored in \a norm unless
+ * \a norm is the null pointer.
+ * \return
+ * zPlane3DRaycast() returns the true value if \a ray hits \a p
+ * within \a t. Otherwise, the false value is returned and neither
+ * \a t nor \a norm are modified.
+ */
+__EXPORT bool zPlane3DRaycast(zPlane3D *p, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief print a 3D plane.
  *
  * zPlane3DFPrint() prints information of a 3D plane \a p out
@@ -318,6 +367,19 @@ __EXPORT bool zTri3DPointIsInside(zTri3D *t, zVec3D *v, bool rim);
 __EXPORT double zTri3DLinScale(zTri3D *t, zVec3D *p, double *l0, double *l1, double *l2, zVec3D *cp);
 __EXPORT double zTri3DClosest(zTri3D *t, zVec3D *v, zVec3D *cp);
 
+/*! \brief intersection of a ray and a triangle.
+ *
+ * zTri3DRaycast() finds the intersection of a ray \a ray and a
+ * triangle \a tri by the Moller-Trumbore method. The meanings of
+ * \a t and \a norm are the same with zPlane3DRaycast().
+ * \return
+ * zTri3DRaycast() returns the true value if \a ray hits \a tri
+ * within \a t, or the false value otherwise.
+ * \sa
+ * zPlane3DRaycast
+ */
+__EXPORT bool zTri3DRaycast(zTri3D *tri, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief volume, inertia, barycenter and circumcenter of cone.
  *
  * zTri3DConeVolume() calculates the volume of a cone which consists
@@ -26,6 +26,7 @@
 #define ZEO_ERR_ELEM_DEGP    "too small normal vector to define a plane"
 #define ZEO_ERR_ELEM_DEGE    "edge degenerated"
 #define ZEO_ERR_ELEM_DEGT    "triangle degenerated"
+#define ZEO_ERR_ELEM_DEGR    "too small direction vector to define a ray"
 
 #define ZEO_ERR_NOFACE       "polyhedron has no face"
 #define ZEO_ERR_CENTER_MANY  "too many center points"
@@ -51,6 +52,16 @@
 #define ZEO_ERR_PLY_UNKNOWNPRP  "unknown property: %s"
 #define ZEO_ERR_PLY_UNSUPPORTED "unsupported description"
 
+#define ZEO_ERR_SDF_INVALID "invalid size of signed distance field"
+#define ZEO_ERR_SDF_EMPTY   "no shape to create signed distance field"
+#define ZEO_ERR_SDF_READ    "cannot read signed distance field"
+#define ZEO_ERR_SDF_WRITE   "cannot write signed distance field"
+
+#define ZEO_ERR_PCD_WRITE   "cannot write point cloud"
+
+#define ZEO_WARN_ACD_NOVOLUME    "polyhedron has no volume to be decomposed"
+#define ZEO_WARN_ACD_BROKENCACHE "%s: broken cache of convex decomposition"
+
 #define ZEO_ERR_NURBS_INVDIM "invalid dimension specified for NURBS, or lack of control points"
 #define ZEO_ERR_NURBS_SIZMIS      "size mismatch of NURBS surfaces"
 #define ZEO_ERR_NURBS_KNOTALREADY "knot already allocated"
@@ -67,6 +78,11 @@
 
 #define ZEO_ERR_EMPTYSET     "empty set assigned"
 
+#define ZEO_ERR_KDOP_INVALID "%d: invalid number of faces of k-DOP, which has to be 14, 18 or 26"
+#define ZEO_ERR_KDOP_SIZMIS  "size mismatch of k-DOPs"
+
+#define ZEO_ERR_COL_BOX_SIZMIS "size mismatch of arrays of boxes"
+
 #define ZEO_ERR_CH_DEG1      "point set degenerated into a single point"
 #define ZEO_ERR_CH_DEG2      "point set degenerated onto a single line"
 #define ZEO_ERR_CH_DEG3      "point set degenerated onto a single plane"
@@ -80,6 +96,8 @@
 
 #define ZEO_ERR_MAP_UNSPEC   "map type unspecified."
 
+#define ZEO_ERR_ICP_NONORM   "normal vectors unspecified for point-to-plane metric"
+
 #define ZEO_ERR_FATAL        "fatal error! - please report to the author"
 
 /* warning messages */
@@ -108,4 +126,8 @@
 
 #define ZEO_WARN_MAPNET_EMPTY     "empty map net assigned."
 
+#define ZEO_WARN_ICP_FEWCORR      "%d: too few correspondences to be registered"
+
+#define ZEO_WARN_RANSAC_NONORM    "normal vectors not estimated, cylinders not sampled"
+
 #endif /* __ZEO_ERRMSG_H__ */
@@ -93,4 +93,9 @@ __EXPORT bool zMShape3DWriteZTK(zMShape3D *ms, char filename[]);
 
 __END_DECLS
 
+#include <zeo/zeo_mshape_raycast.h>
+#include <zeo/zeo_mshape_scan.h>
+#include <zeo/zeo_mshape_sdf.h>
+#include <zeo/zeo_mshape_acd.h>
+
 #endif /* __ZEO_MSHAPE_H__ */
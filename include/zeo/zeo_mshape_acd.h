@@ -0,0 +1,79 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_acd - approximate convex decomposition of a polyhedron.
+ */
+
+#ifndef __ZEO_MSHAPE_ACD_H__
+#define __ZEO_MSHAPE_ACD_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+#define ZEO_ACD_SUFFIX "acd"
+
+/* ********************************************************** */
+/*! \brief parameters of approximate convex decomposition.
+ *
+ * zACDParam is a set of parameters for zPH3DConvexDecomp().
+ * \a resolution is the number of voxels along the longest side of
+ * the bounding box of a polyhedron to be decomposed.
+ * A piece is split further while its concavity, namely, the volume
+ * of its convex hull minus the volume of the piece itself relative
+ * to the volume of the whole polyhedron, is larger than \a concavity
+ * and the number of pieces is less than \a max_piece.
+ * \a plane_num is the number of candidate cutting planes along each
+ * axis.
+ *//* ******************************************************* */
+typedef struct{
+  int resolution;   /*!< number of voxels along the longest side */
+  double concavity; /*!< threshold of concavity */
+  int max_piece;    /*!< maximum number of pieces */
+  int plane_num;    /*!< number of candidate cutting planes per axis */
+} zACDParam;
+
+/*! \brief initialize parameters of approximate convex decomposition.
+ *
+ * zACDParamInit() sets default values of parameters \a param,
+ * namely, 64 voxels, concavity 0.01, 32 pieces and 8 planes.
+ * \return
+ * zACDParamInit() returns a pointer \a param.
+ */
+__EXPORT zACDParam *zACDParamInit(zACDParam *param);
+
+/*! \brief approximate convex decomposition of a polyhedron.
+ *
+ * zPH3DConvexDecomp() decomposes a polyhedron \a ph into convex
+ * pieces, and puts them into multiple shapes \a ms as polyhedra.
+ * \a ph does not have to be convex, but has to be closed.
+ * The inside of \a ph is voxelized and its surface is sampled, and
+ * the set of the points is split hierarchically by axis-aligned
+ * planes. The piece with the largest concavity is split at each step
+ * by the plane that minimizes the sum of concavities of the two
+ * halves. Each piece in \a ms is the convex hull of its points.
+ * A piece whose points are on a plane, which may be left from a wall
+ * thinner than a voxel, has no volume and is dropped.
+ * If the null pointer is given for \a param, the default parameters
+ * are used (see zACDParamInit()).
+ *
+ * zPH3DConvexDecompCache() does the same with zPH3DConvexDecomp(),
+ * but caches the result in a directory \a dirname. The name of the
+ * cache file is a 64-bit hash of \a ph and \a param, so that the
+ * result is read from the file if the same polyhedron is decomposed
+ * with the same parameters again. The file also stores the hash, the
+ * numbers of vertices and faces of \a ph and \a param, which are
+ * checked against the input before the file is accepted.
+ * \return
+ * zPH3DConvexDecomp() and zPH3DConvexDecompCache() return a pointer
+ * \a ms, or the null pointer if they fail to allocate memory or \a ph
+ * has no volume.
+ * \sa
+ * zCH3D
+ */
+__EXPORT zMShape3D *zPH3DConvexDecomp(zPH3D *ph, zACDParam *param, zMShape3D *ms);
+__EXPORT zMShape3D *zPH3DConvexDecompCache(zPH3D *ph, zACDParam *param, zMShape3D *ms, char dirname[]);
+
+__END_DECLS
+
+#endif /* __ZEO_MSHAPE_ACD_H__ */
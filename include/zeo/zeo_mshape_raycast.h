@@ -0,0 +1,84 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_raycast - ray casting against multiple 3D shapes.
+ */
+
+#ifndef __ZEO_MSHAPE_RAYCAST_H__
+#define __ZEO_MSHAPE_RAYCAST_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* number of rays traversed at once by zMShape3DRaycasterPacket() */
+#define ZEO_MSHAPE_RAYCAST_PACKET_SIZE 64
+
+/* ********************************************************** */
+/*! \brief ray caster of multiple 3D shapes.
+ *
+ * zMShape3DRaycaster is a bounding volume hierarchy of shapes of
+ * multiple 3D shapes \a ms for ray casting. The nodes are stored
+ * in a flat array \a node in the same manner with zPH3DBVH, and
+ * leaves refer to indices of shapes in \a shape. Each polyhedron
+ * in \a ms has its own hierarchy of faces in \a phbvh, and the
+ * element for a shape of the other types is empty.
+ * NURBS shapes are not included in the hierarchy.
+ * Note that the ray caster refers \a ms without copying it, so
+ * that it has to be rebuilt if \a ms is modified or freed.
+ *//* ******************************************************* */
+typedef struct{
+  zMShape3D *ms;       /*!< multiple shapes */
+  int nodenum;         /*!< number of nodes */
+  zPH3DBVHNode *node;  /*!< array of nodes */
+  int *shape;          /*!< array of indices of shapes */
+  zPH3DBVH *phbvh;     /*!< hierarchies of faces of polyhedra */
+} zMShape3DRaycaster;
+
+/*! \brief build and destroy a ray caster of multiple 3D shapes.
+ *
+ * zMShape3DRaycasterBuild() builds a ray caster \a rc of multiple
+ * 3D shapes \a ms. The axis-aligned bounding box of each shape is
+ * computed from its parameters, and the shapes are recursively split
+ * at the median of the centers of the boxes along the longest axis.
+ *
+ * zMShape3DRaycasterDestroy() destroys \a rc. \a ms is not destroyed.
+ * \return
+ * zMShape3DRaycasterBuild() returns a pointer \a rc, or the null
+ * pointer if it fails to allocate memory.
+ *
+ * zMShape3DRaycasterDestroy() returns no value.
+ */
+__EXPORT zMShape3DRaycaster *zMShape3DRaycasterBuild(zMShape3DRaycaster *rc, zMShape3D *ms);
+__EXPORT void zMShape3DRaycasterDestroy(zMShape3DRaycaster *rc);
+
+/*! \brief cast rays to multiple 3D shapes.
+ *
+ * zMShape3DRaycasterCast() finds the nearest intersection of a ray
+ * \a ray and shapes of a ray caster \a rc. The meanings of \a t and
+ * \a norm are the same with zShape3DRaycast().
+ *
+ * zMShape3DRaycasterPacket() casts \a num rays in an array \a ray at
+ * once. \a t[i] is the maximum distance for \a ray[i] on input and
+ * the distance to the intersection on output. If \a norm is not the
+ * null pointer, the normal vector at the intersection is set into
+ * \a norm[i]. The index of the hit shape is set into \a id[i], or
+ * -1 if \a ray[i] hits nothing. Rays are traversed together in
+ * packets of ZEO_MSHAPE_RAYCAST_PACKET_SIZE, sharing the visits of
+ * nodes, which is efficient for coherent rays such as those of a
+ * range sensor.
+ * \return
+ * zMShape3DRaycasterCast() returns the index of the hit shape in
+ * the multiple shapes, or -1 if \a ray hits nothing.
+ *
+ * zMShape3DRaycasterPacket() returns the number of rays which hit
+ * the shapes.
+ * \sa
+ * zShape3DRaycast, zPH3DBVHRaycast
+ */
+__EXPORT int zMShape3DRaycasterCast(zMShape3DRaycaster *rc, zRay3D *ray, double *t, zVec3D *norm);
+__EXPORT int zMShape3DRaycasterPacket(zMShape3DRaycaster *rc, zRay3D ray[], int num, double t[], zVec3D norm[], int id[]);
+
+__END_DECLS
+
+#endif /* __ZEO_MSHAPE_RAYCAST_H__ */
@@ -0,0 +1,95 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_scan - simulation of range sensors over multiple 3D shapes.
+ */
+
+#ifndef __ZEO_MSHAPE_SCAN_H__
+#define __ZEO_MSHAPE_SCAN_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief range sensor model.
+ *
+ * zRangeSensor3D is a model of a range sensor, which is either a
+ * depth camera or a spinning lidar. The sensor casts \a width x
+ * \a height rays from its origin, and measures distances to
+ * surfaces within the range from \a rmin to \a rmax.
+ * \a dir is an array of unit direction vectors of the rays with
+ * respect to the sensor frame, which are ordered row by row. The
+ * measured depth of a ray is \a scale times the distance along it.
+ * \a ray, \a t and \a id are internal workspaces.
+ *//* ******************************************************* */
+typedef struct{
+  int width;     /*!< number of columns */
+  int height;    /*!< number of rows */
+  double rmin;   /*!< minimum range */
+  double rmax;   /*!< maximum range */
+  zVec3D *dir;   /*!< directions of rays */
+  double *scale; /*!< scale factors from distances to depths */
+  zRay3D *ray;   /*!< workspace: rays in the world frame */
+  double *t;     /*!< workspace: distances to surfaces */
+  int *id;       /*!< workspace: identifiers of hit shapes */
+} zRangeSensor3D;
+
+#define zRangeSensor3DRayNum(s) ( (s)->width * (s)->height )
+
+/*! \brief create a range sensor.
+ *
+ * zRangeSensor3DCreatePinhole() creates a depth camera \a sensor of
+ * the pinhole model, whose image has \a width x \a height pixels.
+ * \a fx and \a fy are the focal lengths in pixels, and (\a cx, \a cy)
+ * is the principal point. The optical axis of the camera is the
+ * z-axis of the sensor frame, and x-axis and y-axis are rightward
+ * and downward in the image, respectively. The depth of a pixel is
+ * the z-coordinate of the surface point in the sensor frame.
+ *
+ * zRangeSensor3DCreateLidar() creates a spinning lidar \a sensor,
+ * which has \a height channels of elevation angles evenly from
+ * \a emin to \a emax, and measures \a width azimuth angles evenly
+ * from \a amin to \a amax per channel. The azimuth angle is about
+ * z-axis from x-axis of the sensor frame, and the elevation angle
+ * is from x-y plane. The depth of a ray is the distance to the
+ * surface point. Rows are ordered from the highest channel.
+ *
+ * For both, \a rmin and \a rmax are the minimum and maximum range.
+ *
+ * zRangeSensor3DDestroy() destroys \a sensor.
+ * \return
+ * zRangeSensor3DCreatePinhole() and zRangeSensor3DCreateLidar()
+ * return a pointer \a sensor, or the null pointer if it fails to
+ * allocate memory.
+ *
+ * zRangeSensor3DDestroy() returns no value.
+ */
+__EXPORT zRangeSensor3D *zRangeSensor3DCreatePinhole(zRangeSensor3D *sensor, int width, int height, double fx, double fy, double cx, double cy, double rmin, double rmax);
+__EXPORT zRangeSensor3D *zRangeSensor3DCreateLidar(zRangeSensor3D *sensor, int width, int height, double amin, double amax, double emin, double emax, double rmin, double rmax);
+__EXPORT void zRangeSensor3DDestroy(zRangeSensor3D *sensor);
+
+/*! \brief simulate a scan of a range sensor.
+ *
+ * zRangeSensor3DScan() simulates a scan of a range sensor \a sensor
+ * located at a frame \a pose in a scene of multiple shapes given by
+ * a ray caster \a rc.
+ * If \a depth is not the null pointer, the depth image is stored in
+ * it row by row, where pixels with no return are set for zero.
+ * \a depth has to have zRangeSensor3DRayNum(\a sensor) elements.
+ * If \a p is not the null pointer, surface points measured by the
+ * sensor are stored in it with respect to the sensor frame in order
+ * of rays, skipping rays with no return. \a p has to have
+ * zRangeSensor3DRayNum(\a sensor) elements at most.
+ * Rays are cast to \a rc in packets, so that a scan of a typical
+ * resolution costs much less than casting rays one by one.
+ * \return
+ * zRangeSensor3DScan() returns the number of rays with returns.
+ * \sa
+ * zMShape3DRaycasterPacket, zVec3DArrayWritePCDFile
+ */
+__EXPORT int zRangeSensor3DScan(zRangeSensor3D *sensor, zMShape3DRaycaster *rc, zFrame3D *pose, double depth[], zVec3D p[]);
+
+__END_DECLS
+
+#endif /* __ZEO_MSHAPE_SCAN_H__ */
@@ -0,0 +1,115 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_sdf - signed distance field of multiple 3D shapes.
+ */
+
+#ifndef __ZEO_MSHAPE_SDF_H__
+#define __ZEO_MSHAPE_SDF_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief signed distance field.
+ *
+ * zSDF3D is a signed distance field sampled on a dense regular
+ * grid of \a num[0] x \a num[1] x \a num[2] points, which are
+ * placed at intervals \a pitch from \a org along x, y and z axes.
+ * The value at each grid point is the distance to the surface of
+ * shapes, which is negative inside of them.
+ *//* ******************************************************* */
+typedef struct{
+  zVec3D org;   /*!< position of the first grid point */
+  double pitch; /*!< interval of grid points */
+  int num[3];   /*!< numbers of grid points along axes */
+  double *val;  /*!< distances at grid points */
+} zSDF3D;
+
+#define zSDF3DVal(s,i,j,k) (s)->val[( (k)*(s)->num[1] + (j) )*(s)->num[0] + (i)]
+
+/*! \brief allocate and destroy a signed distance field.
+ *
+ * zSDF3DAlloc() allocates a signed distance field \a sdf of \a nx x
+ * \a ny x \a nz grid points, where the first point is at \a org and
+ * the interval of points is \a pitch. Values are initialized to zero.
+ * Each of \a nx, \a ny and \a nz has to be two or more, and the
+ * total number of points must not exceed INT_MAX so that zSDF3DVal()
+ * can index every point.
+ *
+ * zSDF3DDestroy() destroys \a sdf.
+ * \return
+ * zSDF3DAlloc() returns a pointer \a sdf, or the null pointer if it
+ * fails to allocate memory or the given size is invalid.
+ *
+ * zSDF3DDestroy() returns no value.
+ */
+__EXPORT zSDF3D *zSDF3DAlloc(zSDF3D *sdf, zVec3D *org, double pitch, int nx, int ny, int nz);
+__EXPORT void zSDF3DDestroy(zSDF3D *sdf);
+
+/*! \brief create a signed distance field of shapes.
+ *
+ * zSDF3DFromMShape() creates a signed distance field \a sdf of
+ * multiple shapes \a ms. The grid covers the bounding box of \a ms
+ * expanded by \a margin, with an interval \a pitch.
+ * The distance at a grid point outside of the shapes is computed
+ * exactly; the closest points on polyhedra are found through
+ * bounding volume hierarchies of their faces. The distance at a grid
+ * point inside of the shapes is computed by the fast sweeping method
+ * from those of adjacent outside points, whose error is in the
+ * order of \a pitch.
+ * Polyhedra do not have to be convex, but have to be closed.
+ * NURBS shapes are ignored.
+ *
+ * zSDF3DFromShape() and zSDF3DFromPH() create a signed distance
+ * field of a shape \a shape and a polyhedron \a ph, respectively.
+ * \return
+ * zSDF3DFromMShape(), zSDF3DFromShape() and zSDF3DFromPH() return
+ * a pointer \a sdf, or the null pointer if no shape is given or
+ * they fail to allocate memory.
+ */
+__EXPORT zSDF3D *zSDF3DFromMShape(zSDF3D *sdf, zMShape3D *ms, double pitch, double margin);
+__EXPORT zSDF3D *zSDF3DFromShape(zSDF3D *sdf, zShape3D *shape, double pitch, double margin);
+__EXPORT zSDF3D *zSDF3DFromPH(zSDF3D *sdf, zPH3D *ph, double pitch, double margin);
+
+/*! \brief signed distance and its gradient.
+ *
+ * zSDF3DDist() computes the signed distance at a point \a p from a
+ * signed distance field \a sdf by the trilinear interpolation of
+ * the values at the eight surrounding grid points. If \a grad is not
+ * the null pointer, the gradient of the interpolated distance is
+ * stored in it.
+ * For \a p out of the grid, the distance from \a p to the grid box
+ * is added to the distance at the closest point on the box, and
+ * the gradient is the direction from the point to \a p.
+ * \return
+ * zSDF3DDist() returns the signed distance.
+ */
+__EXPORT double zSDF3DDist(zSDF3D *sdf, zVec3D *p, zVec3D *grad);
+
+#define ZEO_SDF_SUFFIX "sdf"
+
+/*! \brief read and write a signed distance field.
+ *
+ * zSDF3DFWrite() writes a signed distance field \a sdf to a file
+ * \a fp in a binary format, and zSDF3DFRead() reads it from \a fp.
+ * zSDF3DWriteFile() and zSDF3DReadFile() do the same with a file
+ * \a filename.
+ * The binary format depends on the byte order of the machine.
+ * \return
+ * zSDF3DFWrite() and zSDF3DWriteFile() return the true value if
+ * they succeed, or the false value otherwise.
+ *
+ * zSDF3DFRead() and zSDF3DReadFile() return a pointer \a sdf, or
+ * the null pointer if they fail to read the file, or if the header
+ * of the file has an invalid size or more points than the file holds.
+ */
+__EXPORT bool zSDF3DFWrite(FILE *fp, zSDF3D *sdf);
+__EXPORT zSDF3D *zSDF3DFRead(FILE *fp, zSDF3D *sdf);
+__EXPORT bool zSDF3DWriteFile(zSDF3D *sdf, char filename[]);
+__EXPORT zSDF3D *zSDF3DReadFile(zSDF3D *sdf, char filename[]);
+
+__END_DECLS
+
+#endif /* __ZEO_MSHAPE_SDF_H__ */
@@ -113,6 +113,18 @@ __EXPORT double zPH3DClosest(zPH3D *ph, zVec3D *p, zVec3D *cp);
 __EXPORT double zPH3DPointDist(zPH3D *ph, zVec3D *p);
 __EXPORT bool zPH3DPointIsInside(zPH3D *ph, zVec3D *v, bool rim);
 
+/*! \brief intersection of a ray and a 3D polyhedron.
+ *
+ * zPH3DRaycast() finds the nearest intersection of a ray \a ray and
+ * faces of a 3D polyhedron \a ph. The meanings of \a t and \a norm
+ * are the same with zTri3DRaycast(). All faces are tested, so that
+ * zPH3DBVHRaycast() is preferable for a polyhedron with many faces.
+ * \return
+ * zPH3DRaycast() returns the true value if \a ray hits \a ph within
+ * \a t, or the false value otherwise.
+ */
+__EXPORT bool zPH3DRaycast(zPH3D *ph, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief volume, barycenter and inertia of a 3D polyhedron.
  *
  * zPH3DVolume() calculates the volume of a polyhedron \a ph.
@@ -198,5 +210,8 @@ __END_DECLS
 
 #include <zeo/zeo_ph_stl.h>
 #include <zeo/zeo_ph_ply.h>
+#include <zeo/zeo_ph_bvh.h>
+#include <zeo/zeo_ph_idx.h>
+#include <zeo/zeo_ph_he.h>
 
 #endif /* __ZEO_PH_H__ */
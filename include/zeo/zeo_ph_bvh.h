@@ -0,0 +1,138 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_ph_bvh - bounding volume hierarchy of faces of a polyhedron.
+ */
+
+#ifndef __ZEO_PH_BVH_H__
+#define __ZEO_PH_BVH_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief node of a bounding volume hierarchy of faces.
+ *
+ * zPH3DBVHNode is a node of a bounding volume hierarchy, which
+ * has an axis-aligned box from \a vmin to \a vmax.
+ * For an internal node, \a num is zero and two children are
+ * stored at \a child and \a child+1 of the node array.
+ * For a leaf, \a num faces are listed from \a child of the face
+ * index array.
+ *//* ******************************************************* */
+typedef struct{
+  zVec3D vmin; /*!< minimum corner of bounding box */
+  zVec3D vmax; /*!< maximum corner of bounding box */
+  int child;   /*!< index of the first child or the first face */
+  int num;     /*!< number of faces of a leaf */
+} zPH3DBVHNode;
+
+/* ********************************************************** */
+/*! \brief bounding volume hierarchy of faces of a polyhedron.
+ *
+ * zPH3DBVH is a bounding volume hierarchy (BVH) of triangular
+ * faces of a polyhedron \a ph, which accelerates proximity queries
+ * against a polyhedron with a large number of faces.
+ * The nodes are stored in a flat array \a node with the root at
+ * the head. \a face is an array of indices of faces of \a ph,
+ * which is ordered so that faces of each leaf are contiguous.
+ * Note that the tree refers \a ph without copying it, so that it
+ * has to be rebuilt if \a ph is modified or freed.
+ *//* ******************************************************* */
+typedef struct{
+  zPH3D *ph;          /*!< polyhedron */
+  int nodenum;        /*!< number of nodes */
+  zPH3DBVHNode *node; /*!< array of nodes */
+  int *face;          /*!< array of indices of faces */
+} zPH3DBVH;
+
+/*! \brief build and destroy a bounding volume hierarchy of a polyhedron.
+ *
+ * zPH3DBVHBuild() builds a bounding volume hierarchy \a bvh of faces
+ * of a polyhedron \a ph. Each node is split along the axis and at
+ * the position that minimize the surface area heuristic (SAH) cost
+ * estimated by binning centroids of faces.
+ *
+ * zPH3DBVHDestroy() destroys \a bvh. \a ph is not destroyed.
+ * \return
+ * zPH3DBVHBuild() returns a pointer \a bvh, or the null pointer if
+ * it fails to allocate memory.
+ *
+ * zPH3DBVHDestroy() returns no value.
+ */
+__EXPORT zPH3DBVH *zPH3DBVHBuild(zPH3DBVH *bvh, zPH3D *ph);
+__EXPORT void zPH3DBVHDestroy(zPH3DBVH *bvh);
+
+/*! \brief closest point on a polyhedron by a bounding volume hierarchy.
+ *
+ * zPH3DBVHClosest() finds the closest point on the polyhedron of
+ * a bounding volume hierarchy \a bvh from a point \a p, and sets it
+ * into \a cp. It traverses the hierarchy from the nearer child and
+ * skips nodes whose boxes are farther than the closest face found,
+ * so that the computation time is logarithmic to the number of
+ * faces in typical cases. The result is the same with that of
+ * zPH3DClosest() for the polyhedron.
+ *
+ * zPH3DBVHPointDist() calculates the distance from \a p to the
+ * polyhedron of \a bvh.
+ * \return
+ * zPH3DBVHClosest() and zPH3DBVHPointDist() return the distance
+ * between \a p and the polyhedron.
+ * \sa
+ * zPH3DClosest, zPH3DPointDist
+ */
+__EXPORT double zPH3DBVHClosest(zPH3DBVH *bvh, zVec3D *p, zVec3D *cp);
+__EXPORT double zPH3DBVHPointDist(zPH3DBVH *bvh, zVec3D *p);
+
+/*! \brief check if a point is inside of a polyhedron by a bounding volume hierarchy.
+ *
+ * zPH3DBVHPointIsInside() checks if a point \a p is inside of the
+ * polyhedron of a bounding volume hierarchy \a bvh. Unlike
+ * zPH3DPointIsInside(), the polyhedron does not have to be convex;
+ * the number of crossings of a half-line from \a p and faces of the
+ * polyhedron is counted, which is odd if \a p is inside. The faces
+ * to be tested are picked up through the hierarchy. If the half-line
+ * passes an edge or a vertex, another half-line in a different
+ * direction is tested instead.
+ * \a p on the surface of the polyhedron is judged to be inside if
+ * the true value is given for \a rim.
+ *
+ * zPH3DBVHPointArrayIsInside() checks if each of points \a p is
+ * inside of the polyhedron of \a bvh. \a num is the number of points.
+ * The result for \a p[i] is stored in \a inside[i], where \a inside
+ * has to have \a num elements.
+ * \return
+ * zPH3DBVHPointIsInside() returns the true value if \a p is inside
+ * of the polyhedron, or the false value otherwise.
+ *
+ * zPH3DBVHPointArrayIsInside() returns the number of points inside
+ * of the polyhedron.
+ * \notes
+ * The polyhedron is assumed to be closed. For a polyhedron with holes,
+ * the result depends on the direction of the half-line.
+ * \sa
+ * zPH3DPointIsInside
+ */
+__EXPORT bool zPH3DBVHPointIsInside(zPH3DBVH *bvh, zVec3D *p, bool rim);
+__EXPORT int zPH3DBVHPointArrayIsInside(zPH3DBVH *bvh, zVec3D p[], int num, bool rim, bool inside[]);
+
+/*! \brief intersection of a ray and a polyhedron by a bounding volume hierarchy.
+ *
+ * zPH3DBVHRaycast() finds the nearest intersection of a ray \a ray
+ * and the polyhedron of a bounding volume hierarchy \a bvh. The
+ * hierarchy is traversed from the child which the ray enters first,
+ * and nodes farther than the nearest intersection found are skipped.
+ * The meanings of \a t and \a norm are the same with zTri3DRaycast().
+ * The result is the same with that of zPH3DRaycast().
+ * \return
+ * zPH3DBVHRaycast() returns the true value if \a ray hits the
+ * polyhedron within \a t, or the false value otherwise.
+ * \sa
+ * zPH3DRaycast
+ */
+__EXPORT bool zPH3DBVHRaycast(zPH3DBVH *bvh, zRay3D *ray, double *t, zVec3D *norm);
+
+__END_DECLS
+
+#endif /* __ZEO_PH_BVH_H__ */
@@ -0,0 +1,138 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_ph_he - half-edge adjacency of a polyhedron.
+ */
+
+#ifndef __ZEO_PH_HE_H__
+#define __ZEO_PH_HE_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief half-edge adjacency of a polyhedron.
+ *
+ * zPH3DHE is the half-edge adjacency of faces of a polyhedron \a ph.
+ * The j-th edge of the i-th face, which directs from the j-th vertex
+ * to the (j+1)%3-th vertex of the face, is identified by the index
+ * 3*i+j of the half-edge. Hence, the face, the next and the previous
+ * half-edges of a half-edge are found without any table.
+ * \a org[h] is the index of the original vertex of the h-th half-edge
+ * in the vertex array of \a ph.
+ * \a twin[h] is the index of the half-edge which directs opposite to
+ * the h-th half-edge on the adjacent face. It is ZEO_PH3DHE_BOUNDARY
+ * if the h-th half-edge is on the boundary, or ZEO_PH3DHE_NONMANIFOLD
+ * if more than two faces share the edge, if two faces share it in
+ * the same direction, or if the face is degenerate, namely, it has
+ * coincident vertices.
+ * \a vhe[v] is an outgoing half-edge of the v-th vertex, which is -1
+ * for an isolated vertex or a vertex only on degenerate faces. For a
+ * vertex on the boundary, it is chosen so that the one-ring of the
+ * vertex is traversed from the boundary.
+ * Vertices are identified by their indices, so that faces have to
+ * share vertices for the adjacency to be found.
+ * Note that the adjacency refers \a ph without copying it, so that it
+ * has to be rebuilt if \a ph is modified or freed.
+ *//* ******************************************************* */
+#define ZEO_PH3DHE_BOUNDARY    -1
+#define ZEO_PH3DHE_NONMANIFOLD -2
+
+typedef struct{
+  zPH3D *ph;    /*!< polyhedron */
+  int *org;     /*!< original vertices of half-edges */
+  int *twin;    /*!< twin half-edges */
+  int *vhe;     /*!< outgoing half-edges of vertices */
+} zPH3DHE;
+
+#define zPH3DHENum(he)       ( zPH3DFaceNum((he)->ph) * 3 )
+#define zPH3DHEFace(h)       ( (h) / 3 )
+#define zPH3DHENext(h)       ( (h) % 3 == 2 ? (h) - 2 : (h) + 1 )
+#define zPH3DHEPrev(h)       ( (h) % 3 == 0 ? (h) + 2 : (h) - 1 )
+#define zPH3DHEOrg(he,h)     (he)->org[h]
+#define zPH3DHEDest(he,h)    (he)->org[zPH3DHENext(h)]
+#define zPH3DHETwin(he,h)    (he)->twin[h]
+#define zPH3DHEVertHE(he,v)  (he)->vhe[v]
+#define zPH3DHEIsBoundary(he,h) ( (he)->twin[h] == ZEO_PH3DHE_BOUNDARY )
+
+/*! \brief build and destroy the half-edge adjacency of a polyhedron.
+ *
+ * zPH3DHEBuild() builds the half-edge adjacency \a he of faces of a
+ * polyhedron \a ph. Half-edges are paired through a hash table keyed
+ * by their end vertices, so that the computation time is linear to
+ * the number of faces.
+ *
+ * zPH3DHEDestroy() destroys \a he. \a ph is not destroyed.
+ * \return
+ * zPH3DHEBuild() returns a pointer \a he, or the null pointer if it
+ * fails to allocate memory or if an index of a vertex is out of range.
+ *
+ * zPH3DHEDestroy() returns no value.
+ */
+__EXPORT zPH3DHE *zPH3DHEBuild(zPH3DHE *he, zPH3D *ph);
+__EXPORT void zPH3DHEDestroy(zPH3DHE *he);
+
+/*! \brief adjacency queries of a polyhedron.
+ *
+ * zPH3DHEFaceNeighbor() finds the face adjacent to the \a i-th face
+ * across its \a j-th edge, which directs from the j-th vertex to the
+ * (j+1)%3-th vertex of the face.
+ *
+ * zPH3DHEVertNeighbor() finds vertices adjacent to the \a v-th vertex,
+ * namely, the one-ring of the vertex, and stores their indices into
+ * \a nb. zPH3DHEVertFace() finds faces which share the \a v-th vertex
+ * and stores their indices into \a f. \a size is the size of \a nb
+ * and \a f, and indices more than \a size are not stored.
+ * For a vertex where multiple fans of faces meet, only the fan which
+ * includes zPH3DHEVertHE(he,v) is traversed.
+ * \return
+ * zPH3DHEFaceNeighbor() returns the index of the adjacent face, or -1
+ * if the edge is on the boundary or non-manifold.
+ *
+ * zPH3DHEVertNeighbor() and zPH3DHEVertFace() return the number of
+ * the adjacent vertices and faces, respectively, which may be larger
+ * than \a size.
+ */
+__EXPORT int zPH3DHEFaceNeighbor(zPH3DHE *he, int i, int j);
+__EXPORT int zPH3DHEVertNeighbor(zPH3DHE *he, int v, int nb[], int size);
+__EXPORT int zPH3DHEVertFace(zPH3DHE *he, int v, int f[], int size);
+
+/*! \brief boundary loops of a polyhedron.
+ *
+ * zPH3DHEBoundaryNext() finds the boundary half-edge which follows
+ * a boundary half-edge \a h along a boundary loop.
+ *
+ * zPH3DHEBoundaryLoop() classifies boundary half-edges of \a he into
+ * loops. The index of the loop is stored into \a loop[h] for the h-th
+ * half-edge, where -1 is stored for half-edges not on the boundary.
+ * \a loop has to have zPH3DHENum(he) elements.
+ * \return
+ * zPH3DHEBoundaryNext() returns the index of the following half-edge,
+ * or -1 if \a h is not on the boundary or the loop is broken by a
+ * non-manifold edge.
+ *
+ * zPH3DHEBoundaryLoop() returns the number of boundary loops.
+ */
+__EXPORT int zPH3DHEBoundaryNext(zPH3DHE *he, int h);
+__EXPORT int zPH3DHEBoundaryLoop(zPH3DHE *he, int loop[]);
+
+/*! \brief check if a polyhedron is manifold and closed.
+ *
+ * zPH3DHEIsManifold() checks if the polyhedron of \a he is a manifold,
+ * namely, every edge is shared by at most two faces in the opposite
+ * directions, and faces around every vertex form a single fan.
+ *
+ * zPH3DHEIsClosed() checks if the polyhedron of \a he is closed,
+ * namely, it is a manifold without any boundary.
+ * \return
+ * zPH3DHEIsManifold() and zPH3DHEIsClosed() return the true value if
+ * the polyhedron is manifold and closed, respectively, or the false
+ * value otherwise.
+ */
+__EXPORT bool zPH3DHEIsManifold(zPH3DHE *he);
+__EXPORT bool zPH3DHEIsClosed(zPH3DHE *he);
+
+__END_DECLS
+
+#endif /* __ZEO_PH_HE_H__ */
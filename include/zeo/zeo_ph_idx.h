@@ -0,0 +1,122 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_ph_idx - compact indexed representation of a polyhedron.
+ */
+
+#ifndef __ZEO_PH_IDX_H__
+#define __ZEO_PH_IDX_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief compact indexed polyhedron.
+ *
+ * zPH3DIdx is a compact representation of a polyhedron, which is
+ * suitable for meshes with a large number of faces.
+ * Each face is represented by three indices of vertices in \a idx
+ * instead of pointers, namely, \a idx[3*i+j] is the index of the
+ * j-th vertex of the i-th face. Normal vectors of faces are optionally
+ * stored in a separate array \a norm in single precision, where
+ * \a norm[3*i+k] is the k-th component of the normal vector of the
+ * i-th face. \a norm is the null pointer if normal vectors are not
+ * stored.
+ * A face occupies 12 bytes, or 24 bytes with a normal vector, while
+ * a face of zPH3D occupies 48 bytes on 64-bit architectures.
+ *//* ******************************************************* */
+typedef struct{
+  int vertnum;   /*!< number of vertices */
+  zVec3D *vert;  /*!< array of vertices */
+  int facenum;   /*!< number of faces */
+  int32_t *idx;  /*!< indices of vertices of faces */
+  float *norm;   /*!< normal vectors of faces */
+} zPH3DIdx;
+
+#define zPH3DIdxVertNum(ph)      (ph)->vertnum
+#define zPH3DIdxVert(ph,i)       ( &(ph)->vert[i] )
+#define zPH3DIdxFaceNum(ph)      (ph)->facenum
+#define zPH3DIdxFaceVertID(ph,i,j) (ph)->idx[3*(i)+(j)]
+#define zPH3DIdxFaceVert(ph,i,j) zPH3DIdxVert( ph, zPH3DIdxFaceVertID(ph,i,j) )
+#define zPH3DIdxHasNorm(ph)      ( (ph)->norm != NULL )
+
+/*! \brief initialize, allocate and destroy a compact indexed polyhedron.
+ *
+ * zPH3DIdxInit() initializes a compact indexed polyhedron \a ph by
+ * nullifying arrays in it.
+ *
+ * zPH3DIdxAlloc() allocates arrays of \a vn vertices and \a fn faces
+ * of \a ph. If the true value is given for \a norm, an array of normal
+ * vectors of faces is also allocated.
+ *
+ * zPH3DIdxDestroy() destroys \a ph.
+ * \return
+ * zPH3DIdxInit() returns a pointer \a ph.
+ * zPH3DIdxAlloc() returns a pointer \a ph, or the null pointer if it
+ * fails to allocate memory.
+ * zPH3DIdxDestroy() returns no value.
+ */
+__EXPORT zPH3DIdx *zPH3DIdxInit(zPH3DIdx *ph);
+__EXPORT zPH3DIdx *zPH3DIdxAlloc(zPH3DIdx *ph, int vn, int fn, bool norm);
+__EXPORT void zPH3DIdxDestroy(zPH3DIdx *ph);
+
+/*! \brief conversion between a polyhedron and a compact indexed polyhedron.
+ *
+ * zPH3DToIdx() converts a polyhedron \a src to a compact indexed
+ * polyhedron \a dest. Normal vectors of faces are copied if the true
+ * value is given for \a norm.
+ *
+ * zPH3DIdxToPH3D() converts a compact indexed polyhedron \a src to
+ * a polyhedron \a dest.
+ *
+ * zPH3DIdxCalcNorm() calculates normal vectors of faces of \a ph and
+ * stores them. The array of normal vectors is allocated if \a ph does
+ * not have it.
+ * \return
+ * zPH3DToIdx() and zPH3DIdxToPH3D() return a pointer \a dest, and
+ * zPH3DIdxCalcNorm() returns a pointer \a ph. They return the null
+ * pointer if they fail to allocate memory or if an index of a vertex
+ * is out of range.
+ */
+__EXPORT zPH3DIdx *zPH3DToIdx(zPH3D *src, zPH3DIdx *dest, bool norm);
+__EXPORT zPH3D *zPH3DIdxToPH3D(zPH3DIdx *src, zPH3D *dest);
+__EXPORT zPH3DIdx *zPH3DIdxCalcNorm(zPH3DIdx *ph);
+
+/*! \brief a face of a compact indexed polyhedron as a triangle.
+ *
+ * zPH3DIdxFace() sets the \a i-th face of a compact indexed polyhedron
+ * \a ph to a triangle \a tri, so that functions for zTri3D can be
+ * applied to faces without converting the whole polyhedron. Vertices
+ * of \a tri point those of \a ph. The normal vector is copied from
+ * \a ph if stored, or calculated otherwise.
+ * \return
+ * zPH3DIdxFace() returns a pointer \a tri.
+ */
+__EXPORT zTri3D *zPH3DIdxFace(zPH3DIdx *ph, int i, zTri3D *tri);
+
+/*! \brief closest point on, volume and barycenter of a compact indexed polyhedron.
+ *
+ * zPH3DIdxClosest() finds the closest point on a compact indexed
+ * polyhedron \a ph from a point \a p and sets it into \a cp.
+ * zPH3DIdxPointDist() calculates the distance between \a p and \a ph.
+ *
+ * zPH3DIdxVolume() calculates the volume of \a ph.
+ * zPH3DIdxBarycenter() calculates the barycenter of \a ph and sets
+ * it into \a c.
+ *
+ * They are the counterparts of zPH3DClosest(), zPH3DPointDist(),
+ * zPH3DVolume() and zPH3DBarycenter(), respectively.
+ * \return
+ * zPH3DIdxClosest() and zPH3DIdxPointDist() return the distance.
+ * zPH3DIdxVolume() returns the volume.
+ * zPH3DIdxBarycenter() returns a pointer \a c.
+ */
+__EXPORT double zPH3DIdxClosest(zPH3DIdx *ph, zVec3D *p, zVec3D *cp);
+__EXPORT double zPH3DIdxPointDist(zPH3DIdx *ph, zVec3D *p);
+__EXPORT double zPH3DIdxVolume(zPH3DIdx *ph);
+__EXPORT zVec3D *zPH3DIdxBarycenter(zPH3DIdx *ph, zVec3D *c);
+
+__END_DECLS
+
+#endif /* __ZEO_PH_IDX_H__ */
@@ -11,6 +11,21 @@
 
 __BEGIN_DECLS
 
+/*! \brief tolerance to weld vertices of STL.
+ *
+ * Since STL does not share vertices among facets, vertices of facets
+ * read from STL are welded into shared vertices of a polyhedron. Two
+ * vertices are welded if differences of all components between them
+ * are within a tolerance, which is zTOL by default.
+ *
+ * zSTLSetWeldTol() sets the tolerance to weld vertices for \a tol.
+ * zSTLWeldTol() returns the current tolerance.
+ * Vertices are welded through a spatial hash, so that the computation
+ * time is linear to the number of facets.
+ */
+__EXPORT void zSTLSetWeldTol(double tol);
+__EXPORT double zSTLWeldTol(void);
+
 /*! \brief read and write a 3D polyhedron in ASCII STL format. */
 __EXPORT zPH3D *zPH3DFReadSTL_ASCII(FILE *fp, zPH3D *ph, char name[], size_t namesize);
 __EXPORT void zPH3DFWriteSTL_ASCII(FILE *fp, zPH3D *ph, char name[]);
@@ -9,6 +9,7 @@
 
 #include <zeo/zeo_ep.h>
 #include <zeo/zeo_frame.h>
+#include <zeo/zeo_shape.h>
 
 __BEGIN_DECLS
 
@@ -27,6 +28,79 @@ __EXPORT bool zVec3DListReadPCDFile(zVec3DList *pc, char filename[]);
 
 #define ZEO_PCD_SUFFIX "pcd"
 
+/*! \brief write point cloud to PCD file.
+ *
+ * zVec3DArrayPCDFWrite() writes a point cloud given by an array \a p
+ * to a stream of PCD file \a fp. \a num is the number of points.
+ * Coordinates are written in binary format of single precision.
+ * zVec3DArrayWritePCDFile() writes a point cloud to a PCD file.
+ * \return
+ * zVec3DArrayPCDFWrite() and zVec3DArrayWritePCDFile() return the
+ * true value if they succeed to write the file, or the false value
+ * otherwise.
+ */
+__EXPORT bool zVec3DArrayPCDFWrite(FILE *fp, zVec3D p[], int num);
+__EXPORT bool zVec3DArrayWritePCDFile(zVec3D p[], int num, char filename[]);
+
+/*! \brief estimate normal vectors of a point cloud.
+ *
+ * zVec3DNormalEstimate() estimates normal vectors of a point cloud
+ * given by an array \a p. \a num is the number of points.
+ * The normal vector at each point is the principal axis with the
+ * least variance of the neighbor points within a radius \a r.
+ * The neighbors are found in a 3D vector tree \a tree, each node
+ * of which is labeled with the index of the point in \a p as
+ * zVecTree3DFromArray() does. If the null pointer is given for
+ * \a tree, a tree of \a p is internally created.
+ * The results are stored in \a norm, which has to have \a num
+ * vectors. The normal vector of a point with less than three
+ * neighbors is set for the zero vector.
+ * Note that the direction of each normal vector is not determined,
+ * namely, it could be either outward or inward.
+ * \return
+ * zVec3DNormalEstimate() returns a pointer \a norm, or the null
+ * pointer if it fails to allocate the internal tree.
+ */
+__EXPORT zVec3D *zVec3DNormalEstimate(zVec3D p[], int num, zVecTree3D *tree, double r, zVec3D norm[]);
+
+/*! \brief Euclidean clustering of a point cloud.
+ *
+ * zVec3DCluster() splits a point cloud given by an array \a p into
+ * clusters. \a num is the number of points. Two points belong to the
+ * same cluster if they are connected by a chain of points, each
+ * adjacent pair of which are within a distance \a r.
+ * The neighbors are found in a 3D vector tree \a tree labeled with
+ * the indices of the points as zVec3DNormalEstimate() requires. If
+ * the null pointer is given for \a tree, a tree of \a p is internally
+ * created.
+ * The result is stored in \a label, which has to have \a num
+ * integers. The clusters are labeled with 0, 1, ... in the order of
+ * their first points in \a p. Points of clusters with less than
+ * \a min_size points are labeled with -1 as outliers.
+ *
+ * zVec3DClusterAddrList() creates lists of addresses of points in the
+ * clusters from \a p and \a label labeled by zVec3DCluster(). \a nc
+ * is the number of clusters. Each list can be directly passed to
+ * zCH3DPL(), zOBBPL() and so forth to create a bounding volume of
+ * each cluster.
+ * The lists should be destroyed by zVec3DClusterAddrListDestroy().
+ * \return
+ * zVec3DCluster() returns the number of clusters, or -1 if it fails
+ * to allocate the internal workspace.
+ *
+ * zVec3DClusterAddrList() returns a pointer to the newly allocated
+ * array of \a nc lists, or the null pointer if it fails to allocate
+ * memory.
+ *
+ * zVec3DClusterAddrListDestroy() returns no value.
+ */
+__EXPORT int zVec3DCluster(zVec3D p[], int num, zVecTree3D *tree, double r, int min_size, int label[]);
+__EXPORT zVec3DAddrList *zVec3DClusterAddrList(zVec3D p[], int num, int label[], int nc);
+__EXPORT void zVec3DClusterAddrListDestroy(zVec3DAddrList *list, int nc);
+
 __END_DECLS
 
+#include <zeo/zeo_pointcloud_icp.h> /* iterative closest point */
+#include <zeo/zeo_pointcloud_ransac.h> /* RANSAC segmentation */
+
 #endif /* __ZEO_POINTCLOUD_H__ */
@@ -0,0 +1,106 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_pointcloud_icp - iterative closest point registration.
+ */
+
+#ifndef __ZEO_POINTCLOUD_ICP_H__
+#define __ZEO_POINTCLOUD_ICP_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* ********************************************************** */
+/*! \brief parameters of iterative closest point registration.
+ *
+ * zICPParam is a set of parameters for zICP() and zICPArray().
+ * \a metric chooses the error metric from the point-to-point
+ * distance (ZEO_ICP_POINT_TO_POINT) and the point-to-plane
+ * distance (ZEO_ICP_POINT_TO_PLANE).
+ * \a iter is the maximum number of iterations. If it is zero,
+ * Z_MAX_ITER_NUM is used instead.
+ * \a tol is the tolerance of the translation and the rotation
+ * angle of an update to judge the convergence.
+ * Correspondences farther than \a dist_max are rejected if
+ * \a dist_max is positive. In addition, the ratio \a trim of
+ * correspondences are rejected in descending order of the
+ * distance (trimmed ICP) if \a trim is in (0,1).
+ *//* ******************************************************* */
+typedef enum{
+  ZEO_ICP_POINT_TO_POINT = 0,
+  ZEO_ICP_POINT_TO_PLANE,
+} zICPMetric;
+
+typedef struct{
+  zICPMetric metric; /*!< error metric */
+  int iter;          /*!< maximum number of iterations */
+  double tol;        /*!< tolerance of an update */
+  double dist_max;   /*!< maximum distance of correspondences */
+  double trim;       /*!< ratio of correspondences to be rejected */
+} zICPParam;
+
+/*! \brief report of iterative closest point registration.
+ *
+ * zICPReport stores the result of zICP() and zICPArray().
+ * \a iter is the number of iterations, \a num is the number of
+ * correspondences accepted at the last iteration, \a rmse is the
+ * root mean square of the distances between the accepted pairs,
+ * and \a converged tells if the update converged within \a iter.
+ */
+typedef struct{
+  int iter;       /*!< number of iterations */
+  int num;        /*!< number of accepted correspondences */
+  double rmse;    /*!< root mean square error */
+  bool converged; /*!< convergence flag */
+} zICPReport;
+
+/*! \brief initialize parameters of iterative closest point registration.
+ *
+ * zICPParamInit() sets default values of parameters \a param,
+ * namely, point-to-point metric, Z_MAX_ITER_NUM iterations,
+ * tolerance zTOL and no rejection of correspondences.
+ * \return
+ * zICPParamInit() returns a pointer \a param.
+ */
+__EXPORT zICPParam *zICPParamInit(zICPParam *param);
+
+/*! \brief iterative closest point registration.
+ *
+ * zICP() finds a frame \a f that aligns a set of points \a src to
+ * another set of points stored in a 3D vector tree \a tree by the
+ * iterative closest point (ICP) method. \a srcnum is the number
+ * of points in \a src.
+ * \a f has to be given as an initial guess, and is updated to the
+ * frame that transforms \a src to the frame of \a tree.
+ * The tree is searched for the correspondence of each point at
+ * every iteration, and then the update is computed in closed-form.
+ * The point-to-point metric is solved with the unit quaternion
+ * that maximizes the correlation of the correspondences (Horn's
+ * method). The point-to-plane metric is solved from the linearized
+ * normal equation about the small rotation and translation, for
+ * which the normal vectors of the points in the tree are given by
+ * \a norm. Each node of \a tree has to be labeled with the index of
+ * the corresponding normal vector in \a norm as zVecTree3DFromArray()
+ * does. \a norm is ignored for the point-to-point metric.
+ *
+ * zICPArray() does the same with zICP() for a set of target points
+ * given by an array \a dest. \a destnum is the number of points in
+ * \a dest. A balanced tree of \a dest is internally created.
+ *
+ * \a param is a set of parameters (see zICPParam). If the null
+ * pointer is given for \a param, the default parameters are used.
+ * The result is reported to \a report unless it is the null
+ * pointer.
+ * \return
+ * zICP() and zICPArray() return a pointer \a f, or the null pointer
+ * if too few correspondences are accepted to determine the frame,
+ * the point-to-plane metric is chosen without normal vectors, or
+ * they fail to allocate memory for internal workspaces.
+ */
+__EXPORT zFrame3D *zICP(zVec3D src[], int srcnum, zVecTree3D *tree, zVec3D norm[], zICPParam *param, zFrame3D *f, zICPReport *report);
+__EXPORT zFrame3D *zICPArray(zVec3D src[], int srcnum, zVec3D dest[], int destnum, zVec3D norm[], zICPParam *param, zFrame3D *f, zICPReport *report);
+
+__END_DECLS
+
+#endif /* __ZEO_POINTCLOUD_ICP_H__ */
@@ -0,0 +1,123 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_pointcloud_ransac - RANSAC segmentation of point clouds.
+ */
+
+#ifndef __ZEO_POINTCLOUD_RANSAC_H__
+#define __ZEO_POINTCLOUD_RANSAC_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/* types of primitives to be segmented */
+#define ZEO_RANSAC_PLANE  0x1
+#define ZEO_RANSAC_SPHERE 0x2
+#define ZEO_RANSAC_CYL    0x4
+#define ZEO_RANSAC_ALL    ( ZEO_RANSAC_PLANE | ZEO_RANSAC_SPHERE | ZEO_RANSAC_CYL )
+
+/* ********************************************************** */
+/*! \brief parameters of RANSAC segmentation.
+ *
+ * zRANSACParam is a set of parameters for zRANSACSegment().
+ * \a type is a combination of ZEO_RANSAC_PLANE, ZEO_RANSAC_SPHERE
+ * and ZEO_RANSAC_CYL to choose types of primitives to be extracted.
+ * A point is an inlier of a primitive if the distance between them
+ * is less than \a tol. If normal vectors of the points are given
+ * or estimated and \a angle is positive, the angle between the
+ * normal vector of an inlier and that of the primitive also has to
+ * be less than \a angle. Points with the zero normal vector are
+ * exempted from the latter condition.
+ * Hypotheses of a primitive are sampled until one of them is found
+ * with a probability \a prob at least or \a iter hypotheses are
+ * tested.
+ * A primitive with less than \a min_inlier inliers is discarded,
+ * and the segmentation terminates then. At most \a max_prim
+ * primitives are extracted if it is positive.
+ * \a radius is the radius of neighbors to estimate normal vectors,
+ * which are required for cylinders.
+ *//* ******************************************************* */
+typedef struct{
+  ubyte type;     /*!< types of primitives */
+  double tol;     /*!< distance tolerance of inliers */
+  double angle;   /*!< angle tolerance of normal vectors of inliers */
+  double prob;    /*!< probability to find the best hypothesis */
+  int iter;       /*!< maximum number of hypotheses for a primitive */
+  int min_inlier; /*!< minimum number of inliers of a primitive */
+  int max_prim;   /*!< maximum number of primitives */
+  double radius;  /*!< radius of neighbors to estimate normal vectors */
+} zRANSACParam;
+
+/*! \brief initialize parameters of RANSAC segmentation.
+ *
+ * zRANSACParamInit() sets default values of parameters \a param,
+ * namely, all types of primitives, tolerance 0.01, angle tolerance
+ * 20 degrees, probability 0.99, Z_MAX_ITER_NUM hypotheses, 100
+ * inliers at least, no limit of the number of primitives, and the
+ * radius of neighbors five times as large as the tolerance.
+ * \return
+ * zRANSACParamInit() returns a pointer \a param.
+ */
+__EXPORT zRANSACParam *zRANSACParamInit(zRANSACParam *param);
+
+/* ********************************************************** */
+/*! \brief primitive segmented by RANSAC.
+ *
+ * zRANSACPrim is a primitive segmented from a point cloud.
+ * \a type is either of ZEO_RANSAC_PLANE, ZEO_RANSAC_SPHERE and
+ * ZEO_RANSAC_CYL, and the corresponding member of \a plane,
+ * \a sphere and \a cyl is valid. The vertex of \a plane refers
+ * to \a org, so that the primitive should not be copied by value.
+ * Both ends of \a cyl are at the extremes of the inliers.
+ * \a inlier is an array of flags that tells which points of the
+ * original cloud are inliers, and \a num is the number of them.
+ *//* ******************************************************* */
+typedef struct{
+  ubyte type;       /*!< type of primitive */
+  zVec3D org;       /*!< a point on the plane */
+  zPlane3D plane;   /*!< plane */
+  zSphere3D sphere; /*!< sphere */
+  zCyl3D cyl;       /*!< cylinder */
+  int num;          /*!< number of inliers */
+  bool *inlier;     /*!< inlier mask */
+} zRANSACPrim;
+
+zListClass( zRANSACPrimList, zRANSACPrimListCell, zRANSACPrim );
+
+/*! \brief segment primitives from a point cloud by RANSAC.
+ *
+ * zRANSACSegment() extracts planes, spheres and cylinders from a
+ * point cloud given by an array \a p one after another by RANSAC
+ * (random sample consensus). \a num is the number of points.
+ * Each hypothesis is sampled from the points which are not inliers
+ * of the primitives already extracted, and scored by the number of
+ * its inliers. The scoring is terminated as soon as the hypothesis
+ * turns out not to beat the best one, and the sampling is terminated
+ * as soon as the best one is found with the probability given by
+ * \a param (see zRANSACParam).
+ * The best hypothesis is then refitted to its inliers by the least
+ * square method.
+ * \a norm is an array of normal vectors of the points. If the null
+ * pointer is given for \a norm, the normal vectors are estimated by
+ * zVec3DNormalEstimate() if they are needed for cylinders. Samples
+ * of cylinders on points with unknown (zero) normal vectors, including
+ * those for which the estimation fails, are skipped.
+ * If the null pointer is given for \a param, the default parameters
+ * are used.
+ * The extracted primitives are put into a list \a list in order
+ * of extraction. If \a num is zero, \a list is left empty.
+ *
+ * zRANSACPrimListDestroy() destroys a list of primitives \a list.
+ * \return
+ * zRANSACSegment() returns a pointer \a list, or the null pointer if
+ * it fails to allocate memory for the internal workspace.
+ *
+ * zRANSACPrimListDestroy() returns no value.
+ */
+__EXPORT zRANSACPrimList *zRANSACSegment(zRANSACPrimList *list, zVec3D p[], int num, zVec3D norm[], zRANSACParam *param);
+__EXPORT void zRANSACPrimListDestroy(zRANSACPrimList *list);
+
+__END_DECLS
+
+#endif /* __ZEO_POINTCLOUD_RANSAC_H__ */
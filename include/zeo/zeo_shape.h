@@ -27,6 +27,7 @@ typedef struct{
   double (*_closest)(void*,zVec3D*,zVec3D*);
   double (*_pointdist)(void*,zVec3D*);
   bool (*_pointisinside)(void*,zVec3D*,bool);
+  bool (*_raycast)(void*,zRay3D*,double*,zVec3D*);
   double (*_volume)(void*);
   zVec3D *(*_barycenter)(void*,zVec3D*);
   zMat3D *(*_inertia)(void*,zMat3D*);
@@ -48,6 +49,7 @@ typedef struct{
   zOpticalInfo *optic;
   zTexture *texture;
   zShape3DCom *com; /* methods */
+  struct _zShape3DBV *bv; /* cached bounding volumes (see zeo_bv_shape.h) */
 } zShape3D;
 
 #define zShape3DOptic(s)        (s)->optic
@@ -73,6 +75,24 @@ __EXPORT zShape3D *zShape3DQueryAssign(zShape3D *shape, char *str);
  */
 __EXPORT void zShape3DDestroy(zShape3D *shape);
 
+/*! \brief invalidate and destroy cached bounding volumes of a 3D shape.
+ *
+ * zShape3DBVInvalidate() invalidates bounding volumes of a 3D shape
+ * \a shape cached by zShape3DAABB(), zShape3DOBB(), zShape3DBBall()
+ * and zShape3DCH(), so that they are recomputed when requested next.
+ * It is automatically called when \a shape is transformed by
+ * zShape3DXform() or zShape3DXformInv(), converted by zShape3DToPH()
+ * or re-assigned by zShape3DQueryAssign(). It has to be called by
+ * the user program if the body of \a shape is directly modified.
+ *
+ * zShape3DBVDestroy() frees the cache of \a shape. It is called in
+ * zShape3DDestroy().
+ * \return
+ * zShape3DBVInvalidate() and zShape3DBVDestroy() return no value.
+ */
+__EXPORT void zShape3DBVInvalidate(zShape3D *shape);
+__EXPORT void zShape3DBVDestroy(zShape3D *shape);
+
 __EXPORT zShape3D *zShape3DClone(zShape3D *org, zShape3D *cln, zOpticalInfo *oi);
 __EXPORT zShape3D *zShape3DMirror(zShape3D *src, zShape3D *dest, zAxis axis);
 
@@ -108,6 +128,26 @@ __EXPORT double zShape3DClosest(zShape3D *shape, zVec3D *p, zVec3D *cp);
 __EXPORT double zShape3DPointDist(zShape3D *shape, zVec3D *p);
 __EXPORT bool zShape3DPointIsInside(zShape3D *shape, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and a shape.
+ *
+ * zShape3DRaycast() finds the nearest intersection of a ray \a ray
+ * and a 3D shape \a shape. On input, \a t is the maximum distance
+ * of the intersection to be found. If the ray hits the surface of
+ * \a shape at a distance less than \a t, the distance is stored in
+ * \a t, and the outward normal vector of \a shape at the
+ * intersection is stored in \a norm unless \a norm is the null
+ * pointer. If the origin of \a ray is inside of \a shape, the exit
+ * point is found.
+ * NURBS surfaces are not supported, for which the ray never hits.
+ * \return
+ * zShape3DRaycast() returns the true value if \a ray hits \a shape
+ * within \a t. Otherwise, the false value is returned and neither
+ * \a t nor \a norm are modified.
+ * \sa
+ * zPlane3DRaycast, zTri3DRaycast
+ */
+__EXPORT bool zShape3DRaycast(zShape3D *shape, zRay3D *ray, double *t, zVec3D *norm);
+
 __EXPORT zShape3D *zShape3DToPH(zShape3D *shape);
 
 /*! \brief read a shape from a STL file. */
@@ -97,6 +97,9 @@ __EXPORT double zBox3DClosest(zBox3D *box, zVec3D *p, zVec3D *cp);
 __EXPORT double zBox3DPointDist(zBox3D *box, zVec3D *p);
 __EXPORT bool zBox3DPointIsInside(zBox3D *box, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and a 3D box (see zShape3DRaycast()). */
+__EXPORT bool zBox3DRaycast(zBox3D *box, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief volume and inertia of a box.
  *
  * zBox3DVolume() calculates the volume of a box \a box.
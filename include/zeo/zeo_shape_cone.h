@@ -77,6 +77,9 @@ __EXPORT double zCone3DClosest(zCone3D *cone, zVec3D *p, zVec3D *cp);
 __EXPORT double zCone3DPointDist(zCone3D *cone, zVec3D *p);
 __EXPORT bool zCone3DPointIsInside(zCone3D *cone, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and a 3D cone (see zShape3DRaycast()). */
+__EXPORT bool zCone3DRaycast(zCone3D *cone, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief axis vector, height and volume of 3D cone.
  *
  * zCone3DAxis() calculates the axis vector of a 3D cone \a cone; the axis
@@ -77,6 +77,9 @@ __EXPORT double zCyl3DClosest(zCyl3D *cyl, zVec3D *p, zVec3D *cp);
 __EXPORT double zCyl3DPointDist(zCyl3D *cyl, zVec3D *p);
 __EXPORT bool zCyl3DPointIsInside(zCyl3D *cyl, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and a 3D cylinder (see zShape3DRaycast()). */
+__EXPORT bool zCyl3DRaycast(zCyl3D *cyl, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief axis vector, height and volume of a 3D cylinder.
  *
  * zCyl3DAxis() calculates the axis vector of a 3D cylinder \a cyl;
@@ -58,6 +58,8 @@ __EXPORT double zECyl3DClosest(zECyl3D *cyl, zVec3D *p, zVec3D *cp);
 __EXPORT double zECyl3DPointDist(zECyl3D *cyl, zVec3D *p);
 /*! \brief check if a point is inside of an elliptic cylinder. */
 __EXPORT bool zECyl3DPointIsInside(zECyl3D *cyl, zVec3D *p, bool rim);
+/*! \brief intersection of a ray and a 3D elliptic cylinder (see zShape3DRaycast()). */
+__EXPORT bool zECyl3DRaycast(zECyl3D *cyl, zRay3D *ray, double *t, zVec3D *norm);
 
 #define zECyl3DAxis(c,a) \
   zVec3DSub( zECyl3DCenter(c,1), zECyl3DCenter(c,0), a )
@@ -103,6 +103,9 @@ __EXPORT double zEllips3DClosest(zEllips3D *ellips, zVec3D *p, zVec3D *cp);
 __EXPORT double zEllips3DPointDist(zEllips3D *ellips, zVec3D *p);
 __EXPORT bool zEllips3DPointIsInside(zEllips3D *ellips, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and a 3D ellipsoid (see zShape3DRaycast()). */
+__EXPORT bool zEllips3DRaycast(zEllips3D *ellips, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief calculate volume and inertia of a 3D ellipsoid.
  *
  * zEllips3DVolume() calculates the volume of a 3D ellipsoid
@@ -92,6 +92,9 @@ __EXPORT double zSphere3DClosest(zSphere3D *sphere, zVec3D *p, zVec3D *cp);
 __EXPORT double zSphere3DPointDist(zSphere3D *sphere, zVec3D *p);
 __EXPORT bool zSphere3DPointIsInside(zSphere3D *sphere, zVec3D *p, bool rim);
 
+/*! \brief intersection of a ray and a 3D sphere (see zShape3DRaycast()). */
+__EXPORT bool zSphere3DRaycast(zSphere3D *sphere, zRay3D *ray, double *t, zVec3D *norm);
+
 /*! \brief volume and inertia of a 3D sphere.
  *
  * zSphere3DVolume() calculates the volume of a 3D sphere \a sphere.
@@ -125,10 +128,18 @@ __EXPORT zPH3D *zSphere3DToPH(zSphere3D *sphere, zPH3D *ph);
  *
  * zSphere3DFit() fits a sphere to given point cloud \a pc. The result
  * is stored in \a s.
+ * zSphere3DFitArray() does the same with zSphere3DFit() for an array
+ * of points \a v. \a n is the number of points.
+ *
+ * Both functions iterate Gauss-Newton steps of the least square
+ * method, each of which accumulates the 4x4 normal equation point by
+ * point, so that the memory consumption does not depend on the size
+ * of the point cloud.
  * \return
  * The pointer \a s is returned.
  */
 __EXPORT zSphere3D *zSphere3DFit(zSphere3D *s, zVec3DList *pc);
+__EXPORT zSphere3D *zSphere3DFitArray(zSphere3D *s, zVec3D v[], int n);
 
 /* methods for abstraction */
 extern zShape3DCom zeo_shape3d_sphere_com;
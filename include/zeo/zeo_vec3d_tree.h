@@ -19,6 +19,8 @@ __BEGIN_DECLS
  * It is particularly utilized for the nearest neighbor search.
  * Initialize a tree by zVecTree3DInit() and then incrementally
  * add 3D vectors by zVecTree3DAdd().
+ * A tree can also be built at once from an array of 3D vectors
+ * by zVecTree3DFromArray(), which balances the branches.
  * The nearest neighbor to a vector in the tree is found by
  * zVecTree3DNN().
  * The tree is freed by calling zVecTree3DDestroy().
@@ -26,6 +28,7 @@ __BEGIN_DECLS
 typedef struct _zVecTree3D{
   zAxis split;   /*!< split axis index */
   zVec3D v;      /*!< spliting vertex */
+  int id;        /*!< identifier of the vertex */
   zVec3D vmin;   /*!< minimum corner of bounding box */
   zVec3D vmax;   /*!< maximum corner of bounding box */
   struct _zVecTree3D *s[2]; /*!< binary branches */
@@ -50,8 +53,33 @@ __EXPORT void zVecTree3DDestroy(zVecTree3D *tree);
  *
  * zVecTree3DAdd() adds a newly given 3D vector \a v to a tree
  * \a tree.
+ *
+ * zVecTree3DAddID() does the same with zVecTree3DAdd() and also
+ * labels the new node with an identifier \a id. It is useful to
+ * refer the original index of the vector in an array.
+ * zVecTree3DAdd() labels the node with -1.
+ * \return
+ * zVecTree3DAdd() and zVecTree3DAddID() return a pointer to the
+ * newly added node. If it fails to allocate memory, the null
+ * pointer is returned.
  */
 __EXPORT zVecTree3D *zVecTree3DAdd(zVecTree3D *tree, zVec3D *v);
+__EXPORT zVecTree3D *zVecTree3DAddID(zVecTree3D *tree, zVec3D *v, int id);
+
+/*! \brief create a balanced 3D vector tree from an array.
+ *
+ * zVecTree3DFromArray() creates a 3D vector tree \a tree from an
+ * array of 3D vectors \a v. \a num is the number of vectors.
+ * The vectors are added in the order of medians along the split
+ * axes, so that the tree is balanced even if the vectors are
+ * ordered as a scan line.
+ * Each node is labeled with the index of the vector in \a v.
+ * \a tree is initialized inside of this function.
+ * \return
+ * zVecTree3DFromArray() returns a pointer \a tree, or the null
+ * pointer if it fails to allocate memory.
+ */
+__EXPORT zVecTree3D *zVecTree3DFromArray(zVecTree3D *tree, zVec3D v[], int num);
 
 /*! \brief find the partition in which a 3D vector is contained.
  *
@@ -71,6 +99,17 @@ __EXPORT zVecTree3D *zVecTree3DPart(zVecTree3D *tree, zVec3D *v);
  */
 __EXPORT double zVecTree3DNN(zVecTree3D *tree, zVec3D *v, zVecTree3D **nn);
 
+/*! \brief find vectors in a tree within a radius from a 3D vector.
+ *
+ * zVecTree3DRange() finds all nodes in a tree \a tree whose vectors
+ * are within a distance \a r from a given 3D vector \a v. For each
+ * node found, a function \a f is called with the node and an
+ * arbitrary pointer \a util given by the user.
+ * \return
+ * zVecTree3DRange() returns the number of nodes found.
+ */
+__EXPORT int zVecTree3DRange(zVecTree3D *tree, zVec3D *v, double r, void (* f)(zVecTree3D*,void*), void *util);
+
 __END_DECLS
 
 #endif /* __ZEO_VEC3D_TREE_H__ */
@@ -61,6 +61,40 @@ bool zAABox3DPointIsInside(zAABox3D *box, zVec3D *p, bool rim)
     true : false;
 }
 
+/* intersection of a ray and an axis-aligned box. */
+bool zAABox3DRaycast(zAABox3D *box, zRay3D *ray, double *t, zVec3D *norm)
+{
+  double t1, t2, tmin = -HUGE_VAL, tmax = HUGE_VAL;
+  zDir i, imin = zX, imax = zX;
+  double sgn = -1;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( zIsTiny( zRay3DDir(ray)->e[i] ) ){ /* parallel to the slab */
+      if( zRay3DOrg(ray)->e[i] < box->min.e[i] || zRay3DOrg(ray)->e[i] > box->max.e[i] ) return false;
+      continue;
+    }
+    t1 = ( box->min.e[i] - zRay3DOrg(ray)->e[i] ) * zRay3DIDir(ray)->e[i];
+    t2 = ( box->max.e[i] - zRay3DOrg(ray)->e[i] ) * zRay3DIDir(ray)->e[i];
+    if( t1 > t2 ) zSwap( double, t1, t2 );
+    if( t1 > tmin ){ tmin = t1; imin = i; }
+    if( t2 < tmax ){ tmax = t2; imax = i; }
+    if( tmin > tmax ) return false;
+  }
+  if( tmin < 0 ){ /* exiting from inside */
+    tmin = tmax;
+    imin = imax;
+    sgn = 1;
+    if( tmin < 0 ) return false;
+  }
+  if( tmin >= *t ) return false;
+  *t = tmin;
+  if( norm ){
+    zVec3DZero( norm );
+    norm->e[imin] = zRay3DDir(ray)->e[imin] > 0 ? sgn : -sgn;
+  }
+  return true;
+}
+
 /* compute volume of an axis-aligned box. */
 double zAABox3DVolume(zAABox3D *box)
 {
@@ -80,15 +114,41 @@ zBox3D *zAABox3DToBox3D(zAABox3D *aab, zBox3D *box)
   return box;
 }
 
+/* axis-aligned box of a box with the center, the attitude and the half-lengths of edges. */
+static zAABox3D *_zAABox3DFromBox(zAABox3D *aabox, zVec3D *c, zMat3D *att, zVec3D *e)
+{
+  double r;
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    r = fabs( att->v[0].e[i] ) * e->e[zX]
+      + fabs( att->v[1].e[i] ) * e->e[zY]
+      + fabs( att->v[2].e[i] ) * e->e[zZ];
+    aabox->min.e[i] = c->e[i] - r;
+    aabox->max.e[i] = c->e[i] + r;
+  }
+  return aabox;
+}
+
 /* compute an axis-aligned box of a 3D box. */
 zAABox3D *zBox3DToAABox3D(zBox3D *box, zAABox3D *aabox)
 {
-  zVec3D v[8];
-  register int i;
+  zVec3D e;
+
+  zVec3DMul( &box->dia, 0.5, &e );
+  return _zAABox3DFromBox( aabox, zBox3DCenter(box), zFrame3DAtt(&box->f), &e );
+}
+
+/* axis-aligned box of an axis-aligned box transformed by a frame. */
+zAABox3D *zAABox3DXform(zAABox3D *src, zFrame3D *f, zAABox3D *dst)
+{
+  zVec3D c, e;
 
-  for( i=0; i<8; i++ )
-    zBox3DVert( box, i, &v[i] );
-  return zAABB( aabox, v, 8, NULL );
+  zVec3DMid( &src->max, &src->min, &e );
+  zXform3D( f, &e, &c );
+  zVec3DSub( &src->max, &src->min, &e );
+  zVec3DMulDRC( &e, 0.5 );
+  return _zAABox3DFromBox( dst, &c, zFrame3DAtt(f), &e );
 }
 
 /* print an axis-aligned box out to a file in a format to be plotted. */
@@ -239,8 +299,8 @@ zAABox3D *zAABBPL(zAABox3D *bb, zVec3DList *pl, zVec3DListCell **vp)
   if( zListIsEmpty(pl) ) return NULL;
 
   pc = zListTail( pl );
-  memcpy( &bb->min, &pc->data, sizeof(zVec3D) );
-  memcpy( &bb->max, &pc->data, sizeof(zVec3D) );
+  memcpy( &bb->min, pc->data, sizeof(zVec3D) );
+  memcpy( &bb->max, pc->data, sizeof(zVec3D) );
   if( vp ) vp[0] = vp[1] = vp[2] = vp[3] = vp[4] = vp[5] = pc;
   zListForEach( pl, pc )
     _zAABBPLInc( bb, pc, vp );
@@ -258,11 +318,58 @@ zAABox3D *zAABBXformPL(zAABox3D *bb, zVec3DList *pl, zFrame3D *f)
 
   pc = zListTail( pl );
   zXform3D( f, pc->data, &px );
-  memcpy( &bb->min, pc->data, sizeof(zVec3D) );
-  memcpy( &bb->max, pc->data, sizeof(zVec3D) );
+  zVec3DCopy( &px, &bb->min );
+  zVec3DCopy( &px, &bb->max );
   zListForEach( pl, pc ){
     zXform3D( f, pc->data, &px );
     _zAABBInc( bb, &px, NULL );
   }
   return bb;
 }
+
+/* ********************************************************** */
+/* cache of axis-aligned bounding box in a local frame
+ * ********************************************************** */
+
+/* initialize a cache of axis-aligned bounding box. */
+static zAABBCache *_zAABBCacheInit(zAABBCache *cache)
+{
+  zAABox3DInit( &cache->box );
+  zPH3DInit( &cache->hull );
+  return cache;
+}
+
+/* create a cache of axis-aligned bounding box of points. */
+zAABBCache *zAABBCacheCreate(zAABBCache *cache, zVec3D p[], int num, bool tight)
+{
+  _zAABBCacheInit( cache );
+  if( !zAABB( &cache->box, p, num, NULL ) ) return NULL;
+  if( tight && !zCH3D( &cache->hull, p, num ) )
+    zPH3DInit( &cache->hull ); /* fall back to the box */
+  return cache;
+}
+
+/* create a cache of axis-aligned bounding box of a list of points. */
+zAABBCache *zAABBCacheCreatePL(zAABBCache *cache, zVec3DList *pl, bool tight)
+{
+  _zAABBCacheInit( cache );
+  if( !zAABBPL( &cache->box, pl, NULL ) ) return NULL;
+  if( tight && !zCH3DPL( &cache->hull, pl ) )
+    zPH3DInit( &cache->hull ); /* fall back to the box */
+  return cache;
+}
+
+/* destroy a cache of axis-aligned bounding box. */
+void zAABBCacheDestroy(zAABBCache *cache)
+{
+  zPH3DDestroy( &cache->hull );
+  zAABox3DInit( &cache->box );
+}
+
+/* axis-aligned bounding box of cached points transformed by a frame. */
+zAABox3D *zAABBCacheXform(zAABBCache *cache, zFrame3D *f, zAABox3D *bb)
+{
+  if( zPH3DVertNum(&cache->hull) > 0 )
+    return zAABBXform( bb, zPH3DVertBuf(&cache->hull), zPH3DVertNum(&cache->hull), f );
+  return zAABox3DXform( &cache->box, f, bb );
+}
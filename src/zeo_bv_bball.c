@@ -79,32 +79,29 @@ static int _zBBall4(zSphere3D *bb, zVec3D *v[], zVec3D **vp)
 }
 
 /* bounding ball of up to four points. */
-static int _zBBallPrim(zSphere3D *bb, zVec3DList *p, zVec3D **vp)
+static int _zBBallPrim(zSphere3D *bb, zVec3D *v[], int n, zVec3D **vp)
 {
-  zVec3D c, *v[4];
+  zVec3D c, *w[4];
 
-  switch( zListSize(p) ){
+  switch( n ){
   case 0:
     zSphere3DCreate( bb, ZVEC3DZERO, -1, 0 ); /* vague */
     return 0;
   case 1:
-    zSphere3DCreate( bb, zListHead(p)->data, 0, 0 );
-    if( vp ) vp[0] = zListHead(p)->data;
+    zSphere3DCreate( bb, v[0], 0, 0 );
+    if( vp ) vp[0] = v[0];
     return 1;
   case 2:
-    zVec3DMid( zListHead(p)->data, zListTail(p)->data, &c );
-    zSphere3DCreate( bb, &c, zVec3DDist(zListTail(p)->data,&c)+zTOL, 0 );
+    zVec3DMid( v[0], v[1], &c );
+    zSphere3DCreate( bb, &c, zVec3DDist(v[1],&c)+zTOL, 0 );
     if( vp ){
-      vp[0] = zListHead(p)->data;
-      vp[1] = zListTail(p)->data;
+      vp[0] = v[0]; vp[1] = v[1];
     }
     return 2;
   case 3:
+    w[0] = v[0]; w[1] = v[1]; w[2] = w[3] = v[2];
+    return _zBBall4( bb, w, vp );
   case 4:
-    v[0] = zListTail(p)->data;
-    v[1] = zListCellNext(zListTail(p))->data;
-    v[2] = zListCellNext(zListCellNext(zListTail(p)))->data;
-    v[3] = zListHead(p)->data;
     return _zBBall4( bb, v, vp );
   default:
     ZRUNERROR( ZEO_ERR_FATAL );
@@ -112,54 +109,174 @@ static int _zBBallPrim(zSphere3D *bb, zVec3DList *p, zVec3D **vp)
   return 0;
 }
 
-/* a recursive procedure to find bounding ball of two sets of points,
- * where the latter is the set of those on the surface of the ball. */
-static int _zBBallInc(zSphere3D *bb, zVec3DList *p, zVec3DList *shell, zVec3D **vp)
+/* move-to-front procedure to find bounding ball of the first n points
+ * of an array and points in the support set, which are to be on the
+ * surface of the ball (B. Gaertner, 1999). */
+static int _zBBallMTF(zSphere3D *bb, zVec3D **p, int n, zVec3D *support[], int ns, zVec3D **vp)
 {
-  zVec3DListCell *cp;
+  zVec3D *v;
   int num;
+  register int i, j;
 
-  if( zListIsEmpty(p) || zListSize(shell) == 4 )
-    return _zBBallPrim( bb, shell, vp );
-  zListDeleteTail( p, &cp );
-  num = _zBBallInc( bb, p, shell, vp );
-  if( !zSphere3DPointIsInside( bb, cp->data, true ) ){
-    zListInsertTail( shell, cp );
-    num = _zBBallInc( bb, p, shell, vp );
-    zListPurge( shell, cp );
+  num = _zBBallPrim( bb, support, ns, vp );
+  if( ns == 4 ) return num;
+  for( i=0; i<n; i++ ){
+    if( zSphere3DPointIsInside( bb, p[i], true ) ) continue;
+    support[ns] = p[i];
+    num = _zBBallMTF( bb, p, i, support, ns+1, vp );
+    /* move the violating point to the front */
+    for( v=p[i], j=i; j>0; j-- ) p[j] = p[j-1];
+    p[0] = v;
   }
-  zListInsertTail( p, cp );
   return num;
 }
 
-/* a recursive procedure to find bounding ball of a set of 3D points. */
+/* seed of the pseudo-random shuffle of points */
+#define ZEO_BBALL_SEED 2463534242UL
+
+/* xorshift pseudo-random number generator (G. Marsaglia, 2003). */
+static unsigned long _zBBallRand(unsigned long *s)
+{
+  *s ^= ( *s << 13 ) & 0xffffffffUL;
+  *s ^= *s >> 17;
+  *s ^= ( *s << 5 ) & 0xffffffffUL;
+  return *s;
+}
+
+/* bounding ball of 3D points given by an array of pointers. */
+static int _zBBall(zSphere3D *bb, zVec3D **p, int num, zVec3D **vp)
+{
+  zVec3D *support[4], *v;
+  unsigned long s = ZEO_BBALL_SEED;
+  register int i, j;
+
+  /* shuffle to avoid the worst case. a local generator with a fixed
+     seed is used so that the result is reproducible and the global
+     random number generator is not disturbed. */
+  for( i=num-1; i>0; i-- ){
+    j = _zBBallRand( &s ) % ( i + 1 );
+    v = p[i]; p[i] = p[j]; p[j] = v;
+  }
+  return _zBBallMTF( bb, p, num, support, 0, vp );
+}
+
+/* bounding ball of a list of 3D points. */
 int zBBallPL(zSphere3D *bb, zVec3DList *p, zVec3D **vp)
 {
-  zVec3DList shell;
+  zVec3D **pp;
   zVec3DListCell *cp;
-  int num;
+  int num = 0;
 
-  zListInit( &shell );
-  if( zListSize(p) <= 4 )
-    return _zBBallPrim( bb, p, vp );
-  zListDeleteTail( p, &cp );
-  num = zBBallPL( bb, p, vp );
-  if( !zSphere3DPointIsInside( bb, cp->data, true ) ){
-    zListInsertTail( &shell, cp );
-    num = _zBBallInc( bb, p, &shell, vp );
-    zListPurge( &shell, cp );
+  if( zListIsEmpty(p) ) return _zBBallPrim( bb, NULL, 0, vp );
+  if( !( pp = zAlloc( zVec3D*, zListSize(p) ) ) ){
+    ZALLOCERROR();
+    return 0;
   }
-  zListInsertTail( p, cp );
+  zListForEach( p, cp ) pp[num++] = cp->data;
+  num = _zBBall( bb, pp, num, vp );
+  zFree( pp );
   return num;
 }
 
 /* bounding ball of 3D points. */
 int zBBall(zSphere3D *bb, zVec3D p[], int num, zVec3D **vp)
 {
-  zVec3DAddrList pl;
+  zVec3D **pp;
+  register int i;
 
-  if( !zVec3DAddrListFromArray( &pl, p, num ) ) return 0;
-  num = zBBallPL( bb, &pl, vp );
-  zVec3DAddrListDestroy( &pl );
+  if( num <= 0 ) return _zBBallPrim( bb, NULL, 0, vp );
+  if( !( pp = zAlloc( zVec3D*, num ) ) ){
+    ZALLOCERROR();
+    return 0;
+  }
+  for( i=0; i<num; i++ ) pp[i] = &p[i];
+  num = _zBBall( bb, pp, num, vp );
+  zFree( pp );
   return num;
 }
+
+/* ********************************************************** */
+/* approximate bounding ball
+ * ********************************************************** */
+
+/* update extreme points along the axes. */
+static void _zBBallFastExtreme(zVec3D *p, zVec3D *vmin[], zVec3D *vmax[])
+{
+  register int j;
+
+  for( j=0; j<3; j++ ){
+    if( p->e[j] < vmin[j]->e[j] ) vmin[j] = p;
+    if( p->e[j] > vmax[j]->e[j] ) vmax[j] = p;
+  }
+}
+
+/* initial ball on the most distant pair of extreme points. */
+static double _zBBallFastInit(zSphere3D *bb, zVec3D *vmin[], zVec3D *vmax[])
+{
+  double l, l_max = -1;
+  register int j, k = 0;
+
+  for( j=0; j<3; j++ )
+    if( ( l = zVec3DSqrDist( vmin[j], vmax[j] ) ) > l_max ){
+      l_max = l; k = j;
+    }
+  zVec3DMid( vmin[k], vmax[k], zSphere3DCenter(bb) );
+  return 0.5 * sqrt( l_max );
+}
+
+/* grow a ball to include a point. */
+static double _zBBallFastGrow(zSphere3D *bb, double r, zVec3D *p)
+{
+  zVec3D d;
+  double l;
+
+  _zVec3DSub( p, zSphere3DCenter(bb), &d );
+  if( ( l = _zVec3DSqrNorm( &d ) ) <= r*r ) return r;
+  l = sqrt( l );
+  zVec3DCatDRC( zSphere3DCenter(bb), 0.5*(l-r)/l, &d );
+  return 0.5 * ( l + r );
+}
+
+/* approximate bounding ball of 3D points (J. Ritter, 1990). */
+zSphere3D *zBBallFast(zSphere3D *bb, zVec3D p[], int num)
+{
+  zVec3D *vmin[3], *vmax[3];
+  double r;
+  register int i;
+
+  if( num <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  vmin[0] = vmin[1] = vmin[2] = vmax[0] = vmax[1] = vmax[2] = &p[0];
+  for( i=1; i<num; i++ )
+    _zBBallFastExtreme( &p[i], vmin, vmax );
+  r = _zBBallFastInit( bb, vmin, vmax );
+  for( i=0; i<num; i++ )
+    r = _zBBallFastGrow( bb, r, &p[i] );
+  zSphere3DSetRadius( bb, r+zTOL );
+  zSphere3DSetDiv( bb, ZEO_SHAPE_DEFAULT_DIV );
+  return bb;
+}
+
+/* approximate bounding ball of a list of 3D points. */
+zSphere3D *zBBallFastPL(zSphere3D *bb, zVec3DList *pl)
+{
+  zVec3D *vmin[3], *vmax[3];
+  zVec3DListCell *cp;
+  double r;
+
+  if( zListIsEmpty( pl ) ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  vmin[0] = vmin[1] = vmin[2] = vmax[0] = vmax[1] = vmax[2] = zListTail(pl)->data;
+  zListForEach( pl, cp )
+    _zBBallFastExtreme( cp->data, vmin, vmax );
+  r = _zBBallFastInit( bb, vmin, vmax );
+  zListForEach( pl, cp )
+    r = _zBBallFastGrow( bb, r, cp->data );
+  zSphere3DSetRadius( bb, r+zTOL );
+  zSphere3DSetDiv( bb, ZEO_SHAPE_DEFAULT_DIV );
+  return bb;
+}
@@ -0,0 +1,231 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_bv_kdop - bounding volume: discrete oriented polytope.
+ */
+
+#include <zeo/zeo_bv.h>
+
+/* ********************************************************** */
+/* zKDOP3D - discrete oriented polytope
+ * ********************************************************** */
+
+/* normal vectors of faces */
+static const double __zeo_kdop_axis14[][3] = {
+  { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+  { 1, 1, 1 }, { 1, 1,-1 }, { 1,-1, 1 }, { 1,-1,-1 },
+};
+static const double __zeo_kdop_axis18[][3] = {
+  { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+  { 1, 1, 0 }, { 1,-1, 0 }, { 1, 0, 1 }, { 1, 0,-1 }, { 0, 1, 1 }, { 0, 1,-1 },
+};
+static const double __zeo_kdop_axis26[][3] = {
+  { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+  { 1, 1, 1 }, { 1, 1,-1 }, { 1,-1, 1 }, { 1,-1,-1 },
+  { 1, 1, 0 }, { 1,-1, 0 }, { 1, 0, 1 }, { 1, 0,-1 }, { 0, 1, 1 }, { 0, 1,-1 },
+};
+
+/* table of normal vectors of faces of a k-DOP. */
+static const double (*_zKDOP3DAxisTable(int k))[3]
+{
+  switch( k ){
+  case 14: return __zeo_kdop_axis14;
+  case 18: return __zeo_kdop_axis18;
+  case 26: return __zeo_kdop_axis26;
+  default: ZRUNERROR( ZEO_ERR_KDOP_INVALID, k );
+  }
+  return NULL;
+}
+
+/* initialize a k-DOP. */
+zKDOP3D *zKDOP3DInit(zKDOP3D *kdop, int k)
+{
+  register int i;
+
+  if( !_zKDOP3DAxisTable( k ) ) return NULL;
+  kdop->k = k;
+  for( i=0; i<ZEO_KDOP_MAX_AXIS; i++ )
+    kdop->min[i] = kdop->max[i] = 0;
+  return kdop;
+}
+
+/* normal vector of a pair of faces of a k-DOP. */
+zVec3D *zKDOP3DAxis(zKDOP3D *kdop, int i, zVec3D *axis)
+{
+  const double (*a)[3];
+
+  if( i < 0 || i >= zKDOP3DAxisNum(kdop) ){
+    ZRUNERROR( ZEO_ERR_INVINDEX );
+    return NULL;
+  }
+  a = _zKDOP3DAxisTable( kdop->k );
+  return zVec3DCreate( axis, a[i][0], a[i][1], a[i][2] );
+}
+
+/* copy a k-DOP to another. */
+zKDOP3D *zKDOP3DCopy(zKDOP3D *src, zKDOP3D *dst)
+{
+  memcpy( dst, src, sizeof(zKDOP3D) );
+  return dst;
+}
+
+/* merge two k-DOPs. */
+zKDOP3D *zKDOP3DMerge(zKDOP3D *dst, zKDOP3D *src1, zKDOP3D *src2)
+{
+  register int i;
+
+  if( src1->k != src2->k ){
+    ZRUNERROR( ZEO_ERR_KDOP_SIZMIS );
+    return NULL;
+  }
+  dst->k = src1->k;
+  for( i=0; i<zKDOP3DAxisNum(src1); i++ ){
+    dst->min[i] = _zMin( src1->min[i], src2->min[i] );
+    dst->max[i] = _zMax( src1->max[i], src2->max[i] );
+  }
+  return dst;
+}
+
+/* check if a point is inside of a k-DOP. */
+bool zKDOP3DPointIsInside(zKDOP3D *kdop, zVec3D *p, bool rim)
+{
+  const double (*a)[3];
+  double d, eps;
+  register int i;
+
+  eps = rim ? zTOL : 0;
+  a = _zKDOP3DAxisTable( kdop->k );
+  for( i=0; i<zKDOP3DAxisNum(kdop); i++ ){
+    d = a[i][0]*p->c.x + a[i][1]*p->c.y + a[i][2]*p->c.z;
+    if( d < kdop->min[i] - eps || d > kdop->max[i] + eps ) return false;
+  }
+  return true;
+}
+
+/* check if two k-DOPs overlap. */
+bool zColChkKDOP3D(zKDOP3D *kdop1, zKDOP3D *kdop2)
+{
+  register int i;
+
+  if( kdop1->k != kdop2->k ){
+    ZRUNERROR( ZEO_ERR_KDOP_SIZMIS );
+    return false;
+  }
+  for( i=0; i<zKDOP3DAxisNum(kdop1); i++ )
+    if( kdop1->min[i] > kdop2->max[i] || kdop2->min[i] > kdop1->max[i] ) return false;
+  return true;
+}
+
+/* vertex of a k-DOP at the intersection of three faces. */
+static bool _zKDOP3DVert(zKDOP3D *kdop, const double (*a)[3], int i[], bool s[], zVec3D *v)
+{
+  zMat3D m;
+  zVec3D d;
+
+  zMat3DCreate( &m,
+    a[i[0]][0], a[i[0]][1], a[i[0]][2],
+    a[i[1]][0], a[i[1]][1], a[i[1]][2],
+    a[i[2]][0], a[i[2]][1], a[i[2]][2] );
+  if( zIsTiny( zMat3DDet( &m ) ) ) return false;
+  zVec3DCreate( &d,
+    s[0] ? kdop->max[i[0]] : kdop->min[i[0]],
+    s[1] ? kdop->max[i[1]] : kdop->min[i[1]],
+    s[2] ? kdop->max[i[2]] : kdop->min[i[2]] );
+  zMulInvMat3DVec3D( &m, &d, v );
+  return zKDOP3DPointIsInside( kdop, v, true );
+}
+
+/* convert a k-DOP to a polyhedron. */
+zPH3D *zKDOP3DToPH3D(zKDOP3D *kdop, zPH3D *ph)
+{
+  const double (*a)[3];
+  zVec3D *v;
+  int n, num = 0, i[3], j;
+  bool s[3];
+
+  if( !( a = _zKDOP3DAxisTable( kdop->k ) ) ) return NULL;
+  n = zKDOP3DAxisNum(kdop);
+  if( !( v = zAlloc( zVec3D, 8*n*(n-1)*(n-2)/6 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  /* candidate vertices at intersections of every three faces */
+  for( i[0]=0; i[0]<n; i[0]++ )
+    for( i[1]=i[0]+1; i[1]<n; i[1]++ )
+      for( i[2]=i[1]+1; i[2]<n; i[2]++ )
+        for( j=0; j<8; j++ ){
+          s[0] = j & 1; s[1] = j & 2; s[2] = j & 4;
+          if( _zKDOP3DVert( kdop, a, i, s, &v[num] ) ) num++;
+        }
+  ph = zCH3D( ph, v, num );
+  zFree( v );
+  return ph;
+}
+
+/* ********************************************************** */
+/* k-DOP - bounding discrete oriented polytope
+ * ********************************************************** */
+
+/* enlarge a k-DOP to include a point. */
+static void _zKDOPInc(zKDOP3D *kdop, const double (*a)[3], zVec3D *p)
+{
+  double d;
+  register int i;
+
+  for( i=0; i<zKDOP3DAxisNum(kdop); i++ ){
+    d = a[i][0]*p->c.x + a[i][1]*p->c.y + a[i][2]*p->c.z;
+    if( d < kdop->min[i] ) kdop->min[i] = d;
+    if( d > kdop->max[i] ) kdop->max[i] = d;
+  }
+}
+
+/* set a k-DOP to a point. */
+static void _zKDOPSet(zKDOP3D *kdop, const double (*a)[3], zVec3D *p)
+{
+  register int i;
+
+  for( i=0; i<zKDOP3DAxisNum(kdop); i++ )
+    kdop->min[i] = kdop->max[i] = a[i][0]*p->c.x + a[i][1]*p->c.y + a[i][2]*p->c.z;
+}
+
+/* bounding k-DOP of points. */
+zKDOP3D *zKDOP(zKDOP3D *kdop, int k, zVec3D p[], int num)
+{
+  const double (*a)[3];
+  register int i;
+
+  if( !zKDOP3DInit( kdop, k ) ) return NULL;
+  if( num <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  a = _zKDOP3DAxisTable( k );
+  _zKDOPSet( kdop, a, &p[0] );
+  for( i=1; i<num; i++ )
+    _zKDOPInc( kdop, a, &p[i] );
+  return kdop;
+}
+
+/* bounding k-DOP of a list of points. */
+zKDOP3D *zKDOPPL(zKDOP3D *kdop, int k, zVec3DList *pl)
+{
+  const double (*a)[3];
+  zVec3DListCell *pc;
+
+  if( !zKDOP3DInit( kdop, k ) ) return NULL;
+  if( zListIsEmpty(pl) ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  a = _zKDOP3DAxisTable( k );
+  _zKDOPSet( kdop, a, zListTail(pl)->data );
+  zListForEach( pl, pc )
+    _zKDOPInc( kdop, a, pc->data );
+  return kdop;
+}
+
+/* bounding k-DOP of a polyhedron. */
+zKDOP3D *zKDOPPH(zKDOP3D *kdop, int k, zPH3D *ph)
+{
+  return zKDOP( kdop, k, zPH3DVertBuf(ph), zPH3DVertNum(ph) );
+}
@@ -78,7 +78,7 @@ bool _zOBB3DMaxDir(zBox3D *obb, zPH3D *ch, zPlane3D *pl)
   zBox3DDepth(obb) = zBox3DWidth(obb) = area_min = HUGE_VAL;
   zVec3DZero( &dc );
   for( ; vp1!=zListRoot(&rim); vp1=zListCellNext(vp1), vp2=zListCellPrev(vp1) ){
-    zVec3DSub( vp2->data, vp1->data, &e1 );
+    if( zVec3DIsTiny( zVec3DSub( vp2->data, vp1->data, &e1 ) ) ) continue; /* duplicate vertices */
     zVec3DOuterProd( zBox3DAxis(obb,zZ), &e1, &e2 );
     zVec3DNormalizeDRC( &e1 );
     zVec3DNormalizeDRC( &e2 );
@@ -123,3 +123,226 @@ zBox3D *zOBBPL(zBox3D *obb, zVec3DList *pl)
   zPH3DDestroy( &ch );
   return obb;
 }
+
+/* fast approximate oriented bounding box */
+
+#define ZEO_OBB_DITO_NUM 7 /* number of directions of DiTO-14 */
+#define ZEO_OBB_CAND_NUM ( 2*ZEO_OBB_DITO_NUM + 6 ) /* number of candidate points */
+
+/* normal directions of the 14-DOP used for DiTO-14. */
+static const double __zeo_obb_dito_dir[][3] = {
+  { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+  { 1, 1, 1 }, { 1, 1,-1 }, { 1,-1, 1 }, { 1,-1,-1 },
+};
+
+/* (static)
+ * extreme points of a set of points along directions. */
+static void _zOBBFastExtreme(zVec3D p[], int n, zVec3D dir[], int dn, zVec3D ext[])
+{
+  double d, dmin[ZEO_OBB_DITO_NUM], dmax[ZEO_OBB_DITO_NUM];
+  int imin[ZEO_OBB_DITO_NUM], imax[ZEO_OBB_DITO_NUM];
+  register int i, k;
+
+  for( k=0; k<dn; k++ ){
+    dmin[k] = dmax[k] = _zVec3DInnerProd( &dir[k], &p[0] );
+    imin[k] = imax[k] = 0;
+  }
+  for( i=1; i<n; i++ )
+    for( k=0; k<dn; k++ ){
+      if( ( d = _zVec3DInnerProd( &dir[k], &p[i] ) ) < dmin[k] ){
+        dmin[k] = d; imin[k] = i;
+      } else
+      if( d > dmax[k] ){
+        dmax[k] = d; imax[k] = i;
+      }
+    }
+  for( k=0; k<dn; k++ ){
+    zVec3DCopy( &p[imin[k]], &ext[2*k] );
+    zVec3DCopy( &p[imax[k]], &ext[2*k+1] );
+  }
+}
+
+/* (static)
+ * half the surface area of the box along axes which bounds points. */
+static double _zOBBFastEval(zVec3D p[], int n, zMat3D *att)
+{
+  double d, l[3], dmin[3], dmax[3];
+  register int i, k;
+
+  for( k=zX; k<=zZ; k++ )
+    dmin[k] = dmax[k] = _zVec3DInnerProd( &att->v[k], &p[0] );
+  for( i=1; i<n; i++ )
+    for( k=zX; k<=zZ; k++ ){
+      if( ( d = _zVec3DInnerProd( &att->v[k], &p[i] ) ) < dmin[k] ) dmin[k] = d;
+      else if( d > dmax[k] ) dmax[k] = d;
+    }
+  for( k=zX; k<=zZ; k++ ) l[k] = dmax[k] - dmin[k];
+  return l[0]*l[1] + l[1]*l[2] + l[2]*l[0];
+}
+
+/* (static)
+ * try axes of a box made from an edge direction and a normal vector. */
+static void _zOBBFastTry(zVec3D p[], int n, zVec3D *e, zVec3D *norm, zMat3D *att, double *s_min)
+{
+  zMat3D att_try;
+  double s;
+
+  if( zVec3DIsTiny( e ) || zVec3DIsTiny( norm ) ) return;
+  zVec3DNormalize( e, &att_try.v[zX] );
+  zVec3DOrthogonalize( norm, &att_try.v[zX], &att_try.v[zZ] );
+  if( zVec3DIsTiny( &att_try.v[zZ] ) ) return;
+  zVec3DNormalizeDRC( &att_try.v[zZ] );
+  zVec3DOuterProd( &att_try.v[zZ], &att_try.v[zX], &att_try.v[zY] );
+  if( ( s = _zOBBFastEval( p, n, &att_try ) ) < *s_min ){
+    zMat3DCopy( &att_try, att );
+    *s_min = s;
+  }
+}
+
+/* (static)
+ * try axes of a box made from three edges of a triangle. */
+static void _zOBBFastTryTri(zVec3D p[], int n, zVec3D *v0, zVec3D *v1, zVec3D *v2, zMat3D *att, double *s_min)
+{
+  zVec3D e[3], norm;
+
+  zVec3DSub( v1, v0, &e[0] );
+  zVec3DSub( v2, v1, &e[1] );
+  zVec3DSub( v0, v2, &e[2] );
+  zVec3DOuterProd( &e[0], &e[1], &norm );
+  _zOBBFastTry( p, n, &e[0], &norm, att, s_min );
+  _zOBBFastTry( p, n, &e[1], &norm, att, s_min );
+  _zOBBFastTry( p, n, &e[2], &norm, att, s_min );
+}
+
+/* (static)
+ * axes of an approximate oriented bounding box by DiTO-14 and PCA. */
+static void _zOBBFastAxes(zVec3D p[], int n, zVec3D cand[], zMat3D *att)
+{
+  zVec3D dir[ZEO_OBB_DITO_NUM], e, c, evec[3];
+  double d, dmin, dmax, s_min;
+  int i0 = 0, i1 = 1, i2 = 0, iq[2] = { -1, -1 };
+  register int i, k;
+
+  for( k=0; k<ZEO_OBB_DITO_NUM; k++ )
+    zVec3DCreate( &dir[k], __zeo_obb_dito_dir[k][0], __zeo_obb_dito_dir[k][1], __zeo_obb_dito_dir[k][2] );
+  _zOBBFastExtreme( p, n, dir, ZEO_OBB_DITO_NUM, cand );
+  /* axis-aligned box as the initial guess */
+  zMat3DIdent( att );
+  s_min = _zOBBFastEval( cand, 2*ZEO_OBB_DITO_NUM, att );
+  /* principal axes */
+  zVec3DBaryPCA( p, n, &c, evec );
+  zVec3DOuterProd( &evec[zX], &evec[zY], &e );
+  _zOBBFastTry( cand, 2*ZEO_OBB_DITO_NUM, &evec[zX], &e, att, &s_min );
+  /* base triangle: the most distant pair of extreme points and the furthest point from them */
+  for( dmax=-1, k=0; k<ZEO_OBB_DITO_NUM; k++ )
+    if( ( d = zVec3DSqrDist( &cand[2*k], &cand[2*k+1] ) ) > dmax ){
+      dmax = d; i0 = 2*k; i1 = 2*k+1;
+    }
+  if( zIsTiny( dmax ) ) return;
+  zVec3DSub( &cand[i1], &cand[i0], &dir[0] );
+  for( dmax=-1, i=0; i<2*ZEO_OBB_DITO_NUM; i++ ){
+    zVec3DSub( &cand[i], &cand[i0], &e );
+    zVec3DOuterProd( &dir[0], &e, &dir[1] );
+    if( ( d = zVec3DSqrNorm( &dir[1] ) ) > dmax ){
+      dmax = d; i2 = i;
+    }
+  }
+  if( zIsTiny( dmax ) ) return;
+  _zOBBFastTryTri( cand, 2*ZEO_OBB_DITO_NUM, &cand[i0], &cand[i1], &cand[i2], att, &s_min );
+  /* ditetrahedron: the furthest points from the base triangle on both sides */
+  zVec3DSub( &cand[i2], &cand[i0], &e );
+  zVec3DOuterProd( &dir[0], &e, &dir[1] );
+  for( dmin=dmax=0, i=0; i<2*ZEO_OBB_DITO_NUM; i++ ){
+    zVec3DSub( &cand[i], &cand[i0], &e );
+    if( ( d = zVec3DInnerProd( &dir[1], &e ) ) > dmax ){
+      dmax = d; iq[0] = i;
+    } else
+    if( d < dmin ){
+      dmin = d; iq[1] = i;
+    }
+  }
+  for( k=0; k<2; k++ ){
+    if( iq[k] < 0 ) continue;
+    _zOBBFastTryTri( cand, 2*ZEO_OBB_DITO_NUM, &cand[i0], &cand[i1], &cand[iq[k]], att, &s_min );
+    _zOBBFastTryTri( cand, 2*ZEO_OBB_DITO_NUM, &cand[i1], &cand[i2], &cand[iq[k]], att, &s_min );
+    _zOBBFastTryTri( cand, 2*ZEO_OBB_DITO_NUM, &cand[i2], &cand[i0], &cand[iq[k]], att, &s_min );
+  }
+}
+
+/* (static)
+ * refine axes of an approximate oriented bounding box by rotating them. */
+static void _zOBBFastRefine(zVec3D p[], int n, zVec3D cand[], zMat3D *att, int iter)
+{
+  zMat3D att_try;
+  double theta = zDeg2Rad(10), s_min, s, c, sn;
+  register int i, j, k;
+
+  for( i=0; i<iter; i++, theta*=0.5 ){
+    /* extreme points along the current axes are added to candidates */
+    _zOBBFastExtreme( p, n, att->v, 3, cand+2*ZEO_OBB_DITO_NUM );
+    s_min = _zOBBFastEval( cand, ZEO_OBB_CAND_NUM, att );
+    for( k=zX; k<=zZ; k++ )
+      for( j=-1; j<=1; j+=2 ){
+        c = cos( theta ); sn = j * sin( theta );
+        zVec3DCopy( &att->v[k], &att_try.v[k] );
+        zVec3DMul( &att->v[(k+1)%3], c, &att_try.v[(k+1)%3] );
+        zVec3DCatDRC( &att_try.v[(k+1)%3], sn, &att->v[(k+2)%3] );
+        zVec3DMul( &att->v[(k+2)%3], c, &att_try.v[(k+2)%3] );
+        zVec3DCatDRC( &att_try.v[(k+2)%3], -sn, &att->v[(k+1)%3] );
+        if( ( s = _zOBBFastEval( cand, ZEO_OBB_CAND_NUM, &att_try ) ) < s_min ){
+          zMat3DCopy( &att_try, att );
+          s_min = s;
+        }
+      }
+  }
+}
+
+/* approximate oriented bounding box. */
+zBox3D *zOBBFast(zBox3D *obb, zVec3D p[], int n, int iter)
+{
+  zVec3D cand[ZEO_OBB_CAND_NUM], c;
+  zMat3D att;
+  double d, dmin[3], dmax[3];
+  register int i, k;
+
+  if( n <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  _zOBBFastAxes( p, n, cand, &att );
+  _zOBBFastRefine( p, n, cand, &att, iter );
+  /* exact extents along the axes */
+  for( k=zX; k<=zZ; k++ )
+    dmin[k] = dmax[k] = _zVec3DInnerProd( &att.v[k], &p[0] );
+  for( i=1; i<n; i++ )
+    for( k=zX; k<=zZ; k++ ){
+      if( ( d = _zVec3DInnerProd( &att.v[k], &p[i] ) ) < dmin[k] ) dmin[k] = d;
+      else if( d > dmax[k] ) dmax[k] = d;
+    }
+  zVec3DZero( &c );
+  for( k=zX; k<=zZ; k++ )
+    zVec3DCatDRC( &c, 0.5*( dmin[k] + dmax[k] ), &att.v[k] );
+  return zBox3DCreate( obb, &c, &att.v[zX], &att.v[zY], &att.v[zZ], dmax[zX]-dmin[zX], dmax[zY]-dmin[zY], dmax[zZ]-dmin[zZ] );
+}
+
+/* approximate oriented bounding box of a list of points. */
+zBox3D *zOBBFastPL(zBox3D *obb, zVec3DList *pl, int iter)
+{
+  zVec3DListCell *vc;
+  zVec3D *p;
+  int n = 0;
+
+  if( zListIsEmpty( pl ) ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  if( !( p = zAlloc( zVec3D, zListSize(pl) ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  zListForEach( pl, vc )
+    zVec3DCopy( vc->data, &p[n++] );
+  obb = zOBBFast( obb, p, n, iter );
+  zFree( p );
+  return obb;
+}
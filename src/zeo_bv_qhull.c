@@ -7,636 +7,747 @@
 #include <zeo/zeo_bv.h>
 
 /* ********************************************************** */
-/* CLASS: zQHPoint, zQHPointList, zQHFacet, zQHFacetList, zQH
- * facet/point class for quickhull algorithm
+/* quickhull on indices of points
  * ********************************************************** */
 
-typedef struct _zQHPoint{
-  zVec3D *v;    /* vertex coordinates */
-  bool discard; /* discarding flag */
-} zQHPoint;
-zListClass(zQHPointList, zQHPointListCell, zQHPoint);
+#define ZEO_QH_NONE (-1)
 
-typedef struct _zQHFacet{
-  zQHPoint *p[3];  /* vertices */
-  struct _zQHFacet *c[3]; /* contiguous facets */
-  bool merge[3];  /* flag to check if merged with contiguous facets */
-  zQHPointList op; /* outside point set */
-  zVec3D n;        /* normal vector */
-  double d_max;    /* furthest point distance */
-  bool visible;    /* visible set flag */
-  bool check;      /* merge check flag */
-} zQHFacet;
-zListClass(zQHFacetList, zQHFacetListCell, zQHFacet);
+/* index array operation */
 
-typedef struct{
-  zQHPointList vl; /* vertices */
-  zQHFacetList fl; /* facets */
-} zQH;
+/* push an index to an array. */
+static bool _zQHIndexPush(zQHIndex *index, int i)
+{
+  int *buf;
+
+  if( index->num == index->size ){
+    if( !( buf = zRealloc( index->buf, int, index->size*2+16 ) ) ){
+      ZALLOCERROR();
+      return false;
+    }
+    index->buf = buf;
+    index->size = index->size*2 + 16;
+  }
+  index->buf[index->num++] = i;
+  return true;
+}
+
+/* facet operation */
+
+/* allocate a new facet from the arena. */
+static int _zQHFacetAlloc(zQH *qh)
+{
+  zQHFacet *facet;
+  int i;
 
-/* facet/point operation */
+  if( ( i = qh->ffree ) != ZEO_QH_NONE ){
+    qh->ffree = qh->facet[i].c[0];
+    return i;
+  }
+  if( qh->fnum == qh->fsize ){
+    if( !( facet = zRealloc( qh->facet, zQHFacet, qh->fsize*2+64 ) ) ){
+      ZALLOCERROR();
+      return ZEO_QH_NONE;
+    }
+    qh->facet = facet;
+    qh->fsize = qh->fsize*2 + 64;
+  }
+  return qh->fnum++;
+}
 
-/* create a point. */
-static zQHPoint *_zQHPointCreate(zQHPoint *p, zVec3D *v)
+/* return a facet to the arena. */
+static void _zQHFacetFree(zQH *qh, int i)
 {
-  p->v = v;
-  p->discard = false;
-  return p;
+  qh->facet[i].v[0] = ZEO_QH_NONE;
+  qh->facet[i].c[0] = qh->ffree;
+  qh->ffree = i;
 }
 
+/* check if a facet is alive. */
+#define _zQHFacetIsAlive(qh,i) ( (qh)->facet[i].v[0] != ZEO_QH_NONE )
+
 /* create a new facet. */
-static zQHFacet *_zQHFacetCreate(zQHFacet *f, zQHPoint *p0, zQHPoint *p1, zQHPoint *p2)
+static int _zQHFacetCreate(zQH *qh, int p0, int p1, int p2)
 {
+  zQHFacet *f;
   zVec3D e1, e2;
+  int i;
 
-  zVec3DSub( p1->v, p0->v, &e1 );
-  zVec3DSub( p2->v, p0->v, &e2 );
+  if( ( i = _zQHFacetAlloc( qh ) ) == ZEO_QH_NONE ) return ZEO_QH_NONE;
+  f = &qh->facet[i];
+  zVec3DSub( &qh->p[p1], &qh->p[p0], &e1 );
+  zVec3DSub( &qh->p[p2], &qh->p[p0], &e2 );
   zVec3DOuterProd( &e1, &e2, &f->n );
   zVec3DNormalizeNCDRC( &f->n );
-  f->p[0] = p0;
-  f->p[1] = p1;
-  f->p[2] = p2;
-  f->c[0] = f->c[1] = f->c[2] = NULL;
-  f->merge[0] = f->merge[1] = f->merge[2] = false;
-  zListInit( &f->op );
-  f->d_max = -zTOL;
-  f->visible = false;
-  f->check = false;
-  return f;
+  f->d = zVec3DInnerProd( &f->n, &qh->p[p0] );
+  f->v[0] = p0;
+  f->v[1] = p1;
+  f->v[2] = p2;
+  f->c[0] = f->c[1] = f->c[2] = ZEO_QH_NONE;
+  f->op = f->far = ZEO_QH_NONE;
+  f->d_max = 0;
+  f->visit = 0;
+  return i;
 }
 
-/* destroy a facet. */
-static void _zQHFacetDestroy(zQHFacet *f)
-{
-  f->p[0] = f->p[1] = f->p[2] = NULL;
-  f->c[0] = f->c[1] = f->c[2] = NULL;
-  zListDestroy( zQHPointListCell, &f->op );
-}
+/* signed distance from a facet to a point. */
+#define _zQHFacetDist(qh,f,i) ( _zVec3DInnerProd( &(f)->n, &(qh)->p[i] ) - (f)->d )
 
-/* bind with contiguous facets. */
-static void _zQHFacetContig(zQHFacet *f, zQHFacet *f0, zQHFacet *f1, zQHFacet *f2)
+/* add a point to the outside set of a facet if it is beyond the facet. */
+static bool _zQHFacetAddPoint(zQH *qh, zQHFacet *f, int i)
 {
-  f->c[0] = f0;
-  f->c[1] = f1;
-  f->c[2] = f2;
+  double d;
+
+  if( ( d = _zQHFacetDist( qh, f, i ) ) <= qh->tol ) return false;
+  qh->next[i] = f->op;
+  f->op = i;
+  if( d > f->d_max ){
+    f->d_max = d;
+    f->far = i;
+  }
+  return true;
 }
 
-/* convert a facet to a triangle element. */
-static zTri3D *_zQHFacet2Tri3D(zQHFacet *f, zTri3D *t)
+/* index of the edge of a facet shared with another facet. */
+static int _zQHFacetContigID(zQHFacet *f, int c)
 {
-  zTri3DSetVert( t, 0, f->p[0]->v );
-  zTri3DSetVert( t, 1, f->p[1]->v );
-  zTri3DSetVert( t, 2, f->p[2]->v );
-  zTri3DSetNorm( t, &f->n );
-  return t;
+  if( f->c[0] == c ) return 0;
+  if( f->c[1] == c ) return 1;
+  if( f->c[2] == c ) return 2;
+  ZRUNERROR( ZEO_ERR_FATAL );
+  return ZEO_QH_NONE;
 }
 
-/* check if a point is on a facet. */
-static bool _zQHFacetOn(zQHFacet *f, zVec3D *v)
-{
-  zTri3D t;
+/* quickhull operation */
 
-  _zQHFacet2Tri3D( f, &t );
-  return zTri3DPointIsInside( &t, v, true );
+/* initialize a workspace of quickhull. */
+static bool _zQHInit(zQH *qh, zVec3D p[], int num)
+{
+  qh->p = p;
+  qh->num = num;
+  qh->next = qh->vstamp = qh->vmap = NULL;
+  qh->facet = NULL;
+  qh->fsize = qh->fnum = 0;
+  qh->ffree = ZEO_QH_NONE;
+  qh->stamp = 0;
+  qh->tol = zTOL;
+  qh->pending.buf = qh->vs.buf = qh->horizon.buf = qh->cone.buf = NULL;
+  qh->pending.size = qh->vs.size = qh->horizon.size = qh->cone.size = 0;
+  qh->pending.num = qh->vs.num = qh->horizon.num = qh->cone.num = 0;
+  if( num == 0 ) return true;
+  qh->next = zAlloc( int, num );
+  qh->vstamp = zAlloc( int, num );
+  qh->vmap = zAlloc( int, num );
+  if( !qh->next || !qh->vstamp || !qh->vmap ){
+    ZALLOCERROR();
+    return false;
+  }
+  return true;
 }
 
-/* destroy facet list. */
-static void _zQHFacetListDestroy(zQHFacetList *fl)
+/* destroy a workspace of quickhull. */
+static void _zQHDestroy(zQH *qh)
 {
-  zQHFacetListCell *fc;
-
-  while( !zListIsEmpty( fl ) ){
-    zListDeleteHead( fl, &fc );
-    _zQHFacetDestroy( &fc->data );
-    zFree( fc );
-  }
+  zFree( qh->next );
+  zFree( qh->vstamp );
+  zFree( qh->vmap );
+  zFree( qh->facet );
+  zFree( qh->pending.buf );
+  zFree( qh->vs.buf );
+  zFree( qh->horizon.buf );
+  zFree( qh->cone.buf );
 }
 
 /* initial simplex */
 
 /* find vertices of the initial simplex. */
-static int _zQHSimplexVert(zQHPointList *pl, zQHPointListCell *v[])
+static int _zQHSimplexVert(zQH *qh, int idx[], int num, int v[])
 {
-  zQHPointList reserve;
-  zVec3D e[3], d[2], n;
-  double h;
-  int dim = 4;
-
-  zListInit( &reserve );
-  if( zListIsEmpty( pl ) ){
-    ZRUNWARN( ZEO_ERR_EMPTYSET );
-    return 0;
-  }
-  zListDeleteTail( pl, &v[0] ); /* first vertex */
-  while( !zListIsEmpty( pl ) ){ /* second vertex */
-    zListDeleteTail( pl, &v[1] ); /* candidate */
-    zVec3DSub( v[1]->data.v, v[0]->data.v, &e[0] );
-    if( !zVec3DIsTiny( &e[0] ) ) goto THIRD;
-    zFree( v[1] );
-  }
-  ZRUNWARN( ZEO_ERR_CH_DEG1 );
-  return 1;
- THIRD:
-  zVec3DNormalize( &e[0], &d[0] );
-  while( !zListIsEmpty( pl ) ){ /* third vertex */
-    zListDeleteTail( pl, &v[2] ); /* candidate */
-    zVec3DSub( v[2]->data.v, v[0]->data.v, &e[1] );
-    if( !zVec3DIsTiny( &e[1] ) ){
-      zVec3DNormalize( &e[1], &d[1] );
-      zVec3DOuterProd( &d[0], &d[1], &n );
-      if( !zVec3DIsTiny( &n ) ){
-        zVec3DNormalizeDRC( &n );
-        goto FOURTH;
+  int ext[6];
+  double d, d_max, scale = 0;
+  zVec3D e, d1, n;
+  register int i, j, k;
+
+  if( num == 0 ) return 0;
+  v[0] = v[1] = v[2] = v[3] = idx[0];
+  /* extreme points along axes */
+  for( k=0; k<6; k++ ) ext[k] = idx[0];
+  for( i=1; i<num; i++ )
+    for( k=zX; k<=zZ; k++ ){
+      if( qh->p[idx[i]].e[k] < qh->p[ext[2*k]].e[k] ) ext[2*k] = idx[i];
+      if( qh->p[idx[i]].e[k] > qh->p[ext[2*k+1]].e[k] ) ext[2*k+1] = idx[i];
+    }
+  for( k=zX; k<=zZ; k++ )
+    scale += _zMax( fabs( qh->p[ext[2*k]].e[k] ), fabs( qh->p[ext[2*k+1]].e[k] ) );
+  qh->tol = _zMax( zTOL, 3 * DBL_EPSILON * scale );
+  /* first and second vertices: the most distant pair of extreme points */
+  for( d_max=0, j=0; j<6; j++ )
+    for( k=j+1; k<6; k++ )
+      if( ( d = zVec3DSqrDist( &qh->p[ext[j]], &qh->p[ext[k]] ) ) > d_max ){
+        d_max = d;
+        v[0] = ext[j];
+        v[1] = ext[k];
       }
+  if( sqrt( d_max ) <= qh->tol ) return 1;
+  /* third vertex: the furthest point from the line */
+  zVec3DSub( &qh->p[v[1]], &qh->p[v[0]], &d1 );
+  zVec3DNormalizeNCDRC( &d1 );
+  for( d_max=0, i=0; i<num; i++ ){
+    _zVec3DSub( &qh->p[idx[i]], &qh->p[v[0]], &e );
+    _zVec3DOuterProd( &d1, &e, &n );
+    if( ( d = _zVec3DSqrNorm( &n ) ) > d_max ){
+      d_max = d;
+      v[2] = idx[i];
     }
-    zListInsertTail( &reserve, v[2] );
-  }
-  ZRUNERROR( ZEO_ERR_CH_DEG2 );
-  dim = 2;
-  goto TERMINATE;
- FOURTH:
-  while( !zListIsEmpty( pl ) ){ /* fourth vertex */
-    zListDeleteTail( pl, &v[3] ); /* candidate */
-    zVec3DSub( v[3]->data.v, v[0]->data.v, &e[2] );
-    h = zVec3DInnerProd( &e[2], &n );
-    if( !zIsTiny( h ) ){
-      if( h > 0 )
-        zSwap( zQHPointListCell*, v[0], v[1] );
-      goto TERMINATE;
+  }
+  if( sqrt( d_max ) <= qh->tol ) return 2;
+  /* fourth vertex: the furthest point from the plane */
+  zVec3DSub( &qh->p[v[2]], &qh->p[v[0]], &e );
+  zVec3DOuterProd( &d1, &e, &n );
+  zVec3DNormalizeNCDRC( &n );
+  for( d_max=0, i=0; i<num; i++ ){
+    _zVec3DSub( &qh->p[idx[i]], &qh->p[v[0]], &e );
+    if( fabs( ( d = _zVec3DInnerProd( &n, &e ) ) ) > fabs( d_max ) ){
+      d_max = d;
+      v[3] = idx[i];
     }
-    zListInsertTail( &reserve, v[3] );
   }
-  ZRUNERROR( ZEO_ERR_CH_DEG3 );
-  dim = 3;
- TERMINATE:
-  if( !zListIsEmpty( &reserve ) )
-    zListAppend( pl, &reserve );
-  return dim;
+  if( fabs( d_max ) <= qh->tol ) return 3;
+  if( d_max > 0 ) zSwap( int, v[0], v[1] ); /* v[3] is beneath v[0]-v[1]-v[2] */
+  return 4;
 }
 
-/* initial simplex. */
-static int _zQHSimplex(zQH *qh, zQHPointList *pl)
+/* bind two contiguous facets with each other. */
+static void _zQHFacetBind(zQH *qh, int f1, int s1, int f2, int s2)
 {
-  zQHPointListCell *v[4];
-  zQHFacetListCell *fc[4];
-  int ret, i;
-
-  if( ( ret = _zQHSimplexVert( pl, v ) ) < 4 ) return ret;
-  for( i=0; i<4; i++ ){
-    zListInsertHead( &qh->vl, v[i] );
-    if( !( fc[i] = zAlloc( zQHFacetListCell, 1 ) ) ){
-      ZALLOCERROR();
-      return 0;
-    }
-    zListInsertHead( &qh->fl, fc[i] );
-  }
-  _zQHFacetCreate( &fc[0]->data, &v[0]->data, &v[1]->data, &v[2]->data );
-  _zQHFacetCreate( &fc[1]->data, &v[0]->data, &v[3]->data, &v[1]->data );
-  _zQHFacetCreate( &fc[2]->data, &v[1]->data, &v[3]->data, &v[2]->data );
-  _zQHFacetCreate( &fc[3]->data, &v[2]->data, &v[3]->data, &v[0]->data );
-  _zQHFacetContig( &fc[0]->data, &fc[2]->data, &fc[3]->data, &fc[1]->data );
-  _zQHFacetContig( &fc[1]->data, &fc[2]->data, &fc[0]->data, &fc[3]->data );
-  _zQHFacetContig( &fc[2]->data, &fc[3]->data, &fc[0]->data, &fc[1]->data );
-  _zQHFacetContig( &fc[3]->data, &fc[1]->data, &fc[0]->data, &fc[2]->data );
-  return ret;
+  qh->facet[f1].c[s1] = f2;
+  qh->facet[f2].c[s2] = f1;
 }
 
-/* beneath-beyond test. */
-static int _zQHFacetBB(zQHFacet *f, zQHPoint *p, zVec3D *e)
+/* initial simplex. */
+static int _zQHSimplex(zQH *qh, int idx[], int num)
 {
-  double l;
-
-  zVec3DSub( p->v, f->p[0]->v, e );
-  if( zVec3DIsTiny(e) ) return 0; /* coincide with one vertex */
-  l = zVec3DInnerProd( &f->n, e );
-  if( l < -zTOL ) return -1; /* beneath case */
-  if( l > zTOL ) return 1;   /* beyond case */
-  return _zQHFacetOn( f, p->v ) ? 0 : 1;
+  int v[4], f[4], ret;
+  register int i, j;
+
+  if( ( ret = _zQHSimplexVert( qh, idx, num, v ) ) < 4 ) return ret;
+  if( ( f[0] = _zQHFacetCreate( qh, v[0], v[1], v[2] ) ) == ZEO_QH_NONE ||
+      ( f[1] = _zQHFacetCreate( qh, v[0], v[3], v[1] ) ) == ZEO_QH_NONE ||
+      ( f[2] = _zQHFacetCreate( qh, v[1], v[3], v[2] ) ) == ZEO_QH_NONE ||
+      ( f[3] = _zQHFacetCreate( qh, v[2], v[3], v[0] ) ) == ZEO_QH_NONE ) return -1;
+  _zQHFacetBind( qh, f[0], 0, f[1], 2 );
+  _zQHFacetBind( qh, f[0], 1, f[2], 2 );
+  _zQHFacetBind( qh, f[0], 2, f[3], 2 );
+  _zQHFacetBind( qh, f[1], 0, f[3], 1 );
+  _zQHFacetBind( qh, f[1], 1, f[2], 0 );
+  _zQHFacetBind( qh, f[2], 1, f[3], 0 );
+  /* initial beneath-beyond test */
+  for( i=0; i<num; i++ ){
+    if( idx[i] == v[0] || idx[i] == v[1] || idx[i] == v[2] || idx[i] == v[3] ) continue;
+    for( j=0; j<4; j++ )
+      if( _zQHFacetAddPoint( qh, &qh->facet[f[j]], idx[i] ) ) break;
+  }
+  for( j=0; j<4; j++ )
+    if( qh->facet[f[j]].op != ZEO_QH_NONE && !_zQHIndexPush( &qh->pending, f[j] ) ) return -1;
+  return ret;
 }
 
-/* assign points to the outside sets of facets. */
-static void _zQHFacetAssign(zQHFacetList *fl, zQHPointList *pl)
+/* purge visible set from facets and find the horizon ridges. */
+static bool _zQHVisibleSet(zQH *qh, int f, int p)
 {
-  zQHFacetListCell *fc;
-  zQHPointListCell *pc, *pc_tmp;
-  zVec3D e;
-  double d;
-  int flag;
-
-  zListForEach( fl, fc )
-    zListForEach( pl, pc ){
-      flag = _zQHFacetBB( &fc->data, &pc->data, &e );
-      if( flag == -1 ) continue; /* invisible from the current facet */
-      pc_tmp = zListCellPrev( pc );
-      zListPurge( pl, pc );
-      if( flag == 0 ){
-        /* discard a superficial point on a facet */
-        zFree( pc );
-      } else{ /* visible point */
-        d = zVec3DInnerProd( &fc->data.n, &e );
-        if( d > fc->data.d_max ){
-          fc->data.d_max = d;
-          zListInsertHead( &fc->data.op, pc );
-        } else
-          zListInsertTail( &fc->data.op, pc );
+  zQHFacet *fp;
+  int c;
+  register int i, s;
+
+  qh->vs.num = qh->horizon.num = 0;
+  qh->stamp++;
+  qh->facet[f].visit = qh->stamp;
+  if( !_zQHIndexPush( &qh->vs, f ) ) return false;
+  for( i=0; i<qh->vs.num; i++ ){
+    fp = &qh->facet[qh->vs.buf[i]];
+    for( s=0; s<3; s++ ){
+      c = fp->c[s];
+      if( qh->facet[c].visit == qh->stamp ) continue;
+      if( _zQHFacetDist( qh, &qh->facet[c], p ) > qh->tol ){
+        qh->facet[c].visit = qh->stamp;
+        if( !_zQHIndexPush( &qh->vs, c ) ) return false;
       }
-      pc = pc_tmp;
     }
-  /* discard points inside of the convex hull */
-  zListDestroy( zQHPointListCell, pl );
+  }
+  /* horizon ridges: edges between visible and invisible facets */
+  for( i=0; i<qh->vs.num; i++ ){
+    fp = &qh->facet[qh->vs.buf[i]];
+    for( s=0; s<3; s++ )
+      if( qh->facet[fp->c[s]].visit != qh->stamp ){
+        if( !_zQHIndexPush( &qh->horizon, qh->vs.buf[i] ) ||
+            !_zQHIndexPush( &qh->horizon, s ) ) return false;
+      }
+  }
+  return true;
 }
 
-/* merge coplanar facets. */
-static void _zQHMerge(zQHFacet *f)
+/* check if the horizon ridges form a simple loop. */
+static bool _zQHHorizonIsLoop(zQH *qh)
 {
-  f->visible = true;
-  f->check = true;
-  if( f->merge[0] && !f->c[0]->check ) _zQHMerge( f->c[0] );
-  if( f->merge[1] && !f->c[1]->check ) _zQHMerge( f->c[1] );
-  if( f->merge[2] && !f->c[2]->check ) _zQHMerge( f->c[2] );
+  zQHFacet *fp;
+  register int i;
+
+  for( i=0; i<qh->horizon.num; i+=2 ){
+    fp = &qh->facet[qh->horizon.buf[i]];
+    if( qh->vstamp[fp->v[qh->horizon.buf[i+1]]] == qh->stamp ) return false;
+    qh->vstamp[fp->v[qh->horizon.buf[i+1]]] = qh->stamp;
+  }
+  for( i=0; i<qh->horizon.num; i+=2 ){
+    fp = &qh->facet[qh->horizon.buf[i]];
+    if( qh->vstamp[fp->v[(qh->horizon.buf[i+1]+1)%3]] != qh->stamp ) return false;
+    qh->vstamp[fp->v[(qh->horizon.buf[i+1]+1)%3]] = -qh->stamp;
+  }
+  return true;
 }
 
-/* reset visibility flags of all facets. */
-static void _zQHFacetResetFlag(zQH *qh)
+/* create a cone of new facets from a new vertex and the horizon ridges. */
+static bool _zQHHorizon(zQH *qh, int p)
 {
-  zQHFacetListCell *fc;
+  int f, s, c, a, b, cs;
+  register int i;
 
-  zListForEach( &qh->fl, fc ){
-    fc->data.visible = false;
-    fc->data.check = false;
+  qh->cone.num = 0;
+  for( i=0; i<qh->horizon.num; i+=2 ){
+    f = qh->horizon.buf[i];
+    s = qh->horizon.buf[i+1];
+    a = qh->facet[f].v[s];
+    b = qh->facet[f].v[(s+1)%3];
+    c = qh->facet[f].c[s];
+    if( ( cs = _zQHFacetContigID( &qh->facet[c], f ) ) == ZEO_QH_NONE ||
+        ( f = _zQHFacetCreate( qh, a, b, p ) ) == ZEO_QH_NONE ||
+        !_zQHIndexPush( &qh->cone, f ) ) return false;
+    _zQHFacetBind( qh, f, 0, c, cs );
+    qh->vmap[a] = f;
+  }
+  for( i=0; i<qh->cone.num; i++ ){
+    f = qh->cone.buf[i];
+    _zQHFacetBind( qh, f, 1, qh->vmap[qh->facet[f].v[1]], 2 );
   }
+  return true;
 }
 
-/* purge visible set from facet list and collect outside points. */
-static bool _zQHVisibleSet(zQH *qh, zQHPoint *p, zQHFacetList *vs, zQHPointList *pl)
+/* reassign outside points of the visible set to the cone. */
+static bool _zQHFacetAssign(zQH *qh, int p)
 {
-  zQHFacetListCell *fc, *fc_tmp;
-  zVec3D e;
-  int flag;
-
-  zListInit( vs );
-  zListInit( pl );
-  zListForEach( &qh->fl, fc ){
-    flag = _zQHFacetBB( &fc->data, p, &e );
-    if( flag == 0 ){
-      _zQHFacetResetFlag( qh );
-      return false;
-    }
-    if( flag == 1 && !fc->data.check ) _zQHMerge( &fc->data );
-  }
-  zListForEach( &qh->fl, fc )
-    if( fc->data.visible ){ /* if visible, the facet will be deleted. */
-      fc_tmp = zListCellPrev( fc );
-      zListPurge( &qh->fl, fc ); /* delete from facet list */
-      zListInsertTail( vs, fc ); /* insert to visible set */
-      zListAppendZ( pl, &fc->data.op ); /* points to be reassigned */
-      fc->data.p[0]->discard = fc->data.p[1]->discard = fc->data.p[2]->discard = true;
-      fc = fc_tmp;
+  int q, next;
+  register int i, j;
+
+  for( i=0; i<qh->vs.num; i++ )
+    for( q=qh->facet[qh->vs.buf[i]].op; q!=ZEO_QH_NONE; q=next ){
+      next = qh->next[q];
+      if( q == p ) continue;
+      for( j=0; j<qh->cone.num; j++ ) /* points beneath all new facets are discarded */
+        if( _zQHFacetAddPoint( qh, &qh->facet[qh->cone.buf[j]], q ) ) break;
     }
+  for( i=0; i<qh->vs.num; i++ )
+    _zQHFacetFree( qh, qh->vs.buf[i] );
+  for( i=0; i<qh->cone.num; i++ )
+    if( qh->facet[qh->cone.buf[i]].op != ZEO_QH_NONE &&
+        !_zQHIndexPush( &qh->pending, qh->cone.buf[i] ) ) return false;
   return true;
 }
 
-/* find counter identifier of the contiguous facet. */
-static int _zQHFacetContigID(zQHFacet *f, int s)
+/* remove a point from the outside set of a facet. */
+static void _zQHFacetRemovePoint(zQH *qh, zQHFacet *f, int p)
 {
-  if( f->c[s]->c[0] == f ) return 0;
-  if( f->c[s]->c[1] == f ) return 1;
-  if( f->c[s]->c[2] == f ) return 2;
-  ZRUNERROR( ZEO_ERR_FATAL );
-  return -1;
-}
+  int *q;
 
-/* bind two contiguous facets with each other. */
-static void _zQHFacetBind(zQHFacet *f1, int s1, zQHFacet *f2, int s2)
-{
-  zVec3D e, d;
-  bool flag = false;
-
-  f1->c[s1] = f2;
-  f2->c[s2] = f1;
-  /* merge if coplanar */
-  if( zVec3DIsTiny( zVec3DSub( &f1->n, &f2->n, &e ) ) )
-    flag = true; /* normal vectors almost coincide */
-  else{
-    if( zVec3DIsTiny( zVec3DOuterProd( &f1->n, &f2->n, &d ) ) )
-      flag = true; /* normal vectors almost parallel */
-    else{
-      zVec3DSub( f1->p[(s1+2)%3]->v, f1->p[(s1+1)%3]->v, &e );
-      if( zVec3DInnerProd( &e, &d ) < 0 )
-        flag = true; /* non-convex contiguous facets (abnormal) */
+  for( q=&f->op; *q!=ZEO_QH_NONE; q=&qh->next[*q] )
+    if( *q == p ){
+      *q = qh->next[p];
+      break;
+    }
+  f->far = ZEO_QH_NONE;
+  f->d_max = 0;
+  for( p=f->op; p!=ZEO_QH_NONE; p=qh->next[p] )
+    if( _zQHFacetDist( qh, f, p ) > f->d_max ){
+      f->d_max = _zQHFacetDist( qh, f, p );
+      f->far = p;
     }
-  }
-  f1->merge[s1] = f2->merge[s2] = flag;
 }
 
-/* create a new facet from a new vertex and a horizon ridge. */
-static zQHFacetListCell *_zQHHorizonNewFacet(zQHPoint *p, zQHFacet *f, int s)
+/* incrementally create new vertices and facets. */
+static bool _zQHInc(zQH *qh, int f)
 {
-  zQHFacetListCell *fc;
-  int s1, s2;
+  int p; /* furthest point */
 
-  if( !( fc = zAlloc( zQHFacetListCell, 1 ) ) ) return NULL;
-  s1 = ( s + 1 ) % 3;
-  s2 = ( s + 2 ) % 3;
-  f->p[s1]->discard = f->p[s2]->discard = false;
-  if( _zQHFacetCreate( &fc->data, p, f->p[s1], f->p[s2] ) &&
-      ( s1 = _zQHFacetContigID( f, s ) ) != -1 ){
-    _zQHFacetBind( &fc->data, 0, f->c[s], s1 );
-    return fc;
+  p = qh->facet[f].far;
+  if( !_zQHVisibleSet( qh, f, p ) ) return false;
+  if( !_zQHHorizonIsLoop( qh ) ){ /* a numerically degenerate case */
+    _zQHFacetRemovePoint( qh, &qh->facet[f], p );
+    return qh->facet[f].op == ZEO_QH_NONE || _zQHIndexPush( &qh->pending, f );
   }
-  ZRUNERROR( ZEO_ERR_FATAL );
-  zFree( fc );
-  return NULL;
+  return _zQHHorizon( qh, p ) && _zQHFacetAssign( qh, p );
 }
 
-/* find the horizon ridges and create new facets. */
-static bool _zQHHorizon(zQHFacetList *vs, zQHPoint *p, zQHFacetList *cone)
+/* process facets which have outside points. */
+static bool _zQHProcess(zQH *qh)
 {
-  zQHFacetListCell *fc;
-  zQHFacet *f, *f_prev;
-  zQHPoint *p0;
-  int n;
-  register int i = 0, s;
-
-  zListInit( cone );
-  /* find first ridge */
-  zListForEach( vs, fc )
-    for( s=0; s<3; s++ )
-      if( !fc->data.c[s]->visible ) goto START;
-  ZRUNERROR( ZEO_ERR_FATAL );
-  return false;
-
- START:
-  /* first facet in the cone */
-  f = &fc->data;
-  if( !( fc = _zQHHorizonNewFacet( p, f, s ) ) )
-    return false;
-  zListInsertHead( cone, fc );
-  s = ( s + 1 ) % 3;
-  p0 = f->p[s];
-  n = zListSize( vs ) * 3;
-  do{
-    if( i++ > n ){ /* probably a circulation occurs */
-      ZRUNERROR( ZEO_ERR_FATAL );
-      return false;
-    }
-    if( f->c[s]->visible ){
-      f_prev = f;
-      f = f->c[s];
-      if( ( s = _zQHFacetContigID( f_prev, s ) ) == -1 ){
-        ZRUNERROR( ZEO_ERR_FATAL );
-        return false;
-      }
-      s = ( s + 1 ) % 3;
-    } else{
-      if( !( fc = _zQHHorizonNewFacet( p, f, s ) ) )
-        return false;
-      _zQHFacetBind( &fc->data, 2, &zListHead(cone)->data, 1 );
-      zListInsertHead( cone, fc );
-      s = ( s + 1 ) % 3;
-    }
-  } while( f->p[(s+1)%3] != p0 );
-  /* bind head and tail of the cone */
-  _zQHFacetBind( &zListHead(cone)->data, 1, &zListTail(cone)->data, 2 );
-  return true;
-}
+  int f;
 
-/* incrementally create new vertices and facets. */
-static bool _zQHInc(zQH *qh, zQHFacet *f)
-{
-  zQHPointListCell *pc; /* furthest point */
-  zQHPointList pl; /* list of points to be reassigned */
-  zQHFacetList vs; /* visible facet set */
-  zQHFacetList cone; /* cone consisting of new facets */
-
-  /* pick up a new vertex */
-  zListDeleteHead( &f->op, &pc );
-  /* create visible set and collect points to be reassigned */
-  if( !_zQHVisibleSet( qh, &pc->data, &vs, &pl ) ){
-    zFree( pc );
-    return true; /* retry another facet */
-  }
-  zListInsertHead( &qh->vl, pc );
-  /* create a cone of the new vertex and horizon ridges */
-  if( !_zQHHorizon( &vs, &pc->data, &cone ) ){
-    _zQHFacetListDestroy( &cone );
-    _zQHFacetListDestroy( &vs );
-    return false;
+  while( qh->pending.num > 0 ){
+    f = qh->pending.buf[--qh->pending.num];
+    if( !_zQHFacetIsAlive( qh, f ) || qh->facet[f].op == ZEO_QH_NONE ) continue;
+    if( !_zQHInc( qh, f ) ) return false;
   }
-  _zQHFacetAssign( &cone, &pl ); /* reassign points outside of the cone */
-  zListAppendA( &qh->fl, &cone ); /* merge the cone to the convex hull */
-  _zQHFacetListDestroy( &vs ); /* destroy visible set */
   return true;
 }
 
-/* discard old vertices inside of the convex hull. */
-static void _zQHDiscard(zQH *qh, zQHPointList *pl)
+/* create the convex hull of a set of points.
+ * The dimension of the set is returned, or -1 if it fails to allocate memory. */
+static int _zQHCreate(zQH *qh, int idx[], int num)
 {
-  zQHPointListCell *pc;
+  int dim;
 
-  zListAppend( pl, &qh->vl );
-  while( !zListIsEmpty(pl) ){
-    zListDeleteTail( pl, &pc );
-    if( pc->data.discard )
-      zFree( pc );
-    else
-      zListInsertHead( &qh->vl, pc );
-  }
+  if( ( dim = _zQHSimplex( qh, idx, num ) ) < 4 ) return dim;
+  return _zQHProcess( qh ) ? dim : -1;
 }
 
-/* create the convex hull of a point set. */
-static int _zQHCreate(zQH *qh, zQHPointList *pl)
+/* warn degeneracy of a set of points. */
+static void _zQHWarnDeg(int dim)
 {
-  zQHFacetListCell *fc;
-  int dim;
+  switch( dim ){
+  case 1: ZRUNWARN( ZEO_ERR_CH_DEG1 ); break;
+  case 2: ZRUNERROR( ZEO_ERR_CH_DEG2 ); break;
+  case 3: ZRUNERROR( ZEO_ERR_CH_DEG3 ); break;
+  default: ;
+  }
+}
 
-  /* initialize vertex & facet list */
-  zListInit( &qh->vl );
-  zListInit( &qh->fl );
-  /* create simplex */
-  if( ( dim = _zQHSimplex( qh, pl ) ) < 4 ) return dim;
-  _zQHFacetAssign( &qh->fl, pl ); /* initial beneath-beyond test */
-
-  /* incrementally generate new facets */
-  zListForEach( &qh->fl, fc )
-    if( !zListIsEmpty( &fc->data.op ) ){
-      if( !_zQHInc( qh, &fc->data ) ) break;
-      fc = zListRoot( &qh->fl ); /* retry from the tail */
-    }
+/* reset a workspace of quickhull to be reused for another set of points. */
+static void _zQHReset(zQH *qh)
+{
+  qh->fnum = 0;
+  qh->ffree = ZEO_QH_NONE;
+  qh->pending.num = 0;
+}
 
-  _zQHDiscard( qh, pl ); /* discard old vertices */
-  return dim;
+/* vertices of the convex hull. */
+static int _zQHVert(zQH *qh, int idx[])
+{
+  int num = 0;
+  register int i, j;
+
+  qh->stamp++;
+  for( i=0; i<qh->fnum; i++ ){
+    if( !_zQHFacetIsAlive( qh, i ) ) continue;
+    for( j=0; j<3; j++ )
+      if( qh->vstamp[qh->facet[i].v[j]] != qh->stamp ){
+        qh->vstamp[qh->facet[i].v[j]] = qh->stamp;
+        idx[num++] = qh->facet[i].v[j];
+      }
+  }
+  return num;
 }
 
-/* destroy the convex hull. */
-static void _zQHDestroy(zQH *qh)
+/* discard points strictly inside of the octahedron of extreme points. */
+static int _zQHPrefilter(zQH *qh, int idx[], int num)
 {
-  zListDestroy( zQHPointListCell, &qh->vl );
-  _zQHFacetListDestroy( &qh->fl );
+  int ext[6], fn = 0, n = 0;
+  zVec3D norm[8];
+  double d[8];
+  register int i, k;
+
+  if( num < 8 ) return num;
+  for( k=0; k<6; k++ ) ext[k] = idx[0];
+  for( i=1; i<num; i++ )
+    for( k=zX; k<=zZ; k++ ){
+      if( qh->p[idx[i]].e[k] < qh->p[ext[2*k]].e[k] ) ext[2*k] = idx[i];
+      if( qh->p[idx[i]].e[k] > qh->p[ext[2*k+1]].e[k] ) ext[2*k+1] = idx[i];
+    }
+  _zQHReset( qh );
+  if( _zQHCreate( qh, ext, 6 ) == 4 )
+    for( i=0; i<qh->fnum && fn<8; i++ )
+      if( _zQHFacetIsAlive( qh, i ) ){
+        zVec3DCopy( &qh->facet[i].n, &norm[fn] );
+        d[fn++] = qh->facet[i].d - qh->tol;
+      }
+  _zQHReset( qh );
+  if( fn < 4 ) return num; /* degenerate octahedron */
+  for( i=0; i<num; i++ ){
+    for( k=0; k<fn; k++ )
+      if( _zVec3DInnerProd( &norm[k], &qh->p[idx[i]] ) >= d[k] ) break;
+    if( k < fn ) idx[n++] = idx[i];
+  }
+  return n;
 }
 
 /* convert the convex hull to a polyhedron. */
 static zPH3D *_zQH2PH3D(zQH *qh, zPH3D *ph)
 {
-  zVec3D *vp;
-  zTri3D *fp;
-  zQHPointListCell *pc;
-  zQHFacetListCell *fc;
-
-  if( !zPH3DAlloc( ph, zListSize(&qh->vl), zListSize(&qh->fl) ) )
-    return NULL;
-  vp = zPH3DVertBuf(ph);
-  zListForEach( &qh->vl, pc ){
-    zVec3DCopy( pc->data.v, vp );
-    pc->data.v = vp++;
-  }
-  fp = zPH3DFaceBuf(ph);
-  zListForEach( &qh->fl, fc )
-    _zQHFacet2Tri3D( &fc->data, fp++ );
+  zQHFacet *f;
+  int vn = 0, fn = 0;
+  register int i, j;
+
+  qh->stamp++;
+  for( i=0; i<qh->fnum; i++ ){
+    if( !_zQHFacetIsAlive( qh, i ) ) continue;
+    for( f=&qh->facet[i], j=0; j<3; j++ )
+      if( qh->vstamp[f->v[j]] != qh->stamp ){
+        qh->vstamp[f->v[j]] = qh->stamp;
+        qh->vmap[f->v[j]] = vn++;
+      }
+    fn++;
+  }
+  if( !zPH3DAlloc( ph, vn, fn ) ) return NULL;
+  for( fn=0, i=0; i<qh->fnum; i++ ){
+    if( !_zQHFacetIsAlive( qh, i ) ) continue;
+    f = &qh->facet[i];
+    for( j=0; j<3; j++ )
+      zVec3DCopy( &qh->p[f->v[j]], zPH3DVert(ph,qh->vmap[f->v[j]]) );
+    zTri3DSetVert( zPH3DFace(ph,fn), 0, zPH3DVert(ph,qh->vmap[f->v[0]]) );
+    zTri3DSetVert( zPH3DFace(ph,fn), 1, zPH3DVert(ph,qh->vmap[f->v[1]]) );
+    zTri3DSetVert( zPH3DFace(ph,fn), 2, zPH3DVert(ph,qh->vmap[f->v[2]]) );
+    zTri3DSetNorm( zPH3DFace(ph,fn), &f->n );
+    fn++;
+  }
   return ph;
 }
 
-/* convex hull from list of 3D points. */
-zPH3D *zCH3DPL(zPH3D *ch, zVec3DList *vl)
+/* convex hull of 3D points. */
+zPH3D *zCH3D(zPH3D *ch, zVec3D p[], int num)
 {
-  zVec3DListCell *vc;
-  zQHPointListCell *pc;
-  zQHPointList pl;
   zQH qh;
-  int ret;
-
-  /* create point list */
-  zListInit( &pl );
-  zListForEach( vl, vc ){
-    if( !( pc = zAlloc( zQHPointListCell, 1 ) ) ) break;
-    _zQHPointCreate( &pc->data, vc->data );
-    zListInsertHead( &pl, pc );
-  }
-  /* quickhull */
-  if( ( ret = _zQHCreate( &qh, &pl ) ) < 4 ){
-    zListDestroy( zQHPointListCell, &pl );
-    if( ret == 3 ) /* planar convex hull */
-      return zCH2DPL2PH3D( ch, vl );
+  int *idx = NULL, dim;
+  register int i;
+
+  zPH3DInit( ch );
+  if( num <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  if( !_zQHInit( &qh, p, num ) || !( idx = zAlloc( int, num ) ) ){
+    _zQHDestroy( &qh );
     return NULL;
   }
-  /* convert to a polyhedron */
-  _zQH2PH3D( &qh, ch );
+  for( i=0; i<num; i++ ) idx[i] = i;
+  num = _zQHPrefilter( &qh, idx, num );
+  if( ( dim = _zQHCreate( &qh, idx, num ) ) < 4 ){
+    _zQHWarnDeg( dim );
+    ch = dim == 3 ? zCH2D2PH3D( ch, p, qh.num ) : NULL; /* planar convex hull */
+  } else
+    ch = _zQH2PH3D( &qh, ch );
   _zQHDestroy( &qh );
+  zFree( idx );
   return ch;
 }
 
-/* convex hull of 3D points. */
-zPH3D *zCH3D(zPH3D *ch, zVec3D p[], int num)
+/* convex hull from list of 3D points. */
+zPH3D *zCH3DPL(zPH3D *ch, zVec3DList *vl)
 {
-  zQHPointListCell *pc;
-  zQHPointList pl;
-  zQH qh;
-  register int i;
-  int ret;
+  zVec3DListCell *vc;
+  zVec3D *p;
+  int num = 0;
 
   zPH3DInit( ch );
-  /* create point list */
-  zListInit( &pl );
-  for( i=0; i<num; i++ ){
-    if( !( pc = zAlloc( zQHPointListCell, 1 ) ) ) break;
-    _zQHPointCreate( &pc->data, &p[i] );
-    zListInsertHead( &pl, pc );
-  }
-  /* quickhull */
-  if( ( ret = _zQHCreate( &qh, &pl ) ) < 4 ){
-    zListDestroy( zQHPointListCell, &pl );
-    if( ret == 3 ) /* planar convex hull */
-      return zCH2D2PH3D( ch, p, num );
+  if( zListIsEmpty( vl ) ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
     return NULL;
   }
-  /* convert to a polyhedron */
-  _zQH2PH3D( &qh, ch );
-  _zQHDestroy( &qh );
+  if( !( p = zAlloc( zVec3D, zListSize(vl) ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  zListForEach( vl, vc )
+    zVec3DCopy( vc->data, &p[num++] );
+  ch = zCH3D( ch, p, num );
+  zFree( p );
   return ch;
 }
 
-/* for debug */
-#ifdef DEBUG
-static void _zQHFacetInfo(zQHFacet *f)
+/* ********************************************************** */
+/* incremental convex hull
+ * ********************************************************** */
+
+/* initialize an incremental convex hull. */
+zCH3DInc *zCH3DIncInit(zCH3DInc *ch)
 {
-  printf( ">> facet:%p\n", f );
-  printf( "[vert#0] " ); zVec3DPrint( f->p[0]->v );
-  printf( "[vert#1] " ); zVec3DPrint( f->p[1]->v );
-  printf( "[vert#2] " ); zVec3DPrint( f->p[2]->v );
-  printf( "[contig#0] %p %g %s\n", f->c[0], zVec3DInnerProd(&f->n,&f->c[0]->n)-1, f->merge[0] ? " :merged" : "" );
-  printf( "[contig#1] %p %g %s\n", f->c[1], zVec3DInnerProd(&f->n,&f->c[1]->n)-1, f->merge[1] ? " :merged" : "" );
-  printf( "[contig#2] %p %g %s\n", f->c[2], zVec3DInnerProd(&f->n,&f->c[2]->n)-1, f->merge[2] ? " :merged" : "" );
-  printf( "normal vector: " ); zVec3DPrint( &f->n );
+  _zQHInit( &ch->qh, NULL, 0 );
+  ch->size = 0;
+  ch->dim = 0;
+  zVec3DZero( &ch->center );
+  ch->radius = 0;
+  ch->last = ZEO_QH_NONE;
+  return ch;
 }
 
-static void _zQHFacetListInfo(zQHFacetList *fl)
+/* destroy an incremental convex hull. */
+void zCH3DIncDestroy(zCH3DInc *ch)
 {
-  zQHFacetListCell *fc;
-
-  zListForEach( fl, fc )
-    _zQHFacetInfo( &fc->data );
+  zFree( ch->qh.p );
+  _zQHDestroy( &ch->qh );
+  zCH3DIncInit( ch );
 }
 
-static void _zQHPointListPrint(zQHPointList *pl, char filename[])
+/* enlarge arrays of points of an incremental convex hull. */
+static bool _zCH3DIncReserve(zCH3DInc *ch, int num)
 {
-  zQHPointListCell *pc;
-  FILE *fp;
+  zVec3D *p;
+  int *next, *vstamp, *vmap, size;
+
+  if( ch->qh.num + num <= ch->size ) return true;
+  size = _zMax( ch->size*2, ch->qh.num + num );
+  if( !( p = zRealloc( ch->qh.p, zVec3D, size ) ) ) goto FAILURE;
+  ch->qh.p = p;
+  if( !( next = zRealloc( ch->qh.next, int, size ) ) ) goto FAILURE;
+  ch->qh.next = next;
+  if( !( vstamp = zRealloc( ch->qh.vstamp, int, size ) ) ) goto FAILURE;
+  memset( vstamp+ch->size, 0, sizeof(int)*(size-ch->size) );
+  ch->qh.vstamp = vstamp;
+  if( !( vmap = zRealloc( ch->qh.vmap, int, size ) ) ) goto FAILURE;
+  ch->qh.vmap = vmap;
+  ch->size = size;
+  return true;
+ FAILURE:
+  ZALLOCERROR();
+  return false;
+}
 
-  fp = fopen( filename, "w" );
-  zListForEach( pl, pc )
-    zVec3DDataNLFPrint( fp, pc->data.v );
-  fclose( fp );
+/* find a facet which the ray from the center to a point passes. */
+static int _zCH3DIncLocate(zCH3DInc *ch, zVec3D *p)
+{
+  zQHFacet *f;
+  zVec3D d, e1, e2, n;
+  int cur, n_step = 0;
+  register int i, s;
+
+  if( ( cur = ch->last ) == ZEO_QH_NONE || !_zQHFacetIsAlive( &ch->qh, cur ) )
+    for( cur=0; cur<ch->qh.fnum; cur++ )
+      if( _zQHFacetIsAlive( &ch->qh, cur ) ) break;
+  _zVec3DSub( p, &ch->center, &d );
+  /* visibility walk on the hull projected from the center */
+  while( n_step++ < ch->qh.fnum ){
+    f = &ch->qh.facet[cur];
+    for( i=0; i<3; i++ ){
+      s = ( i + n_step ) % 3; /* rotate the first edge to avoid a cycle */
+      _zVec3DSub( &ch->qh.p[f->v[s]], &ch->center, &e1 );
+      _zVec3DSub( &ch->qh.p[f->v[(s+1)%3]], &ch->center, &e2 );
+      _zVec3DOuterProd( &e1, &e2, &n );
+      if( _zVec3DInnerProd( &n, &d ) < 0 ) break;
+    }
+    if( i == 3 ) return cur;
+    cur = f->c[s];
+  }
+  /* fall back to an exhaustive search */
+  for( cur=0; cur<ch->qh.fnum; cur++ )
+    if( _zQHFacetIsAlive( &ch->qh, cur ) &&
+        _zQHFacetDist( &ch->qh, &ch->qh.facet[cur], ch->qh.num ) > ch->qh.tol ) return cur;
+  return ZEO_QH_NONE;
 }
 
-static void _zQHFacetListPrint(zQHFacetList *fl, char filename[])
+/* update the radius of the inscribed ball of an incremental convex hull. */
+static void _zCH3DIncUpdateRadius(zCH3DInc *ch)
 {
-  zQHFacetListCell *fc;
-  FILE *fp;
+  double d;
+  register int i;
+
+  ch->radius = HUGE_VAL;
+  for( i=0; i<ch->qh.fnum; i++ )
+    if( _zQHFacetIsAlive( &ch->qh, i ) &&
+        ( d = ch->qh.facet[i].d - _zVec3DInnerProd( &ch->qh.facet[i].n, &ch->center ) ) < ch->radius )
+      ch->radius = d;
+}
 
-  fp = fopen( filename, "w" );
-  zListForEach( fl, fc ){
-    zVec3DDataNLFPrint( fp, fc->data.p[1]->v );
-    zVec3DDataNLFPrint( fp, fc->data.p[2]->v );
-    fprintf( fp, "\n" );
-    zVec3DDataNLFPrint( fp, fc->data.p[0]->v );
-    zVec3DDataNLFPrint( fp, fc->data.p[0]->v );
-    fprintf( fp, "\n\n" );
+/* discard points which are not vertices of an incremental convex hull. */
+static void _zCH3DIncCompact(zCH3DInc *ch)
+{
+  zQHFacet *f;
+  int num = 0;
+  register int i, j;
+
+  ch->qh.stamp++;
+  for( i=0; i<ch->qh.fnum; i++ )
+    if( _zQHFacetIsAlive( &ch->qh, i ) )
+      for( j=0; j<3; j++ )
+        ch->qh.vstamp[ch->qh.facet[i].v[j]] = ch->qh.stamp;
+  for( i=0; i<ch->qh.num; i++ ){
+    if( ch->qh.vstamp[i] != ch->qh.stamp ) continue;
+    if( num < i ) zVec3DCopy( &ch->qh.p[i], &ch->qh.p[num] );
+    ch->qh.vmap[i] = num++;
+  }
+  for( i=0; i<ch->qh.fnum; i++ ){
+    if( !_zQHFacetIsAlive( &ch->qh, i ) ) continue;
+    f = &ch->qh.facet[i];
+    for( j=0; j<3; j++ ) f->v[j] = ch->qh.vmap[f->v[j]];
   }
-  fclose(fp);
+  ch->qh.num = num;
 }
 
-static void _zQHPrint(zQH *qh)
+/* create the initial convex hull of points of an incremental convex hull. */
+static bool _zCH3DIncCreate(zCH3DInc *ch)
 {
-  zQHFacetListCell *fc;
-  zQHPointListCell *pc;
-  FILE *fp;
+  int *idx, num;
+  bool ret = true;
+  register int i, j;
 
-  _zQHFacetListPrint( &qh->fl, "ch" );
-  _zQHPointListPrint( &qh->vl, "chv" );
-  fp = fopen( "op", "w" );
-  zListForEach( &qh->fl, fc )
-    zListForEach( &fc->data.op, pc )
-      zVec3DDataNLFPrint( fp, pc->data.v );
-  fclose( fp );
+  if( !( idx = zAlloc( int, ch->qh.num ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  for( i=0; i<ch->qh.num; i++ ) idx[i] = i;
+  _zQHReset( &ch->qh );
+  if( ( ch->dim = _zQHCreate( &ch->qh, idx, ch->qh.num ) ) == 4 ){
+    /* the centroid of vertices is inside of the hull forever */
+    num = _zQHVert( &ch->qh, idx );
+    zVec3DZero( &ch->center );
+    for( j=0; j<num; j++ )
+      zVec3DAddDRC( &ch->center, &ch->qh.p[idx[j]] );
+    zVec3DDivDRC( &ch->center, num );
+    ch->last = ZEO_QH_NONE;
+    _zCH3DIncUpdateRadius( ch );
+    _zCH3DIncCompact( ch );
+  } else{
+    if( ch->dim < 0 ){ /* failed to allocate memory */
+      ch->dim = 0;
+      ret = false;
+    }
+    _zQHReset( &ch->qh );
+  }
+  zFree( idx );
+  return ret;
 }
 
-static void _zQHPrint2(zQH *qh)
+/* add points to an incremental convex hull. */
+int zCH3DIncAdd(zCH3DInc *ch, zVec3D p[], int num)
 {
-  zQHFacetListCell *fc;
-  zQHPointListCell *pc;
-  FILE *fp;
-  int i=0;
-  char filename[BUFSIZ];
+  int f, n = 0;
+  register int i;
 
-  _zQHFacetListPrint( &qh->fl, "ch" );
-  _zQHPointListPrint( &qh->vl, "chv" );
-  zListForEach( &qh->fl, fc ){
-    sprintf( filename, "op%03d", i );
-    fp = fopen( filename, "w" );
-    zListForEach( &fc->data.op, pc )
-      zVec3DDataNLFPrint( fp, pc->data.v );
-    fclose( fp );
-    i++;
+  if( !_zCH3DIncReserve( ch, num ) ) return -1;
+  if( ch->dim < 4 ){
+    for( i=0; i<num; i++ )
+      zVec3DCopy( &p[i], &ch->qh.p[ch->qh.num++] );
+    return _zCH3DIncCreate( ch ) ? ch->qh.num : -1;
+  }
+  for( i=0; i<num; i++ ){
+    if( zVec3DSqrDist( &p[i], &ch->center ) < zSqr( ch->radius - ch->qh.tol ) ) continue; /* inside of the inscribed ball */
+    zVec3DCopy( &p[i], &ch->qh.p[ch->qh.num] );
+    if( ( f = _zCH3DIncLocate( ch, &p[i] ) ) == ZEO_QH_NONE ||
+        !_zQHFacetAddPoint( &ch->qh, &ch->qh.facet[f], ch->qh.num ) ) continue; /* inside */
+    if( !_zQHIndexPush( &ch->qh.pending, f ) ) return -1;
+    ch->last = f;
+    ch->qh.num++;
+    n++;
+  }
+  if( n == 0 ) return ch->qh.num;
+  if( !_zQHProcess( &ch->qh ) ) return -1;
+  if( ch->qh.cone.num > 0 ) ch->last = ch->qh.cone.buf[ch->qh.cone.num-1];
+  _zCH3DIncUpdateRadius( ch );
+  _zCH3DIncCompact( ch );
+  return ch->qh.num;
+}
+
+/* convert an incremental convex hull to a polyhedron. */
+zPH3D *zCH3DInc2PH3D(zCH3DInc *ch, zPH3D *ph)
+{
+  zPH3DInit( ph );
+  if( ch->dim < 4 ){
+    _zQHWarnDeg( ch->dim );
+    return ch->dim == 3 ? zCH2D2PH3D( ph, ch->qh.p, ch->qh.num ) : NULL;
   }
+  return _zQH2PH3D( &ch->qh, ph );
 }
-#endif /* DEBUG */
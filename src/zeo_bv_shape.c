@@ -0,0 +1,231 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_bv_shape - bounding volume: cached bounding volumes of shapes.
+ */
+
+#include <zeo/zeo_bv.h>
+
+/* ********************************************************** */
+/* cached bounding volumes of a 3D shape
+ * ********************************************************** */
+
+/* invalidate cached bounding volumes of a 3D shape. */
+void zShape3DBVInvalidate(zShape3D *shape)
+{
+  if( !shape->bv ) return;
+  zPH3DDestroy( &shape->bv->ch );
+  shape->bv->flag = 0;
+}
+
+/* destroy cached bounding volumes of a 3D shape. */
+void zShape3DBVDestroy(zShape3D *shape)
+{
+  zShape3DBVInvalidate( shape );
+  zFree( shape->bv );
+}
+
+/* allocate cached bounding volumes of a 3D shape. */
+static zShape3DBV *_zShape3DBVAlloc(zShape3D *shape)
+{
+  if( shape->bv ) return shape->bv;
+  if( !( shape->bv = zAlloc( zShape3DBV, 1 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  zPH3DInit( &shape->bv->ch );
+  shape->bv->flag = 0;
+  return shape->bv;
+}
+
+/* vertices of a 3D shape, which are those of the convex hull if available. */
+static zVec3D *_zShape3DBVVert(zShape3D *shape, zPH3D *ph, int *num)
+{
+  if( zShape3DCH( shape ) ){
+    *num = zPH3DVertNum(&shape->bv->ch);
+    return zPH3DVertBuf(&shape->bv->ch);
+  }
+  if( !shape->bv ) return NULL;
+  if( shape->com == &zeo_shape3d_ph_com ){
+    *num = zPH3DVertNum(zShape3DPH(shape));
+    return zPH3DVertBuf(zShape3DPH(shape));
+  }
+  if( !shape->com->_toph( shape->body, ph ) ) return NULL;
+  *num = zPH3DVertNum(ph);
+  return zPH3DVertBuf(ph);
+}
+
+/* convex hull of a 3D shape. */
+zPH3D *zShape3DCH(zShape3D *shape)
+{
+  zPH3D ph, *src;
+
+  if( !_zShape3DBVAlloc( shape ) ) return NULL;
+  if( !( shape->bv->flag & ZEO_SHAPE_BV_CH ) ){
+    zPH3DInit( &ph );
+    if( shape->com == &zeo_shape3d_ph_com )
+      src = zShape3DPH(shape);
+    else
+      src = shape->com->_toph( shape->body, &ph );
+    if( !src ) return NULL;
+    if( !zCH3D( &shape->bv->ch, zPH3DVertBuf(src), zPH3DVertNum(src) ) )
+      zPH3DInit( &shape->bv->ch ); /* degenerated */
+    zPH3DDestroy( &ph );
+    shape->bv->flag |= ZEO_SHAPE_BV_CH;
+  }
+  return zPH3DVertNum(&shape->bv->ch) > 0 ? &shape->bv->ch : NULL;
+}
+
+/* axis-aligned bounding box of a 3D shape. */
+zAABox3D *zShape3DAABB(zShape3D *shape)
+{
+  zPH3D ph;
+  zVec3D *v;
+  int num;
+
+  if( !_zShape3DBVAlloc( shape ) ) return NULL;
+  if( !( shape->bv->flag & ZEO_SHAPE_BV_AABB ) ){
+    zPH3DInit( &ph );
+    if( !( v = _zShape3DBVVert( shape, &ph, &num ) ) ) return NULL;
+    if( !zAABB( &shape->bv->aabb, v, num, NULL ) ){
+      zPH3DDestroy( &ph );
+      return NULL;
+    }
+    zPH3DDestroy( &ph );
+    shape->bv->flag |= ZEO_SHAPE_BV_AABB;
+  }
+  return &shape->bv->aabb;
+}
+
+/* oriented bounding box of a 3D shape. */
+zBox3D *zShape3DOBB(zShape3D *shape)
+{
+  zPH3D ph;
+  zVec3D *v;
+  int num;
+
+  if( !_zShape3DBVAlloc( shape ) ) return NULL;
+  if( !( shape->bv->flag & ZEO_SHAPE_BV_OBB ) ){
+    zPH3DInit( &ph );
+    if( !( v = _zShape3DBVVert( shape, &ph, &num ) ) ) return NULL;
+    if( !zOBB( &shape->bv->obb, v, num ) ){
+      zPH3DDestroy( &ph );
+      return NULL;
+    }
+    zPH3DDestroy( &ph );
+    shape->bv->flag |= ZEO_SHAPE_BV_OBB;
+  }
+  return &shape->bv->obb;
+}
+
+/* bounding ball of a 3D shape. */
+zSphere3D *zShape3DBBall(zShape3D *shape)
+{
+  zPH3D ph;
+  zVec3D *v;
+  int num;
+
+  if( !_zShape3DBVAlloc( shape ) ) return NULL;
+  if( !( shape->bv->flag & ZEO_SHAPE_BV_BBALL ) ){
+    zPH3DInit( &ph );
+    if( !( v = _zShape3DBVVert( shape, &ph, &num ) ) ) return NULL;
+    if( zBBall( &shape->bv->bball, v, num, NULL ) == 0 ){
+      zPH3DDestroy( &ph );
+      return NULL;
+    }
+    zPH3DDestroy( &ph );
+    shape->bv->flag |= ZEO_SHAPE_BV_BBALL;
+  }
+  return &shape->bv->bball;
+}
+
+/* ********************************************************** */
+/* bounding volumes of multiple 3D shapes
+ * ********************************************************** */
+
+/* axis-aligned bounding box of multiple 3D shapes. */
+zAABox3D *zMShape3DAABB(zMShape3D *ms, zAABox3D *bb)
+{
+  zAABox3D *sbb;
+  register int i;
+
+  zAABox3DInit( bb );
+  if( zMShape3DShapeNum(ms) <= 0 ) return NULL;
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ){
+    if( !( sbb = zShape3DAABB( zMShape3DShape(ms,i) ) ) ) return NULL;
+    if( i == 0 )
+      zAABox3DCopy( sbb, bb );
+    else
+      zAABox3DMerge( bb, bb, sbb );
+  }
+  return bb;
+}
+
+/* vertices of convex hulls of multiple 3D shapes. */
+static zVec3D *_zMShape3DBVVert(zMShape3D *ms, int *num)
+{
+  zPH3D ph;
+  zVec3D *v = NULL, *sv, *vp;
+  int n;
+  register int i;
+
+  for( *num=0, i=0; i<zMShape3DShapeNum(ms); i++ ){
+    zPH3DInit( &ph );
+    if( !( sv = _zShape3DBVVert( zMShape3DShape(ms,i), &ph, &n ) ) ) goto FAILURE;
+    if( n > 0 ){
+      if( !( vp = zRealloc( v, zVec3D, *num + n ) ) ){
+        ZALLOCERROR();
+        zPH3DDestroy( &ph );
+        goto FAILURE;
+      }
+      memcpy( ( v = vp ) + *num, sv, sizeof(zVec3D)*n );
+      *num += n;
+    }
+    zPH3DDestroy( &ph );
+  }
+  if( *num <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  return v;
+
+ FAILURE:
+  zFree( v );
+  return NULL;
+}
+
+/* convex hull of multiple 3D shapes. */
+zPH3D *zMShape3DCH(zMShape3D *ms, zPH3D *ch)
+{
+  zVec3D *v;
+  int num;
+
+  if( !( v = _zMShape3DBVVert( ms, &num ) ) ) return NULL;
+  ch = zCH3D( ch, v, num );
+  zFree( v );
+  return ch;
+}
+
+/* oriented bounding box of multiple 3D shapes. */
+zBox3D *zMShape3DOBB(zMShape3D *ms, zBox3D *obb)
+{
+  zVec3D *v;
+  int num;
+
+  if( !( v = _zMShape3DBVVert( ms, &num ) ) ) return NULL;
+  obb = zOBB( obb, v, num );
+  zFree( v );
+  return obb;
+}
+
+/* bounding ball of multiple 3D shapes. */
+zSphere3D *zMShape3DBBall(zMShape3D *ms, zSphere3D *bb)
+{
+  zVec3D *v;
+  int num;
+
+  if( !( v = _zMShape3DBVVert( ms, &num ) ) ) return NULL;
+  zBBall( bb, v, num, NULL );
+  zFree( v );
+  return bb;
+}
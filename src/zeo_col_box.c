@@ -203,6 +203,238 @@ int zIntersectTriAABox3D(zTri3D *t, zAABox3D *box, zVec3D ip[])
   return n;
 }
 
+/* batch of axis-aligned boxes and triangles */
+
+/* allocate an array of triangles. */
+zTri3DSoA *zTri3DSoAAlloc(zTri3DSoA *soa, int num)
+{
+  register int i;
+
+  if( !( soa->buf = zAlloc( double, 9*num ) ) ){
+    ZALLOCERROR();
+    soa->num = 0;
+    return NULL;
+  }
+  for( i=0; i<9; i++ )
+    soa->v[i] = soa->buf + num*i;
+  soa->num = num;
+  return soa;
+}
+
+/* free an array of triangles. */
+void zTri3DSoAFree(zTri3DSoA *soa)
+{
+  zFree( soa->buf );
+  soa->num = 0;
+}
+
+/* set a triangle to an array of triangles. */
+zTri3DSoA *zTri3DSoASet(zTri3DSoA *soa, int i, zTri3D *tri)
+{
+  register int j, k;
+
+  if( i < 0 || i >= soa->num ){
+    ZRUNERROR( ZEO_ERR_INVINDEX );
+    return NULL;
+  }
+  for( j=0; j<3; j++ )
+    for( k=0; k<3; k++ )
+      soa->v[3*j+k][i] = zTri3DVert(tri,j)->e[k];
+  return soa;
+}
+
+/* an array of faces of a polyhedron. */
+zTri3DSoA *zTri3DSoAFromPH3D(zTri3DSoA *soa, zPH3D *ph)
+{
+  register int i;
+
+  if( !zTri3DSoAAlloc( soa, zPH3DFaceNum(ph) ) ) return NULL;
+  for( i=0; i<zPH3DFaceNum(ph); i++ )
+    zTri3DSoASet( soa, i, zPH3DFace(ph,i) );
+  return soa;
+}
+
+/* allocate an array of axis-aligned boxes. */
+zAABox3DSoA *zAABox3DSoAAlloc(zAABox3DSoA *soa, int num)
+{
+  register int i;
+
+  if( !( soa->buf = zAlloc( double, 6*num ) ) ){
+    ZALLOCERROR();
+    soa->num = 0;
+    return NULL;
+  }
+  for( i=0; i<3; i++ ){
+    soa->c[i] = soa->buf + num*i;
+    soa->e[i] = soa->buf + num*(i+3);
+  }
+  soa->num = num;
+  return soa;
+}
+
+/* free an array of axis-aligned boxes. */
+void zAABox3DSoAFree(zAABox3DSoA *soa)
+{
+  zFree( soa->buf );
+  soa->num = 0;
+}
+
+/* set an axis-aligned box to an array of axis-aligned boxes. */
+zAABox3DSoA *zAABox3DSoASet(zAABox3DSoA *soa, int i, zAABox3D *box)
+{
+  register int k;
+
+  if( i < 0 || i >= soa->num ){
+    ZRUNERROR( ZEO_ERR_INVINDEX );
+    return NULL;
+  }
+  for( k=0; k<3; k++ ){
+    soa->c[k][i] = 0.5 * ( box->max.e[k] + box->min.e[k] );
+    soa->e[k][i] = 0.5 * ( box->max.e[k] - box->min.e[k] );
+  }
+  return soa;
+}
+
+/* number of pairs of a triangle and a box to be checked in lockstep */
+#define ZEO_COL_TRIBOX_BLOCK 8
+
+/* minimum and maximum of three values */
+#define _zColMin3(a,b,c) _zMin( _zMin( a, b ), c )
+#define _zColMax3(a,b,c) _zMax( _zMax( a, b ), c )
+
+/* separating axis test of a block of pairs of triangles and axis-aligned
+ * boxes (T. Akenine-Moller, 2001). Components of triangles and boxes are
+ * given as arrays pt and pb, which are arranged in the same order with
+ * zTri3DSoA and zAABox3DSoA, respectively. Triangles are shared if st is
+ * zero, and boxes are shared if sb is zero. Each axis is tested on all
+ * pairs of the block in the innermost loop. */
+static unsigned char _zColChkTriAABox3DBlock(double *pt[], int st, double *pb[], int sb, int n)
+{
+  double v[3][3][ZEO_COL_TRIBOX_BLOCK], f[3][3][ZEO_COL_TRIBOX_BLOCK];
+  double e[3][ZEO_COL_TRIBOX_BLOCK], nx, ny, nz, p0, p1, p2, r;
+  unsigned char mask = 0;
+  int sep[ZEO_COL_TRIBOX_BLOCK], i, j, i1, i2;
+  register int l;
+
+  /* vertices relative to the centers of boxes and edges of triangles */
+  for( i=0; i<3; i++ )
+    for( l=0; l<n; l++ ){
+      e[i][l] = pb[i+3][l*sb];
+      for( j=0; j<3; j++ )
+        v[j][i][l] = pt[3*j+i][l*st] - pb[i][l*sb];
+    }
+  for( j=0; j<3; j++ )
+    for( i=0; i<3; i++ )
+      for( l=0; l<n; l++ )
+        f[j][i][l] = v[(j+1)%3][i][l] - v[j][i][l];
+  for( l=0; l<n; l++ ) sep[l] = 0;
+  /* faces of the boxes */
+  for( i=0; i<3; i++ )
+    for( l=0; l<n; l++ )
+      sep[l] |= _zColMin3( v[0][i][l], v[1][i][l], v[2][i][l] ) > e[i][l] ||
+                _zColMax3( v[0][i][l], v[1][i][l], v[2][i][l] ) < -e[i][l];
+  for( l=0; l<n && sep[l]; l++ );
+  if( l == n ) return 0;
+  /* faces of the triangles */
+  for( l=0; l<n; l++ ){
+    nx = f[0][1][l]*f[1][2][l] - f[0][2][l]*f[1][1][l];
+    ny = f[0][2][l]*f[1][0][l] - f[0][0][l]*f[1][2][l];
+    nz = f[0][0][l]*f[1][1][l] - f[0][1][l]*f[1][0][l];
+    sep[l] |= fabs( nx*v[0][0][l] + ny*v[0][1][l] + nz*v[0][2][l] ) >
+              e[0][l]*fabs(nx) + e[1][l]*fabs(ny) + e[2][l]*fabs(nz);
+  }
+  for( l=0; l<n && sep[l]; l++ );
+  if( l == n ) return 0;
+  /* cross products of edges of the boxes and the triangles */
+  for( i=0; i<3; i++ ){
+    i1 = (i+1)%3; i2 = (i+2)%3;
+    for( j=0; j<3; j++ )
+      for( l=0; l<n; l++ ){
+        p0 = v[0][i2][l]*f[j][i1][l] - v[0][i1][l]*f[j][i2][l];
+        p1 = v[1][i2][l]*f[j][i1][l] - v[1][i1][l]*f[j][i2][l];
+        p2 = v[2][i2][l]*f[j][i1][l] - v[2][i1][l]*f[j][i2][l];
+        r = e[i1][l]*fabs(f[j][i2][l]) + e[i2][l]*fabs(f[j][i1][l]);
+        sep[l] |= _zColMin3( p0, p1, p2 ) > r || _zColMax3( p0, p1, p2 ) < -r;
+      }
+  }
+  for( l=0; l<n; l++ )
+    if( !sep[l] ) mask |= 1 << l;
+  return mask;
+}
+
+/* count bits of a byte. */
+static int _zColBitmaskCount(unsigned char mask)
+{
+  int count;
+
+  for( count=0; mask; mask >>= 1 )
+    if( mask & 1 ) count++;
+  return count;
+}
+
+/* check if an axis-aligned box intersects with each of triangles in an array. */
+int zColChkTriAABox3DBatch(zTri3DSoA *tri, zAABox3D *box, unsigned char mask[])
+{
+  double b[6], *pb[6], *pt[9];
+  int i, count = 0;
+  register int k;
+
+  for( k=0; k<3; k++ ){
+    b[k]   = 0.5 * ( box->max.e[k] + box->min.e[k] );
+    b[k+3] = 0.5 * ( box->max.e[k] - box->min.e[k] );
+  }
+  for( k=0; k<6; k++ ) pb[k] = &b[k];
+  for( i=0; i<tri->num; i+=ZEO_COL_TRIBOX_BLOCK ){
+    for( k=0; k<9; k++ ) pt[k] = tri->v[k] + i;
+    mask[i/ZEO_COL_TRIBOX_BLOCK] = _zColChkTriAABox3DBlock( pt, 1, pb, 0, _zMin( ZEO_COL_TRIBOX_BLOCK, tri->num - i ) );
+    count += _zColBitmaskCount( mask[i/ZEO_COL_TRIBOX_BLOCK] );
+  }
+  return count;
+}
+
+/* check if a triangle intersects with each of axis-aligned boxes in an array. */
+int zColChkAABox3DTriBatch(zAABox3DSoA *box, zTri3D *tri, unsigned char mask[])
+{
+  double t[9], *pt[9], *pb[6];
+  int i, count = 0;
+  register int j, k;
+
+  for( j=0; j<3; j++ )
+    for( k=0; k<3; k++ )
+      t[3*j+k] = zTri3DVert(tri,j)->e[k];
+  for( k=0; k<9; k++ ) pt[k] = &t[k];
+  for( i=0; i<box->num; i+=ZEO_COL_TRIBOX_BLOCK ){
+    for( k=0; k<3; k++ ){
+      pb[k]   = box->c[k] + i;
+      pb[k+3] = box->e[k] + i;
+    }
+    mask[i/ZEO_COL_TRIBOX_BLOCK] = _zColChkTriAABox3DBlock( pt, 0, pb, 1, _zMin( ZEO_COL_TRIBOX_BLOCK, box->num - i ) );
+    count += _zColBitmaskCount( mask[i/ZEO_COL_TRIBOX_BLOCK] );
+  }
+  return count;
+}
+
+/* check if a plane intersects with each of axis-aligned boxes in an array. */
+int zColChkPlaneAABox3DBatch(zPlane3D *p, zAABox3DSoA *box, unsigned char mask[])
+{
+  double d, an[3];
+  int i, n, count = 0;
+  register int k, l;
+
+  d = zVec3DInnerProd( zPlane3DNorm(p), zPlane3DVert(p) );
+  for( k=0; k<3; k++ ) an[k] = fabs( zPlane3DNorm(p)->e[k] );
+  for( i=0; i<box->num; i+=ZEO_COL_TRIBOX_BLOCK ){
+    n = _zMin( ZEO_COL_TRIBOX_BLOCK, box->num - i );
+    mask[i/ZEO_COL_TRIBOX_BLOCK] = 0;
+    for( l=0; l<n; l++ )
+      if( fabs( zPlane3DNorm(p)->c.x*box->c[zX][i+l] + zPlane3DNorm(p)->c.y*box->c[zY][i+l] + zPlane3DNorm(p)->c.z*box->c[zZ][i+l] - d )
+          <= an[zX]*box->e[zX][i+l] + an[zY]*box->e[zY][i+l] + an[zZ]*box->e[zZ][i+l] )
+        mask[i/ZEO_COL_TRIBOX_BLOCK] |= 1 << l;
+    count += _zColBitmaskCount( mask[i/ZEO_COL_TRIBOX_BLOCK] );
+  }
+  return count;
+}
+
 /* check if two axis-aligned boxes intersect with each other. */
 bool zColChkAABox3D(zAABox3D *b1, zAABox3D *b2)
 {
@@ -240,63 +472,230 @@ zAABox3D *zIntersectPH3DBox(zPH3D *ph1, zPH3D *ph2, zAABox3D *box)
 
 /* box vs box */
 
-/* deflated collision checking along an axis on a box. */
-static bool _zColChkBox3DAlong(zBox3D *b1, zDir axis, zBox3D *b2, zVec3D *l)
+/* separating axis test of two boxes, where the rotation matrix from
+ * the first box to the second, its absolute values and the relative
+ * position of the second box center in the first box frame are given
+ * (S. Gottschalk, M. C. Lin and D. Manocha, 1996). */
+static bool _zColChkBox3DSAT(double r[3][3], double ar[3][3], double t[], double ea[], double eb[])
+{
+  register int i, j;
+
+  /* faces of the first box */
+  for( i=0; i<3; i++ )
+    if( fabs( t[i] ) >= ea[i] + eb[0]*ar[i][0] + eb[1]*ar[i][1] + eb[2]*ar[i][2] ) return false;
+  /* faces of the second box */
+  for( j=0; j<3; j++ )
+    if( fabs( t[0]*r[0][j] + t[1]*r[1][j] + t[2]*r[2][j] ) >= ea[0]*ar[0][j] + ea[1]*ar[1][j] + ea[2]*ar[2][j] + eb[j] ) return false;
+  /* cross products of edges */
+  for( i=0; i<3; i++ )
+    for( j=0; j<3; j++ )
+      if( fabs( t[(i+2)%3]*r[(i+1)%3][j] - t[(i+1)%3]*r[(i+2)%3][j] ) >=
+          ea[(i+1)%3]*ar[(i+2)%3][j] + ea[(i+2)%3]*ar[(i+1)%3][j] +
+          eb[(j+1)%3]*ar[i][(j+2)%3] + eb[(j+2)%3]*ar[i][(j+1)%3] ) return false;
+  return true;
+}
+
+/* check if two (oriented) boxes intersect with each other. */
+bool zColChkBox3D(zBox3D *b1, zBox3D *b2)
+{
+  double r[3][3], ar[3][3], t[3], ea[3], eb[3];
+  zVec3D l;
+  register int i, j;
+
+  zVec3DSub( zBox3DCenter(b2), zBox3DCenter(b1), &l );
+  for( i=0; i<3; i++ ){
+    for( j=0; j<3; j++ ){
+      r[i][j] = _zVec3DInnerProd( zBox3DAxis(b1,i), zBox3DAxis(b2,j) );
+      ar[i][j] = fabs( r[i][j] ) + zTOL; /* to deal with parallel edges */
+    }
+    t[i] = _zVec3DInnerProd( &l, zBox3DAxis(b1,i) );
+    ea[i] = 0.5 * zBox3DDia(b1,i);
+    eb[i] = 0.5 * zBox3DDia(b2,i);
+  }
+  return _zColChkBox3DSAT( r, ar, t, ea, eb );
+}
+
+/* box array in the structure-of-arrays layout */
+
+/* allocate an array of boxes. */
+zBox3DSoA *zBox3DSoAAlloc(zBox3DSoA *soa, int num)
 {
-  zVec3D *a;
-  double d;
+  register int i;
+
+  if( !( soa->buf = zAlloc( double, ZEO_BOX3DSOA_ELEM_NUM*num ) ) ){
+    ZALLOCERROR();
+    soa->num = 0;
+    return NULL;
+  }
+  for( i=0; i<3; i++ ){
+    soa->c[i] = soa->buf + num*i;
+    soa->e[i] = soa->buf + num*(i+3);
+  }
+  for( i=0; i<9; i++ )
+    soa->ax[i] = soa->buf + num*(i+6);
+  soa->num = num;
+  return soa;
+}
 
-  a = zBox3DAxis( b1, axis );
-  d = 0.5*
-     ( fabs( zVec3DInnerProd(zBox3DAxis(b2,zX),a) )*zBox3DDepth(b2)
-     + fabs( zVec3DInnerProd(zBox3DAxis(b2,zY),a) )*zBox3DWidth(b2)
-     + fabs( zVec3DInnerProd(zBox3DAxis(b2,zZ),a) )*zBox3DHeight(b2)
-     + zBox3DDia(b1,axis) );
-  return fabs( zVec3DInnerProd(l,a) ) < d ? true : false;
+/* free an array of boxes. */
+void zBox3DSoAFree(zBox3DSoA *soa)
+{
+  zFree( soa->buf );
+  soa->num = 0;
 }
 
-/* deflated collision checking along an axis perpendicular to edges on boxes. */
-static bool _zColChkBox3DPerp(zBox3D *b1, zDir ax1, zBox3D *b2, zDir ax2, zVec3D *l)
+/* set a box to an array of boxes. */
+zBox3DSoA *zBox3DSoASet(zBox3DSoA *soa, int i, zBox3D *box)
 {
-  zVec3D p;
-  zDir ax12, ax13, ax22, ax23;
-  double d;
+  register int j, k;
 
-  zVec3DOuterProd( zBox3DAxis(b1,ax1), zBox3DAxis(b2,ax2), &p );
-  if( zVec3DIsTiny( &p ) )
-    return true; /* parallel edges, should have been already checked. */
-  zVec3DNormalizeDRC( &p );
-  ax12 = ( ax1 + 1 ) % 3;
-  ax13 = ( ax1 + 2 ) % 3;
-  ax22 = ( ax2 + 1 ) % 3;
-  ax23 = ( ax2 + 2 ) % 3;
-  d = 0.5*
-    ( fabs( zVec3DInnerProd(zBox3DAxis(b1,ax12),&p) )*zBox3DDia(b1,ax12)
-    + fabs( zVec3DInnerProd(zBox3DAxis(b1,ax13),&p) )*zBox3DDia(b1,ax13)
-    + fabs( zVec3DInnerProd(zBox3DAxis(b2,ax22),&p) )*zBox3DDia(b2,ax22)
-    + fabs( zVec3DInnerProd(zBox3DAxis(b2,ax23),&p) )*zBox3DDia(b2,ax23) );
-  return fabs( zVec3DInnerProd(l,&p) ) < d ? true : false;
+  if( i < 0 || i >= soa->num ){
+    ZRUNERROR( ZEO_ERR_INVINDEX );
+    return NULL;
+  }
+  for( j=0; j<3; j++ ){
+    soa->c[j][i] = zBox3DCenter(box)->e[j];
+    soa->e[j][i] = 0.5 * zBox3DDia(box,j);
+    for( k=0; k<3; k++ )
+      soa->ax[3*j+k][i] = zBox3DAxis(box,j)->e[k];
+  }
+  return soa;
 }
 
-/* check if two (oriented) boxes intersect with each other. */
-bool zColChkBox3D(zBox3D *b1, zBox3D *b2)
+/* get a box from an array of boxes. */
+zBox3D *zBox3DSoAGet(zBox3DSoA *soa, int i, zBox3D *box)
 {
-  zVec3D l;
+  register int j, k;
 
-  zVec3DSub( zBox3DCenter(b1), zBox3DCenter(b2), &l );
-  return !_zColChkBox3DAlong( b1, zX, b2, &l ) ||
-         !_zColChkBox3DAlong( b1, zY, b2, &l ) ||
-         !_zColChkBox3DAlong( b1, zZ, b2, &l ) ||
-         !_zColChkBox3DAlong( b2, zX, b1, &l ) ||
-         !_zColChkBox3DAlong( b2, zY, b1, &l ) ||
-         !_zColChkBox3DAlong( b2, zZ, b1, &l ) ||
-         !_zColChkBox3DPerp( b1, zX, b2, zX, &l ) ||
-         !_zColChkBox3DPerp( b1, zY, b2, zX, &l ) ||
-         !_zColChkBox3DPerp( b1, zZ, b2, zX, &l ) ||
-         !_zColChkBox3DPerp( b1, zX, b2, zY, &l ) ||
-         !_zColChkBox3DPerp( b1, zY, b2, zY, &l ) ||
-         !_zColChkBox3DPerp( b1, zZ, b2, zY, &l ) ||
-         !_zColChkBox3DPerp( b1, zX, b2, zZ, &l ) ||
-         !_zColChkBox3DPerp( b1, zY, b2, zZ, &l ) ||
-         !_zColChkBox3DPerp( b1, zZ, b2, zZ, &l ) ? false : true;
+  if( i < 0 || i >= soa->num ){
+    ZRUNERROR( ZEO_ERR_INVINDEX );
+    return NULL;
+  }
+  for( j=0; j<3; j++ ){
+    zBox3DCenter(box)->e[j] = soa->c[j][i];
+    zBox3DSetDia( box, j, 2 * soa->e[j][i] );
+    for( k=0; k<3; k++ )
+      zBox3DAxis(box,j)->e[k] = soa->ax[3*j+k][i];
+  }
+  return box;
+}
+
+/* pointers to components of boxes in an array from the i-th box. */
+static void _zBox3DSoAComp(zBox3DSoA *soa, int i, double *p[])
+{
+  register int k;
+
+  for( k=0; k<3; k++ ){
+    p[k]   = soa->c[k] + i;
+    p[k+3] = soa->e[k] + i;
+  }
+  for( k=0; k<9; k++ )
+    p[k+6] = soa->ax[k] + i;
+}
+
+/* number of pairs of boxes to be checked in lockstep */
+#define ZEO_COL_BOX_BLOCK 4
+
+/* separating axis test of a block of pairs of boxes. Components of
+ * boxes are given as arrays pa and pb, which are arranged in the same
+ * order with zBox3DSoA. The first boxes are shared if sa is zero. */
+static int _zColChkBox3DBlock(double *pa[], int sa, double *pb[], int n, bool result[])
+{
+  double r[3][3][ZEO_COL_BOX_BLOCK], ar[3][3][ZEO_COL_BOX_BLOCK];
+  double t[3][ZEO_COL_BOX_BLOCK], d[3];
+  double tl, ra, rb;
+  int sep[ZEO_COL_BOX_BLOCK], i, j, i1, i2, j1, j2, count;
+  register int l, la;
+
+#define ea(k,l) pa[3+(k)][(l)*sa]
+#define eb(k,l) pb[3+(k)][(l)]
+  /* relative rotation and position */
+  for( l=0; l<n; l++ ){
+    la = l * sa;
+    d[0] = pb[0][l] - pa[0][la];
+    d[1] = pb[1][l] - pa[1][la];
+    d[2] = pb[2][l] - pa[2][la];
+    for( i=0; i<3; i++ ){
+      for( j=0; j<3; j++ ){
+        r[i][j][l] = pa[6+3*i][la]*pb[6+3*j][l] + pa[7+3*i][la]*pb[7+3*j][l] + pa[8+3*i][la]*pb[8+3*j][l];
+        ar[i][j][l] = fabs( r[i][j][l] ) + zTOL;
+      }
+      t[i][l] = d[0]*pa[6+3*i][la] + d[1]*pa[7+3*i][la] + d[2]*pa[8+3*i][la];
+    }
+    sep[l] = 0;
+  }
+  /* faces of the first boxes */
+  for( i=0; i<3; i++ )
+    for( l=0; l<n; l++ )
+      sep[l] |= fabs( t[i][l] ) >= ea(i,l) + eb(0,l)*ar[i][0][l] + eb(1,l)*ar[i][1][l] + eb(2,l)*ar[i][2][l];
+  for( l=0; l<n && sep[l]; l++ );
+  if( l == n ) goto TERMINATE;
+  /* faces of the second boxes */
+  for( j=0; j<3; j++ )
+    for( l=0; l<n; l++ ){
+      tl = t[0][l]*r[0][j][l] + t[1][l]*r[1][j][l] + t[2][l]*r[2][j][l];
+      ra = ea(0,l)*ar[0][j][l] + ea(1,l)*ar[1][j][l] + ea(2,l)*ar[2][j][l];
+      sep[l] |= fabs( tl ) >= ra + eb(j,l);
+    }
+  for( l=0; l<n && sep[l]; l++ );
+  if( l == n ) goto TERMINATE;
+  /* cross products of edges */
+  for( i=0; i<3; i++ ){
+    i1 = ( i + 1 ) % 3; i2 = ( i + 2 ) % 3;
+    for( j=0; j<3; j++ ){
+      j1 = ( j + 1 ) % 3; j2 = ( j + 2 ) % 3;
+      for( l=0; l<n; l++ ){
+        tl = t[i2][l]*r[i1][j][l] - t[i1][l]*r[i2][j][l];
+        ra = ea(i1,l)*ar[i2][j][l] + ea(i2,l)*ar[i1][j][l];
+        rb = eb(j1,l)*ar[i][j2][l] + eb(j2,l)*ar[i][j1][l];
+        sep[l] |= fabs( tl ) >= ra + rb;
+      }
+    }
+  }
+#undef ea
+#undef eb
+ TERMINATE:
+  for( count=0, l=0; l<n; l++ )
+    if( ( result[l] = !sep[l] ) ) count++;
+  return count;
+}
+
+/* check if pairs of boxes in two arrays intersect with each other. */
+int zColChkBox3DBatch(zBox3DSoA *soa1, zBox3DSoA *soa2, bool result[])
+{
+  double *pa[ZEO_BOX3DSOA_ELEM_NUM], *pb[ZEO_BOX3DSOA_ELEM_NUM];
+  int i, count = 0;
+
+  if( soa1->num != soa2->num ){
+    ZRUNERROR( ZEO_ERR_COL_BOX_SIZMIS );
+    return -1;
+  }
+  for( i=0; i<soa1->num; i+=ZEO_COL_BOX_BLOCK ){
+    _zBox3DSoAComp( soa1, i, pa );
+    _zBox3DSoAComp( soa2, i, pb );
+    count += _zColChkBox3DBlock( pa, 1, pb, _zMin( ZEO_COL_BOX_BLOCK, soa1->num - i ), &result[i] );
+  }
+  return count;
+}
+
+/* check if a box intersects with each of boxes in an array. */
+int zColChkBox3DBatchOne(zBox3D *box, zBox3DSoA *soa, bool result[])
+{
+  double a[ZEO_BOX3DSOA_ELEM_NUM], *pa[ZEO_BOX3DSOA_ELEM_NUM], *pb[ZEO_BOX3DSOA_ELEM_NUM];
+  int i, count = 0;
+  register int k;
+
+  for( k=0; k<3; k++ ){
+    a[k]   = zBox3DCenter(box)->e[k];
+    a[k+3] = 0.5 * zBox3DDia(box,k);
+    a[3*k+6] = zBox3DAxis(box,k)->c.x;
+    a[3*k+7] = zBox3DAxis(box,k)->c.y;
+    a[3*k+8] = zBox3DAxis(box,k)->c.z;
+  }
+  for( k=0; k<ZEO_BOX3DSOA_ELEM_NUM; k++ ) pa[k] = &a[k];
+  for( i=0; i<soa->num; i+=ZEO_COL_BOX_BLOCK ){
+    _zBox3DSoAComp( soa, i, pb );
+    count += _zColChkBox3DBlock( pa, 0, pb, _zMin( ZEO_COL_BOX_BLOCK, soa->num - i ), &result[i] );
+  }
+  return count;
 }
@@ -6,6 +6,31 @@
 
 #include <zeo/zeo_elem.h>
 
+/* ********************************************************** */
+/* CLASS: zRay3D
+ * 3D ray class
+ * ********************************************************** */
+
+/* create a 3D ray. */
+zRay3D *zRay3DCreate(zRay3D *ray, zVec3D *org, zVec3D *dir)
+{
+  if( zVec3DNormalize( dir, zRay3DDir(ray) ) < 0 ){
+    ZRUNERROR( ZEO_ERR_ELEM_DEGR );
+    return NULL;
+  }
+  zVec3DCopy( org, zRay3DOrg(ray) );
+  /* an infinite reciprocal is valid for slab tests */
+  zVec3DCreate( zRay3DIDir(ray),
+    1.0 / ray->dir.c.x, 1.0 / ray->dir.c.y, 1.0 / ray->dir.c.z );
+  return ray;
+}
+
+/* a point on a ray. */
+zVec3D *zRay3DPoint(zRay3D *ray, double t, zVec3D *p)
+{
+  return zVec3DCat( zRay3DOrg(ray), t, zRay3DDir(ray), p );
+}
+
 /* ********************************************************** */
 /* CLASS: zPlane3D
  * 3D plane class
@@ -78,6 +103,20 @@ zPlane3D *zPlane3DMean(zPlane3D *pl, zVec3D *pc, zVec3D v[], int n)
   return zPlane3DCreate( pl, pc, &evec[i] );
 }
 
+/* intersection of a ray and a plane. */
+bool zPlane3DRaycast(zPlane3D *p, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D d;
+  double den, s;
+
+  if( zIsTiny( ( den = zVec3DInnerProd( zRay3DDir(ray), zPlane3DNorm(p) ) ) ) ) return false;
+  zVec3DSub( zPlane3DVert(p), zRay3DOrg(ray), &d );
+  if( ( s = zVec3DInnerProd( &d, zPlane3DNorm(p) ) / den ) < 0 || s >= *t ) return false;
+  *t = s;
+  if( norm ) zVec3DCopy( zPlane3DNorm(p), norm );
+  return true;
+}
+
 /* print information of a plane to a file. */
 void zPlane3DFPrint(FILE *fp, zPlane3D *p)
 {
@@ -520,6 +559,26 @@ double zTri3DClosest(zTri3D *t, zVec3D *v, zVec3D *cp)
   return zVec3DDist( v, cp );
 }
 
+/* intersection of a ray and a triangle. */
+bool zTri3DRaycast(zTri3D *tri, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D e1, e2, d, pv, qv;
+  double det, u, v, s;
+
+  zVec3DSub( zTri3DVert(tri,1), zTri3DVert(tri,0), &e1 );
+  zVec3DSub( zTri3DVert(tri,2), zTri3DVert(tri,0), &e2 );
+  zVec3DOuterProd( zRay3DDir(ray), &e2, &pv );
+  if( zIsTiny( ( det = zVec3DInnerProd( &e1, &pv ) ) ) ) return false;
+  zVec3DSub( zRay3DOrg(ray), zTri3DVert(tri,0), &d );
+  if( ( u = zVec3DInnerProd( &d, &pv ) / det ) < 0 || u > 1 ) return false;
+  zVec3DOuterProd( &d, &e1, &qv );
+  if( ( v = zVec3DInnerProd( zRay3DDir(ray), &qv ) / det ) < 0 || u + v > 1 ) return false;
+  if( ( s = zVec3DInnerProd( &e2, &qv ) / det ) < 0 || s >= *t ) return false;
+  *t = s;
+  if( norm ) zVec3DCopy( zTri3DNorm(tri), norm );
+  return true;
+}
+
 /* volume of a cone. */
 double zTri3DConeVolume(zTri3D *t, zVec3D *v)
 {
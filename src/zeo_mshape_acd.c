@@ -0,0 +1,514 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_acd - approximate convex decomposition of a polyhedron.
+ */
+
+#include <zeo/zeo_mshape.h>
+#include <zeo/zeo_bv.h>
+
+/* ********************************************************** */
+/* approximate convex decomposition
+ * ********************************************************** */
+
+#define ZEO_ACD_EVAL_MAX 2000 /* maximum number of points to evaluate a cutting plane */
+
+/* initialize parameters of approximate convex decomposition. */
+zACDParam *zACDParamInit(zACDParam *param)
+{
+  param->resolution = 64;
+  param->concavity = 0.01;
+  param->max_piece = 32;
+  param->plane_num = 8;
+  return param;
+}
+
+/* piece of a polyhedron. */
+typedef struct{
+  int *idx;          /* indices of points */
+  int num;           /* number of points */
+  double concavity;  /* concavity */
+  zVec3D vmin, vmax; /* bounding box */
+} _zACDPiece;
+
+/* workspace of approximate convex decomposition. */
+typedef struct{
+  zVec3D *p;     /* voxels inside and samples on the surface */
+  int num;       /* number of points */
+  int voxnum;    /* number of voxels, which are at the head of p */
+  double vv;     /* volume of a voxel */
+  double vol;    /* volume of the polyhedron */
+  zVec3D *buf;   /* buffer of points to compute convex hulls */
+  int *side;     /* buffer of indices to split a piece */
+  zACDParam *param;
+} _zACD;
+
+/* voxelize the inside and sample the surface of a polyhedron. */
+static bool _zACDSample(_zACD *acd, zPH3D *ph)
+{
+  zPH3DBVH bvh;
+  zVec3D vmin, vmax, p, e1, e2;
+  double pitch, l;
+  int n[3], size, i, j, k, m, ns;
+  zTri3D *t;
+  bool ret = false;
+
+  zVec3DCopy( zPH3DVert(ph,0), &vmin );
+  zVec3DCopy( zPH3DVert(ph,0), &vmax );
+  for( i=1; i<zPH3DVertNum(ph); i++ )
+    for( k=zX; k<=zZ; k++ ){
+      if( zPH3DVert(ph,i)->e[k] < vmin.e[k] ) vmin.e[k] = zPH3DVert(ph,i)->e[k];
+      if( zPH3DVert(ph,i)->e[k] > vmax.e[k] ) vmax.e[k] = zPH3DVert(ph,i)->e[k];
+    }
+  zVec3DSub( &vmax, &vmin, &p );
+  if( ( pitch = _zMax( p.c.x, _zMax( p.c.y, p.c.z ) ) / acd->param->resolution ) <= 0 ) return false;
+  acd->vv = pitch * pitch * pitch;
+  for( size=1, k=zX; k<=zZ; k++ ) size *= ( n[k] = (int)( p.e[k] / pitch ) + 1 );
+  /* count surface samples */
+  for( ns=0, i=0; i<zPH3DFaceNum(ph); i++ ){
+    t = zPH3DFace(ph,i);
+    zVec3DSub( zTri3DVert(t,1), zTri3DVert(t,0), &e1 );
+    zVec3DSub( zTri3DVert(t,2), zTri3DVert(t,0), &e2 );
+    l = _zMax( zVec3DNorm(&e1), zVec3DNorm(&e2) );
+    m = (int)ceil( l / pitch );
+    ns += ( m + 1 )*( m + 2 ) / 2;
+  }
+  if( !( acd->p = zAlloc( zVec3D, size + ns ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  if( !zPH3DBVHBuild( &bvh, ph ) ) return false;
+  /* voxels inside */
+  acd->num = 0;
+  for( k=0; k<n[2]; k++ )
+    for( j=0; j<n[1]; j++ )
+      for( i=0; i<n[0]; i++ ){
+        zVec3DCreate( &p, vmin.c.x+(i+0.5)*pitch, vmin.c.y+(j+0.5)*pitch, vmin.c.z+(k+0.5)*pitch );
+        if( zPH3DBVHPointIsInside( &bvh, &p, true ) )
+          zVec3DCopy( &p, &acd->p[acd->num++] );
+      }
+  if( ( acd->voxnum = acd->num ) == 0 ){
+    ZRUNWARN( ZEO_WARN_ACD_NOVOLUME );
+    goto TERMINATE;
+  }
+  acd->vol = acd->voxnum * acd->vv;
+  /* samples on the surface */
+  for( i=0; i<zPH3DFaceNum(ph); i++ ){
+    t = zPH3DFace(ph,i);
+    zVec3DSub( zTri3DVert(t,1), zTri3DVert(t,0), &e1 );
+    zVec3DSub( zTri3DVert(t,2), zTri3DVert(t,0), &e2 );
+    l = _zMax( zVec3DNorm(&e1), zVec3DNorm(&e2) );
+    m = (int)ceil( l / pitch );
+    for( j=0; j<=m; j++ )
+      for( k=0; j+k<=m; k++ ){
+        zVec3DCat( zTri3DVert(t,0), (double)j/m, &e1, &p );
+        zVec3DCat( &p, (double)k/m, &e2, &acd->p[acd->num++] );
+      }
+  }
+  ret = true;
+ TERMINATE:
+  zPH3DBVHDestroy( &bvh );
+  return ret;
+}
+
+/* check if points are degenerated onto a plane. */
+static bool _zACDIsFlat(zVec3D p[], int num)
+{
+  zVec3D e1, e2, n;
+  double d, dmax;
+  int i1 = 0, i2 = 0;
+  register int i;
+
+  for( dmax=0, i=1; i<num; i++ )
+    if( ( d = zVec3DSqrDist( &p[i], &p[0] ) ) > dmax ){
+      dmax = d; i1 = i;
+    }
+  zVec3DSub( &p[i1], &p[0], &e1 );
+  for( dmax=0, i=1; i<num; i++ ){
+    zVec3DSub( &p[i], &p[0], &e2 );
+    zVec3DOuterProd( &e1, &e2, &n );
+    if( ( d = zVec3DSqrNorm( &n ) ) > dmax ){
+      dmax = d; i2 = i;
+    }
+  }
+  zVec3DSub( &p[i2], &p[0], &e2 );
+  zVec3DOuterProd( &e1, &e2, &n );
+  if( zVec3DIsTiny( &n ) ) return true;
+  zVec3DNormalizeDRC( &n );
+  for( i=1; i<num; i++ ){
+    zVec3DSub( &p[i], &p[0], &e2 );
+    if( !zIsTiny( zVec3DInnerProd( &n, &e2 ) ) ) return false;
+  }
+  return true;
+}
+
+/* volume of the convex hull of points. */
+static double _zACDHullVolume(zVec3D p[], int num)
+{
+  zPH3D ch;
+  double vol;
+
+  if( num < 4 || _zACDIsFlat( p, num ) || !zCH3D( &ch, p, num ) ) return 0;
+  vol = zPH3DVolume( &ch );
+  zPH3DDestroy( &ch );
+  return fabs( vol );
+}
+
+/* concavity of a set of points, each of which represents a given number of points. */
+static double _zACDConcavity(_zACD *acd, int idx[], int num, int weight)
+{
+  int vox = 0;
+  register int i;
+
+  for( i=0; i<num; i++ ){
+    zVec3DCopy( &acd->p[idx[i]], &acd->buf[i] );
+    if( idx[i] < acd->voxnum ) vox++;
+  }
+  return _zMax( _zACDHullVolume( acd->buf, num ) - vox * weight * acd->vv, 0 ) / acd->vol;
+}
+
+/* update the concavity and the bounding box of a piece. */
+static void _zACDPieceUpdate(_zACD *acd, _zACDPiece *piece)
+{
+  register int i, k;
+
+  zVec3DCopy( &acd->p[piece->idx[0]], &piece->vmin );
+  zVec3DCopy( &acd->p[piece->idx[0]], &piece->vmax );
+  for( i=1; i<piece->num; i++ )
+    for( k=zX; k<=zZ; k++ ){
+      if( acd->p[piece->idx[i]].e[k] < piece->vmin.e[k] ) piece->vmin.e[k] = acd->p[piece->idx[i]].e[k];
+      if( acd->p[piece->idx[i]].e[k] > piece->vmax.e[k] ) piece->vmax.e[k] = acd->p[piece->idx[i]].e[k];
+    }
+  piece->concavity = _zACDConcavity( acd, piece->idx, piece->num, 1 );
+}
+
+/* partition indices of a piece by a plane; returns the number of indices on the lower side. */
+static int _zACDPartition(_zACD *acd, int idx[], int num, zAxis axis, double pos)
+{
+  int l, r;
+
+  for( l=0, r=num-1; l<=r; ){
+    if( acd->p[idx[l]].e[axis] < pos ) l++;
+    else{
+      zSwap( int, idx[l], idx[r] );
+      r--;
+    }
+  }
+  return l;
+}
+
+/* split a piece into two by the best cutting plane; returns false if no plane splits it. */
+static bool _zACDSplit(_zACD *acd, _zACDPiece *piece, _zACDPiece *sub)
+{
+  zAxis axis, best_axis = zX;
+  double pos, best_pos = 0, cost, best_cost = HUGE_VAL;
+  int stride, ns, nl;
+  register int i, k;
+
+  /* candidate planes are evaluated with points subsampled at an
+     interval, each of which represents stride points. */
+  stride = piece->num / ZEO_ACD_EVAL_MAX + 1;
+  for( ns=0, i=0; i<piece->num; i+=stride ) acd->side[ns++] = piece->idx[i];
+  for( axis=zX; axis<=zZ; axis++ )
+    for( k=1; k<=acd->param->plane_num; k++ ){
+      pos = piece->vmin.e[axis] + ( piece->vmax.e[axis] - piece->vmin.e[axis] ) * k / ( acd->param->plane_num + 1 );
+      nl = _zACDPartition( acd, acd->side, ns, axis, pos );
+      if( nl < 4 || ns - nl < 4 ) continue;
+      cost = _zACDConcavity( acd, acd->side, nl, stride )
+           + _zACDConcavity( acd, acd->side+nl, ns - nl, stride );
+      if( cost < best_cost ){
+        best_cost = cost;
+        best_axis = axis;
+        best_pos = pos;
+      }
+    }
+  if( best_cost == HUGE_VAL ) return false;
+  nl = _zACDPartition( acd, piece->idx, piece->num, best_axis, best_pos );
+  sub->idx = piece->idx + nl;
+  sub->num = piece->num - nl;
+  piece->num = nl;
+  _zACDPieceUpdate( acd, piece );
+  _zACDPieceUpdate( acd, sub );
+  return true;
+}
+
+/* create a convex polyhedron shape of a piece.
+ * 1 is returned if the shape is created, 0 if the piece is flat and
+ * dropped, or -1 if it fails to allocate memory. */
+static int _zACDPieceToShape(_zACD *acd, _zACDPiece *piece, zShape3D *shape, int id)
+{
+  char name[BUFSIZ];
+  zPH3D *ph;
+  register int i;
+
+  zShape3DInit( shape );
+  for( i=0; i<piece->num; i++ )
+    zVec3DCopy( &acd->p[piece->idx[i]], &acd->buf[i] );
+  if( _zACDIsFlat( acd->buf, piece->num ) ) return 0;
+  if( !( ph = zAlloc( zPH3D, 1 ) ) ){
+    ZALLOCERROR();
+    return -1;
+  }
+  /* the points are not flat, so that zCH3D() fails only on memory */
+  if( !zCH3D( ph, acd->buf, piece->num ) ){
+    zFree( ph );
+    return -1;
+  }
+  shape->com = &zeo_shape3d_ph_com;
+  shape->body = ph;
+  sprintf( name, "piece%d", id );
+  zNameSet( shape, name );
+  return 1;
+}
+
+/* approximate convex decomposition of a polyhedron. */
+zMShape3D *zPH3DConvexDecomp(zPH3D *ph, zACDParam *param, zMShape3D *ms)
+{
+  _zACD acd;
+  zACDParam param_default;
+  _zACDPiece *piece = NULL;
+  int *idx = NULL, np = 1, n = 0, ret;
+  register int i, j;
+
+  zMShape3DInit( ms );
+  if( !param ) param = zACDParamInit( &param_default );
+  acd.param = param;
+  acd.p = acd.buf = NULL;
+  acd.side = NULL;
+  if( zPH3DVertNum(ph) == 0 || !_zACDSample( &acd, ph ) ){
+    ms = NULL;
+    goto TERMINATE;
+  }
+  acd.buf = zAlloc( zVec3D, acd.num );
+  acd.side = zAlloc( int, acd.num );
+  idx = zAlloc( int, acd.num );
+  piece = zAlloc( _zACDPiece, param->max_piece );
+  if( !acd.buf || !acd.side || !idx || !piece ){
+    ZALLOCERROR();
+    ms = NULL;
+    goto TERMINATE;
+  }
+  for( i=0; i<acd.num; i++ ) idx[i] = i;
+  piece[0].idx = idx;
+  piece[0].num = acd.num;
+  _zACDPieceUpdate( &acd, &piece[0] );
+  /* split the most concave piece one after another */
+  while( np < param->max_piece ){
+    for( j=-1, i=0; i<np; i++ )
+      if( piece[i].concavity > param->concavity && ( j < 0 || piece[i].concavity > piece[j].concavity ) )
+        j = i;
+    if( j < 0 ) break;
+    if( _zACDSplit( &acd, &piece[j], &piece[np] ) )
+      np++;
+    else
+      piece[j].concavity = 0; /* unsplittable */
+  }
+  zArrayAlloc( &ms->shape, zShape3D, np );
+  if( zMShape3DShapeNum(ms) != np ){
+    ZALLOCERROR();
+    ms = NULL;
+    goto TERMINATE;
+  }
+  for( i=0; i<np; i++ ){
+    if( ( ret = _zACDPieceToShape( &acd, &piece[i], zMShape3DShape(ms,n), n ) ) < 0 ){
+      zMShape3DSetShapeNum( ms, n );
+      zMShape3DDestroy( ms );
+      ms = NULL;
+      goto TERMINATE;
+    }
+    n += ret;
+  }
+  zMShape3DSetShapeNum( ms, n );
+
+ TERMINATE:
+  zFree( acd.p );
+  zFree( acd.buf );
+  zFree( acd.side );
+  zFree( idx );
+  zFree( piece );
+  return ms;
+}
+
+/* cache of approximate convex decomposition */
+
+/* identifier of the binary format of a cache. */
+static const char __zeo_acd_magic[] = "ZACD";
+
+/* offset basis and prime of 64-bit FNV-1a hash */
+#define ZEO_ACD_FNV_BASIS ( (uint64_t)0xcbf29ce4UL << 32 | 0x84222325UL )
+#define ZEO_ACD_FNV_PRIME ( (uint64_t)0x00000100UL << 32 | 0x000001b3UL )
+
+/* 64-bit FNV-1a hash of a byte sequence. */
+static uint64_t _zACDHash(uint64_t h, void *data, size_t size)
+{
+  unsigned char *c;
+
+  for( c=data; size>0; c++, size-- ){
+    h ^= *c;
+    h *= ZEO_ACD_FNV_PRIME;
+  }
+  return h;
+}
+
+/* hash of a polyhedron and parameters of approximate convex decomposition. */
+static uint64_t _zACDCacheHash(zPH3D *ph, zACDParam *param)
+{
+  uint64_t h = ZEO_ACD_FNV_BASIS;
+  int v[3];
+  register int i, j;
+
+  h = _zACDHash( h, zPH3DVertBuf(ph), sizeof(zVec3D)*zPH3DVertNum(ph) );
+  for( i=0; i<zPH3DFaceNum(ph); i++ ){
+    for( j=0; j<3; j++ )
+      v[j] = zPH3DFaceVert(ph,i,j) - zPH3DVertBuf(ph);
+    h = _zACDHash( h, v, sizeof(v) );
+  }
+  h = _zACDHash( h, &param->resolution, sizeof(int) );
+  h = _zACDHash( h, &param->concavity, sizeof(double) );
+  h = _zACDHash( h, &param->max_piece, sizeof(int) );
+  h = _zACDHash( h, &param->plane_num, sizeof(int) );
+  return h;
+}
+
+/* write the header of a cache file, which identifies the input. */
+static bool _zACDCacheHeadFWrite(FILE *fp, zPH3D *ph, zACDParam *param, uint64_t hash)
+{
+  return fwrite( __zeo_acd_magic, sizeof(char), 4, fp ) == 4 &&
+         fwrite( &hash, sizeof(uint64_t), 1, fp ) == 1 &&
+         fwrite( &zPH3DVertNum(ph), sizeof(int), 1, fp ) == 1 &&
+         fwrite( &zPH3DFaceNum(ph), sizeof(int), 1, fp ) == 1 &&
+         fwrite( &param->resolution, sizeof(int), 1, fp ) == 1 &&
+         fwrite( &param->concavity, sizeof(double), 1, fp ) == 1 &&
+         fwrite( &param->max_piece, sizeof(int), 1, fp ) == 1 &&
+         fwrite( &param->plane_num, sizeof(int), 1, fp ) == 1;
+}
+
+/* check the header of a cache file against the input. */
+static bool _zACDCacheHeadFRead(FILE *fp, zPH3D *ph, zACDParam *param, uint64_t hash)
+{
+  char magic[4];
+  uint64_t h;
+  int vn, fn;
+  zACDParam p;
+
+  return fread( magic, sizeof(char), 4, fp ) == 4 &&
+         memcmp( magic, __zeo_acd_magic, 4 ) == 0 &&
+         fread( &h, sizeof(uint64_t), 1, fp ) == 1 && h == hash &&
+         fread( &vn, sizeof(int), 1, fp ) == 1 && vn == zPH3DVertNum(ph) &&
+         fread( &fn, sizeof(int), 1, fp ) == 1 && fn == zPH3DFaceNum(ph) &&
+         fread( &p.resolution, sizeof(int), 1, fp ) == 1 && p.resolution == param->resolution &&
+         fread( &p.concavity, sizeof(double), 1, fp ) == 1 && p.concavity == param->concavity &&
+         fread( &p.max_piece, sizeof(int), 1, fp ) == 1 && p.max_piece == param->max_piece &&
+         fread( &p.plane_num, sizeof(int), 1, fp ) == 1 && p.plane_num == param->plane_num;
+}
+
+/* write convex pieces to a cache file. */
+static bool _zACDCacheFWrite(FILE *fp, zPH3D *src, zACDParam *param, uint64_t hash, zMShape3D *ms)
+{
+  zPH3D *ph;
+  int n, v[3];
+  register int i, j, k;
+
+  n = zMShape3DShapeNum(ms);
+  if( !_zACDCacheHeadFWrite( fp, src, param, hash ) ||
+      fwrite( &n, sizeof(int), 1, fp ) != 1 ) return false;
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ){
+    ph = zShape3DPH( zMShape3DShape(ms,i) );
+    if( fwrite( &zPH3DVertNum(ph), sizeof(int), 1, fp ) != 1 ||
+        fwrite( &zPH3DFaceNum(ph), sizeof(int), 1, fp ) != 1 ) return false;
+    for( j=0; j<zPH3DVertNum(ph); j++ )
+      if( fwrite( zPH3DVert(ph,j)->e, sizeof(double), 3, fp ) != 3 ) return false;
+    for( j=0; j<zPH3DFaceNum(ph); j++ ){
+      for( k=0; k<3; k++ )
+        v[k] = zPH3DFaceVert(ph,j,k) - zPH3DVertBuf(ph);
+      if( fwrite( v, sizeof(int), 3, fp ) != 3 ) return false;
+    }
+  }
+  return true;
+}
+
+/* read a convex piece from a cache file. */
+static bool _zACDCachePieceFRead(FILE *fp, zShape3D *shape, int id)
+{
+  char name[BUFSIZ];
+  zPH3D *ph;
+  int vn, fn, v[3];
+  register int j;
+
+  zShape3DInit( shape );
+  if( fread( &vn, sizeof(int), 1, fp ) != 1 ||
+      fread( &fn, sizeof(int), 1, fp ) != 1 || vn <= 0 || fn <= 0 ) return false;
+  if( !( ph = zAlloc( zPH3D, 1 ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  if( !zPH3DAlloc( ph, vn, fn ) ) goto FAILURE;
+  for( j=0; j<vn; j++ )
+    if( fread( zPH3DVert(ph,j)->e, sizeof(double), 3, fp ) != 3 ) goto FAILURE;
+  for( j=0; j<fn; j++ ){
+    if( fread( v, sizeof(int), 3, fp ) != 3 ||
+        v[0] < 0 || v[0] >= vn || v[1] < 0 || v[1] >= vn || v[2] < 0 || v[2] >= vn ) goto FAILURE;
+    zTri3DCreate( zPH3DFace(ph,j), zPH3DVert(ph,v[0]), zPH3DVert(ph,v[1]), zPH3DVert(ph,v[2]) );
+  }
+  shape->com = &zeo_shape3d_ph_com;
+  shape->body = ph;
+  sprintf( name, "piece%d", id );
+  zNameSet( shape, name );
+  return true;
+
+ FAILURE:
+  zPH3DDestroy( ph );
+  zFree( ph );
+  return false;
+}
+
+/* read convex pieces from a cache file. */
+static zMShape3D *_zACDCacheFRead(FILE *fp, zPH3D *src, zACDParam *param, uint64_t hash, zMShape3D *ms)
+{
+  int n;
+  register int i;
+
+  zMShape3DInit( ms );
+  if( !_zACDCacheHeadFRead( fp, src, param, hash ) ||
+      fread( &n, sizeof(int), 1, fp ) != 1 || n <= 0 ) return NULL;
+  zArrayAlloc( &ms->shape, zShape3D, n );
+  if( zMShape3DShapeNum(ms) != n ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  for( i=0; i<n; i++ )
+    if( !_zACDCachePieceFRead( fp, zMShape3DShape(ms,i), i ) ){
+      zMShape3DSetShapeNum( ms, i );
+      zMShape3DDestroy( ms );
+      return NULL;
+    }
+  return ms;
+}
+
+/* approximate convex decomposition of a polyhedron with a cache. */
+zMShape3D *zPH3DConvexDecompCache(zPH3D *ph, zACDParam *param, zMShape3D *ms, char dirname[])
+{
+  char filename[BUFSIZ];
+  zACDParam param_default;
+  uint64_t hash;
+  FILE *fp;
+
+  if( !param ) param = zACDParamInit( &param_default );
+  hash = _zACDCacheHash( ph, param );
+  sprintf( filename, "%.*s/acd%08lx%08lx.%s", BUFSIZ-32, dirname,
+    (unsigned long)( hash >> 32 ), (unsigned long)( hash & 0xffffffffUL ), ZEO_ACD_SUFFIX );
+  if( ( fp = fopen( filename, "rb" ) ) ){
+    if( _zACDCacheFRead( fp, ph, param, hash, ms ) ){
+      fclose( fp );
+      return ms;
+    }
+    fclose( fp );
+    ZRUNWARN( ZEO_WARN_ACD_BROKENCACHE, filename );
+  }
+  if( !zPH3DConvexDecomp( ph, param, ms ) ) return NULL;
+  if( !( fp = zOpenFile( filename, ZEO_ACD_SUFFIX, "wb" ) ) ) return ms;
+  if( !_zACDCacheFWrite( fp, ph, param, hash, ms ) )
+    ZRUNWARN( ZEO_WARN_ACD_BROKENCACHE, filename );
+  fclose( fp );
+  return ms;
+}
@@ -0,0 +1,361 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_raycast - ray casting against multiple 3D shapes.
+ */
+
+#include <zeo/zeo_mshape.h>
+
+/* ********************************************************** */
+/* CLASS: zMShape3DRaycaster
+ * ray caster of multiple 3D shapes
+ * ********************************************************** */
+
+#define ZEO_MSHAPE_RAYCAST_LEAF_MAX 2 /* maximum number of shapes of a leaf */
+
+/* expand an axis-aligned box to include a point. */
+static void _zMShape3DRaycasterBoxAdd(zVec3D *vmin, zVec3D *vmax, zVec3D *p, zVec3D *r)
+{
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( p->e[i] - r->e[i] < vmin->e[i] ) vmin->e[i] = p->e[i] - r->e[i];
+    if( p->e[i] + r->e[i] > vmax->e[i] ) vmax->e[i] = p->e[i] + r->e[i];
+  }
+}
+
+/* half extent of a disk along each axis. */
+static zVec3D *_zMShape3DRaycasterDiskExtent(zVec3D *axis, double r, zVec3D *ext)
+{
+  double l;
+  register int i;
+
+  l = zVec3DSqrNorm( axis );
+  for( i=zX; i<=zZ; i++ )
+    ext->e[i] = r * sqrt( _zMax( 1 - zSqr(axis->e[i]) / l, 0 ) );
+  return ext;
+}
+
+/* axis-aligned bounding box of a shape; returns false for an unsupported shape. */
+static bool _zMShape3DRaycasterShapeBox(zShape3D *shape, zVec3D *vmin, zVec3D *vmax)
+{
+  zVec3D ext, axis;
+  zPH3D *ph;
+  zBox3D *box;
+  zSphere3D *sphere;
+  zEllips3D *el;
+  zCyl3D *cyl;
+  zECyl3D *ecyl;
+  zCone3D *cone;
+  register int i, j;
+
+  zVec3DCreate( vmin, HUGE_VAL, HUGE_VAL, HUGE_VAL );
+  zVec3DCreate( vmax,-HUGE_VAL,-HUGE_VAL,-HUGE_VAL );
+  if( shape->com == &zeo_shape3d_ph_com ){
+    ph = zShape3DPH(shape);
+    if( zPH3DVertNum(ph) == 0 ) return false;
+    for( i=0; i<zPH3DVertNum(ph); i++ )
+      _zMShape3DRaycasterBoxAdd( vmin, vmax, zPH3DVert(ph,i), ZVEC3DZERO );
+  } else
+  if( shape->com == &zeo_shape3d_box_com ){
+    box = shape->body;
+    for( zVec3DZero( &ext ), i=zX; i<=zZ; i++ )
+      for( j=zX; j<=zZ; j++ )
+        ext.e[j] += 0.5 * zBox3DDia(box,i) * fabs( zBox3DAxis(box,i)->e[j] );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zBox3DCenter(box), &ext );
+  } else
+  if( shape->com == &zeo_shape3d_sphere_com ){
+    sphere = shape->body;
+    zVec3DCreate( &ext, zSphere3DRadius(sphere), zSphere3DRadius(sphere), zSphere3DRadius(sphere) );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zSphere3DCenter(sphere), &ext );
+  } else
+  if( shape->com == &zeo_shape3d_ellips_com ){
+    el = shape->body;
+    for( zVec3DZero( &ext ), i=zX; i<=zZ; i++ )
+      for( j=zX; j<=zZ; j++ )
+        ext.e[j] += zSqr( zEllips3DRadius(el,i) * zEllips3DAxis(el,i)->e[j] );
+    for( j=zX; j<=zZ; j++ ) ext.e[j] = sqrt( ext.e[j] );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zEllips3DCenter(el), &ext );
+  } else
+  if( shape->com == &zeo_shape3d_cyl_com ){
+    cyl = shape->body;
+    _zMShape3DRaycasterDiskExtent( zCyl3DAxis(cyl,&axis), zCyl3DRadius(cyl), &ext );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zCyl3DCenter(cyl,0), &ext );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zCyl3DCenter(cyl,1), &ext );
+  } else
+  if( shape->com == &zeo_shape3d_ecyl_com ){
+    ecyl = shape->body;
+    for( j=zX; j<=zZ; j++ )
+      ext.e[j] = sqrt( zSqr( zECyl3DRadius(ecyl,0) * zECyl3DRadVec(ecyl,0)->e[j] )
+                     + zSqr( zECyl3DRadius(ecyl,1) * zECyl3DRadVec(ecyl,1)->e[j] ) );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zECyl3DCenter(ecyl,0), &ext );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zECyl3DCenter(ecyl,1), &ext );
+  } else
+  if( shape->com == &zeo_shape3d_cone_com ){
+    cone = shape->body;
+    zVec3DSub( zCone3DVert(cone), zCone3DCenter(cone), &axis );
+    _zMShape3DRaycasterDiskExtent( &axis, zCone3DRadius(cone), &ext );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zCone3DCenter(cone), &ext );
+    _zMShape3DRaycasterBoxAdd( vmin, vmax, zCone3DVert(cone), ZVEC3DZERO );
+  } else
+    return false;
+  return true;
+}
+
+/* workspace to build a ray caster. */
+typedef struct{
+  zMShape3DRaycaster *rc;
+  zVec3D *bmin; /* minimum corners of shapes */
+  zVec3D *bmax; /* maximum corners of shapes */
+} _zMShape3DRaycasterBuilder;
+
+/* center of the bounding box of a shape along an axis. */
+#define _zMShape3DRaycasterCenter(b,i,a) ( (b)->bmin[i].e[a] + (b)->bmax[i].e[a] )
+
+/* partially sort shapes so that the median one along an axis is at the middle. */
+static void _zMShape3DRaycasterSelect(_zMShape3DRaycasterBuilder *b, int start, int num, zAxis axis)
+{
+  int *s, l, r, i, j, k;
+  double pivot;
+
+  s = b->rc->shape + start;
+  k = num / 2;
+  for( l=0, r=num-1; l<r; ){
+    pivot = _zMShape3DRaycasterCenter( b, s[(l+r)/2], axis );
+    for( i=l, j=r; i<=j; ){
+      while( _zMShape3DRaycasterCenter( b, s[i], axis ) < pivot ) i++;
+      while( _zMShape3DRaycasterCenter( b, s[j], axis ) > pivot ) j--;
+      if( i <= j ){
+        zSwap( int, s[i], s[j] );
+        i++; j--;
+      }
+    }
+    if( j < k ) l = i;
+    if( k < i ) r = j;
+  }
+}
+
+/* build a node of a ray caster recursively. */
+static void _zMShape3DRaycasterBuildNode(_zMShape3DRaycasterBuilder *b, int id, int start, int num)
+{
+  zPH3DBVHNode *node;
+  zVec3D cmin, cmax;
+  zAxis axis;
+  register int i;
+
+  node = &b->rc->node[id];
+  zVec3DCreate( &node->vmin, HUGE_VAL, HUGE_VAL, HUGE_VAL );
+  zVec3DCreate( &node->vmax,-HUGE_VAL,-HUGE_VAL,-HUGE_VAL );
+  cmin = node->vmin;
+  cmax = node->vmax;
+  for( i=start; i<start+num; i++ ){
+    _zMShape3DRaycasterBoxAdd( &node->vmin, &node->vmax, &b->bmin[b->rc->shape[i]], ZVEC3DZERO );
+    _zMShape3DRaycasterBoxAdd( &node->vmin, &node->vmax, &b->bmax[b->rc->shape[i]], ZVEC3DZERO );
+    for( axis=zX; axis<=zZ; axis++ ){
+      if( _zMShape3DRaycasterCenter( b, b->rc->shape[i], axis ) < cmin.e[axis] )
+        cmin.e[axis] = _zMShape3DRaycasterCenter( b, b->rc->shape[i], axis );
+      if( _zMShape3DRaycasterCenter( b, b->rc->shape[i], axis ) > cmax.e[axis] )
+        cmax.e[axis] = _zMShape3DRaycasterCenter( b, b->rc->shape[i], axis );
+    }
+  }
+  node->child = start;
+  node->num = num;
+  if( num <= ZEO_MSHAPE_RAYCAST_LEAF_MAX ) return;
+  zVec3DSubDRC( &cmax, &cmin );
+  axis = cmax.e[zX] > cmax.e[zY] ? zX : zY;
+  if( cmax.e[zZ] > cmax.e[axis] ) axis = zZ;
+  _zMShape3DRaycasterSelect( b, start, num, axis );
+  node->child = b->rc->nodenum;
+  node->num = 0;
+  b->rc->nodenum += 2;
+  _zMShape3DRaycasterBuildNode( b, node->child, start, num/2 );
+  _zMShape3DRaycasterBuildNode( b, b->rc->node[id].child+1, start+num/2, num-num/2 );
+}
+
+/* build a ray caster of multiple shapes. */
+zMShape3DRaycaster *zMShape3DRaycasterBuild(zMShape3DRaycaster *rc, zMShape3D *ms)
+{
+  _zMShape3DRaycasterBuilder b;
+  int n = 0;
+  register int i;
+
+  rc->ms = ms;
+  rc->nodenum = 0;
+  rc->node = NULL;
+  rc->shape = NULL;
+  rc->phbvh = NULL;
+  b.bmin = b.bmax = NULL;
+  if( zMShape3DShapeNum(ms) == 0 ) return rc;
+  rc->node = zAlloc( zPH3DBVHNode, 2*zMShape3DShapeNum(ms)-1 );
+  rc->shape = zAlloc( int, zMShape3DShapeNum(ms) );
+  rc->phbvh = zAlloc( zPH3DBVH, zMShape3DShapeNum(ms) );
+  b.rc = rc;
+  b.bmin = zAlloc( zVec3D, zMShape3DShapeNum(ms) );
+  b.bmax = zAlloc( zVec3D, zMShape3DShapeNum(ms) );
+  if( !rc->node || !rc->shape || !rc->phbvh || !b.bmin || !b.bmax ){
+    ZALLOCERROR();
+    goto FAILURE;
+  }
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ){
+    rc->phbvh[i].nodenum = 0;
+    rc->phbvh[i].node = NULL;
+    rc->phbvh[i].face = NULL;
+  }
+  for( i=0; i<zMShape3DShapeNum(ms); i++ ){
+    if( !_zMShape3DRaycasterShapeBox( zMShape3DShape(ms,i), &b.bmin[i], &b.bmax[i] ) ) continue;
+    if( zMShape3DShape(ms,i)->com == &zeo_shape3d_ph_com &&
+        !zPH3DBVHBuild( &rc->phbvh[i], zShape3DPH(zMShape3DShape(ms,i)) ) ) goto FAILURE;
+    rc->shape[n++] = i;
+  }
+  if( n > 0 ){
+    rc->nodenum = 1;
+    _zMShape3DRaycasterBuildNode( &b, 0, 0, n );
+  }
+  goto TERMINATE;
+
+ FAILURE:
+  zMShape3DRaycasterDestroy( rc );
+  rc = NULL;
+ TERMINATE:
+  zFree( b.bmin );
+  zFree( b.bmax );
+  return rc;
+}
+
+/* destroy a ray caster of multiple shapes. */
+void zMShape3DRaycasterDestroy(zMShape3DRaycaster *rc)
+{
+  register int i;
+
+  if( rc->phbvh )
+    for( i=0; i<zMShape3DShapeNum(rc->ms); i++ )
+      zPH3DBVHDestroy( &rc->phbvh[i] );
+  zFree( rc->node );
+  zFree( rc->shape );
+  zFree( rc->phbvh );
+  rc->nodenum = 0;
+  rc->ms = NULL;
+}
+
+/* distance to enter an axis-aligned box along a ray within a range; returns false if the ray misses it. */
+static bool _zMShape3DRaycasterEnter(zPH3DBVHNode *node, zRay3D *ray, double tmax, double *tmin)
+{
+  double t1, t2;
+  register int i;
+
+  for( *tmin=0, i=zX; i<=zZ; i++ ){
+    t1 = ( node->vmin.e[i] - zRay3DOrg(ray)->e[i] ) * zRay3DIDir(ray)->e[i];
+    t2 = ( node->vmax.e[i] - zRay3DOrg(ray)->e[i] ) * zRay3DIDir(ray)->e[i];
+    if( t1 > t2 ) zSwap( double, t1, t2 );
+    if( t1 > *tmin ) *tmin = t1;
+    if( t2 < tmax ) tmax = t2;
+    if( *tmin > tmax ) return false;
+  }
+  return true;
+}
+
+/* intersection of a ray and a shape. */
+static bool _zMShape3DRaycasterShape(zMShape3DRaycaster *rc, int i, zRay3D *ray, double *t, zVec3D *norm)
+{
+  return rc->phbvh[i].nodenum > 0 ?
+    zPH3DBVHRaycast( &rc->phbvh[i], ray, t, norm ) :
+    zShape3DRaycast( zMShape3DShape(rc->ms,i), ray, t, norm );
+}
+
+/* find the nearest intersection of a ray and shapes under a node. */
+static int _zMShape3DRaycasterCast(zMShape3DRaycaster *rc, int id, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zPH3DBVHNode *node;
+  double tn, tf;
+  int cn, cf, hit = -1, h;
+  register int i;
+
+  node = &rc->node[id];
+  if( node->num > 0 ){
+    for( i=node->child; i<node->child+node->num; i++ )
+      if( _zMShape3DRaycasterShape( rc, rc->shape[i], ray, t, norm ) ) hit = rc->shape[i];
+    return hit;
+  }
+  cn = node->child;
+  cf = node->child + 1;
+  if( !_zMShape3DRaycasterEnter( &rc->node[cn], ray, *t, &tn ) ) tn = HUGE_VAL;
+  if( !_zMShape3DRaycasterEnter( &rc->node[cf], ray, *t, &tf ) ) tf = HUGE_VAL;
+  if( tf < tn ){ /* visit the nearer child first */
+    zSwap( int, cn, cf );
+    zSwap( double, tn, tf );
+  }
+  if( tn < *t && ( h = _zMShape3DRaycasterCast( rc, cn, ray, t, norm ) ) >= 0 ) hit = h;
+  if( tf < *t && ( h = _zMShape3DRaycasterCast( rc, cf, ray, t, norm ) ) >= 0 ) hit = h;
+  return hit;
+}
+
+/* cast a ray to multiple shapes. */
+int zMShape3DRaycasterCast(zMShape3DRaycaster *rc, zRay3D *ray, double *t, zVec3D *norm)
+{
+  double t0;
+
+  if( rc->nodenum == 0 || !_zMShape3DRaycasterEnter( &rc->node[0], ray, *t, &t0 ) ) return -1;
+  return _zMShape3DRaycasterCast( rc, 0, ray, t, norm );
+}
+
+/* packet of rays */
+typedef struct{
+  zRay3D *ray;
+  double *t;
+  zVec3D *norm;
+  int *id;
+} _zMShape3DRaycasterPacket;
+
+/* traverse a node with active rays of a packet. */
+static void _zMShape3DRaycasterPacketCast(zMShape3DRaycaster *rc, int id, _zMShape3DRaycasterPacket *p, int active[], int num)
+{
+  zPH3DBVHNode *node;
+  int next[ZEO_MSHAPE_RAYCAST_PACKET_SIZE];
+  double tn, tf;
+  int n = 0, cn, cf;
+  register int i, j;
+
+  node = &rc->node[id];
+  for( i=0; i<num; i++ ) /* rays which enter the node before hitting anything */
+    if( _zMShape3DRaycasterEnter( node, &p->ray[active[i]], p->t[active[i]], &tn ) )
+      next[n++] = active[i];
+  if( n == 0 ) return;
+  if( node->num > 0 ){
+    for( i=node->child; i<node->child+node->num; i++ )
+      for( j=0; j<n; j++ )
+        if( _zMShape3DRaycasterShape( rc, rc->shape[i], &p->ray[next[j]], &p->t[next[j]], p->norm ? &p->norm[next[j]] : NULL ) )
+          p->id[next[j]] = rc->shape[i];
+    return;
+  }
+  cn = node->child;
+  cf = node->child + 1;
+  /* the order of children is decided by the first active ray */
+  if( !_zMShape3DRaycasterEnter( &rc->node[cn], &p->ray[next[0]], HUGE_VAL, &tn ) ) tn = HUGE_VAL;
+  if( !_zMShape3DRaycasterEnter( &rc->node[cf], &p->ray[next[0]], HUGE_VAL, &tf ) ) tf = HUGE_VAL;
+  if( tf < tn ) zSwap( int, cn, cf );
+  _zMShape3DRaycasterPacketCast( rc, cn, p, next, n );
+  _zMShape3DRaycasterPacketCast( rc, cf, p, next, n );
+}
+
+/* cast a packet of rays to multiple shapes. */
+int zMShape3DRaycasterPacket(zMShape3DRaycaster *rc, zRay3D ray[], int num, double t[], zVec3D norm[], int id[])
+{
+  _zMShape3DRaycasterPacket p;
+  int active[ZEO_MSHAPE_RAYCAST_PACKET_SIZE], n, hit = 0;
+  register int i, j;
+
+  for( i=0; i<num; i++ ) id[i] = -1;
+  if( rc->nodenum == 0 ) return 0;
+  p.ray = ray;
+  p.t = t;
+  p.norm = norm;
+  p.id = id;
+  for( i=0; i<num; i+=ZEO_MSHAPE_RAYCAST_PACKET_SIZE ){
+    n = _zMin( num - i, ZEO_MSHAPE_RAYCAST_PACKET_SIZE );
+    for( j=0; j<n; j++ ) active[j] = i + j;
+    _zMShape3DRaycasterPacketCast( rc, 0, &p, active, n );
+  }
+  for( i=0; i<num; i++ )
+    if( id[i] >= 0 ) hit++;
+  return hit;
+}
@@ -0,0 +1,108 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_scan - simulation of range sensors over multiple 3D shapes.
+ */
+
+#include <zeo/zeo_mshape.h>
+
+/* ********************************************************** */
+/* CLASS: zRangeSensor3D
+ * range sensor model
+ * ********************************************************** */
+
+/* allocate internal arrays of a range sensor. */
+static zRangeSensor3D *_zRangeSensor3DAlloc(zRangeSensor3D *sensor, int width, int height, double rmin, double rmax)
+{
+  int n;
+
+  sensor->width = width;
+  sensor->height = height;
+  sensor->rmin = _zMax( rmin, 0 );
+  sensor->rmax = rmax;
+  n = zRangeSensor3DRayNum(sensor);
+  sensor->dir = zAlloc( zVec3D, n );
+  sensor->scale = zAlloc( double, n );
+  sensor->ray = zAlloc( zRay3D, n );
+  sensor->t = zAlloc( double, n );
+  sensor->id = zAlloc( int, n );
+  if( !sensor->dir || !sensor->scale || !sensor->ray || !sensor->t || !sensor->id ){
+    ZALLOCERROR();
+    zRangeSensor3DDestroy( sensor );
+    return NULL;
+  }
+  return sensor;
+}
+
+/* create a depth camera of the pinhole model. */
+zRangeSensor3D *zRangeSensor3DCreatePinhole(zRangeSensor3D *sensor, int width, int height, double fx, double fy, double cx, double cy, double rmin, double rmax)
+{
+  register int u, v, i;
+
+  if( !_zRangeSensor3DAlloc( sensor, width, height, rmin, rmax ) ) return NULL;
+  for( i=0, v=0; v<height; v++ )
+    for( u=0; u<width; u++, i++ ){
+      zVec3DCreate( &sensor->dir[i], ( u - cx ) / fx, ( v - cy ) / fy, 1 );
+      sensor->scale[i] = 1.0 / zVec3DNormalizeDRC( &sensor->dir[i] );
+    }
+  return sensor;
+}
+
+/* create a spinning lidar. */
+zRangeSensor3D *zRangeSensor3DCreateLidar(zRangeSensor3D *sensor, int width, int height, double amin, double amax, double emin, double emax, double rmin, double rmax)
+{
+  double a, e;
+  register int u, v, i;
+
+  if( !_zRangeSensor3DAlloc( sensor, width, height, rmin, rmax ) ) return NULL;
+  for( i=0, v=0; v<height; v++ ){
+    e = height > 1 ? emax - ( emax - emin ) * v / ( height - 1 ) : 0.5 * ( emin + emax );
+    for( u=0; u<width; u++, i++ ){
+      a = width > 1 ? amin + ( amax - amin ) * u / ( width - 1 ) : 0.5 * ( amin + amax );
+      zVec3DCreate( &sensor->dir[i], cos(e)*cos(a), cos(e)*sin(a), sin(e) );
+      sensor->scale[i] = 1.0;
+    }
+  }
+  return sensor;
+}
+
+/* destroy a range sensor. */
+void zRangeSensor3DDestroy(zRangeSensor3D *sensor)
+{
+  zFree( sensor->dir );
+  zFree( sensor->scale );
+  zFree( sensor->ray );
+  zFree( sensor->t );
+  zFree( sensor->id );
+  sensor->width = sensor->height = 0;
+}
+
+/* simulate a scan of a range sensor. */
+int zRangeSensor3DScan(zRangeSensor3D *sensor, zMShape3DRaycaster *rc, zFrame3D *pose, double depth[], zVec3D p[])
+{
+  zRay3D *ray;
+  int n = 0;
+  register int i;
+
+  for( i=0; i<zRangeSensor3DRayNum(sensor); i++ ){
+    ray = &sensor->ray[i];
+    zMulMat3DVec3D( zFrame3DAtt(pose), &sensor->dir[i], zRay3DDir(ray) );
+    /* rays start at the minimum range */
+    zVec3DCat( zFrame3DPos(pose), sensor->rmin, zRay3DDir(ray), zRay3DOrg(ray) );
+    zVec3DCreate( zRay3DIDir(ray),
+      1.0 / ray->dir.c.x, 1.0 / ray->dir.c.y, 1.0 / ray->dir.c.z );
+    sensor->t[i] = sensor->rmax - sensor->rmin;
+  }
+  zMShape3DRaycasterPacket( rc, sensor->ray, zRangeSensor3DRayNum(sensor), sensor->t, NULL, sensor->id );
+  for( i=0; i<zRangeSensor3DRayNum(sensor); i++ ){
+    if( sensor->id[i] < 0 ){
+      if( depth ) depth[i] = 0;
+      continue;
+    }
+    sensor->t[i] += sensor->rmin;
+    if( depth ) depth[i] = sensor->t[i] * sensor->scale[i];
+    if( p ) zVec3DMul( &sensor->dir[i], sensor->t[i], &p[n] );
+    n++;
+  }
+  return n;
+}
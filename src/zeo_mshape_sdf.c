@@ -0,0 +1,335 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_mshape_sdf - signed distance field of multiple 3D shapes.
+ */
+
+#include <zeo/zeo_mshape.h>
+#include <limits.h>
+
+/* ********************************************************** */
+/* CLASS: zSDF3D
+ * signed distance field
+ * ********************************************************** */
+
+#define ZEO_SDF_SWEEP_NUM 2 /* number of repetitions of the eight sweeps */
+
+/* number of grid points of a signed distance field, or zero if it is invalid. */
+static size_t _zSDF3DSize(int nx, int ny, int nz)
+{
+  if( nx < 2 || ny < 2 || nz < 2 ) return 0;
+  /* every index has to be representable as int */
+  if( (size_t)nx * (size_t)ny > (size_t)( INT_MAX / nz ) ) return 0;
+  return (size_t)nx * (size_t)ny * (size_t)nz;
+}
+
+/* allocate a signed distance field. */
+zSDF3D *zSDF3DAlloc(zSDF3D *sdf, zVec3D *org, double pitch, int nx, int ny, int nz)
+{
+  size_t size;
+
+  if( ( size = _zSDF3DSize( nx, ny, nz ) ) == 0 || !( pitch > 0 ) ){
+    ZRUNERROR( ZEO_ERR_SDF_INVALID );
+    return NULL;
+  }
+  zVec3DCopy( org, &sdf->org );
+  sdf->pitch = pitch;
+  sdf->num[0] = nx;
+  sdf->num[1] = ny;
+  sdf->num[2] = nz;
+  if( !( sdf->val = zAlloc( double, size ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  return sdf;
+}
+
+/* destroy a signed distance field. */
+void zSDF3DDestroy(zSDF3D *sdf)
+{
+  zFree( sdf->val );
+  sdf->num[0] = sdf->num[1] = sdf->num[2] = 0;
+}
+
+/* distance from a point outside of shapes and whether it is inside. */
+static double _zSDF3DPointDist(zMShape3DRaycaster *rc, zVec3D *p, bool *inside)
+{
+  zShape3D *shape;
+  zVec3D cp;
+  double d, dmin = HUGE_VAL;
+  register int i;
+
+  *inside = false;
+  for( i=0; i<zMShape3DShapeNum(rc->ms); i++ ){
+    shape = zMShape3DShape(rc->ms,i);
+    if( rc->phbvh[i].nodenum > 0 ){
+      if( zPH3DBVHPointIsInside( &rc->phbvh[i], p, true ) ){
+        *inside = true;
+        return 0;
+      }
+      d = zPH3DBVHClosest( &rc->phbvh[i], p, &cp );
+    } else{
+      if( shape->com == &zeo_shape3d_nurbs_com ) continue;
+      if( zShape3DPointIsInside( shape, p, true ) ){
+        *inside = true;
+        return 0;
+      }
+      d = zShape3DPointDist( shape, p );
+    }
+    if( d < dmin ) dmin = d;
+  }
+  return dmin;
+}
+
+/* value of a neighbor for the fast sweeping; outside points are on the opposite side. */
+#define _zSDF3DNeighbor(sdf,inside,n) ( (inside)[n] ? (sdf)->val[n] : -(sdf)->val[n] )
+
+/* smaller value of two neighbors along an axis. */
+static double _zSDF3DNeighborMin(zSDF3D *sdf, bool inside[], int n, int i, int axis, int step)
+{
+  double v = HUGE_VAL, w;
+
+  if( i > 0 ) v = _zSDF3DNeighbor( sdf, inside, n-step );
+  if( i < sdf->num[axis]-1 && ( w = _zSDF3DNeighbor( sdf, inside, n+step ) ) < v ) v = w;
+  return v;
+}
+
+/* update a value of an inside point by the Godunov upwind scheme of the Eikonal equation. */
+static void _zSDF3DSweepPoint(zSDF3D *sdf, bool inside[], int i, int j, int k)
+{
+  double a[3], u, s, h;
+  int n;
+
+  n = ( k*sdf->num[1] + j )*sdf->num[0] + i;
+  if( !inside[n] ) return;
+  h = sdf->pitch;
+  a[0] = _zSDF3DNeighborMin( sdf, inside, n, i, 0, 1 );
+  a[1] = _zSDF3DNeighborMin( sdf, inside, n, j, 1, sdf->num[0] );
+  a[2] = _zSDF3DNeighborMin( sdf, inside, n, k, 2, sdf->num[0]*sdf->num[1] );
+  if( a[0] > a[1] ) zSwap( double, a[0], a[1] );
+  if( a[1] > a[2] ) zSwap( double, a[1], a[2] );
+  if( a[0] > a[1] ) zSwap( double, a[0], a[1] );
+  if( ( u = a[0] + h ) > a[1] ){
+    u = 0.5 * ( a[0] + a[1] + sqrt( 2*h*h - zSqr( a[0] - a[1] ) ) );
+    if( u > a[2] ){
+      s = a[0] + a[1] + a[2];
+      u = ( s + sqrt( s*s - 3*( zSqr(a[0]) + zSqr(a[1]) + zSqr(a[2]) - h*h ) ) ) / 3;
+    }
+  }
+  if( u < sdf->val[n] ) sdf->val[n] = u;
+}
+
+/* compute distances of inside points by the fast sweeping method. */
+static void _zSDF3DSweep(zSDF3D *sdf, bool inside[])
+{
+  int dir, r, i, j, k, i0, j0, k0, di, dj, dk;
+
+  for( r=0; r<ZEO_SDF_SWEEP_NUM; r++ )
+    for( dir=0; dir<8; dir++ ){
+      di = dir & 0x1 ? -1 : 1; i0 = di > 0 ? 0 : sdf->num[0]-1;
+      dj = dir & 0x2 ? -1 : 1; j0 = dj > 0 ? 0 : sdf->num[1]-1;
+      dk = dir & 0x4 ? -1 : 1; k0 = dk > 0 ? 0 : sdf->num[2]-1;
+      for( k=k0; k>=0 && k<sdf->num[2]; k+=dk )
+        for( j=j0; j>=0 && j<sdf->num[1]; j+=dj )
+          for( i=i0; i>=0 && i<sdf->num[0]; i+=di )
+            _zSDF3DSweepPoint( sdf, inside, i, j, k );
+    }
+}
+
+/* create a signed distance field of multiple shapes. */
+zSDF3D *zSDF3DFromMShape(zSDF3D *sdf, zMShape3D *ms, double pitch, double margin)
+{
+  zMShape3DRaycaster rc;
+  zVec3D org, p;
+  bool *inside = NULL;
+  int i, j, k, n[3];
+  double d;
+  register int l;
+
+  if( !zMShape3DRaycasterBuild( &rc, ms ) ) return NULL;
+  if( rc.nodenum == 0 ){
+    ZRUNERROR( ZEO_ERR_SDF_EMPTY );
+    sdf = NULL;
+    goto TERMINATE;
+  }
+  for( l=zX; l<=zZ; l++ ){
+    org.e[l] = rc.node[0].vmin.e[l] - margin;
+    d = ceil( ( rc.node[0].vmax.e[l] - rc.node[0].vmin.e[l] + 2*margin ) / pitch ) + 1;
+    n[l] = d < INT_MAX ? (int)d : 0; /* rejected by zSDF3DAlloc() */
+  }
+  if( !zSDF3DAlloc( sdf, &org, pitch, n[0], n[1], n[2] ) ){
+    sdf = NULL;
+    goto TERMINATE;
+  }
+  if( !( inside = zAlloc( bool, _zSDF3DSize( n[0], n[1], n[2] ) ) ) ){
+    ZALLOCERROR();
+    zSDF3DDestroy( sdf );
+    sdf = NULL;
+    goto TERMINATE;
+  }
+  for( l=0, k=0; k<n[2]; k++ )
+    for( j=0; j<n[1]; j++ )
+      for( i=0; i<n[0]; i++, l++ ){
+        zVec3DCreate( &p, org.c.x + i*pitch, org.c.y + j*pitch, org.c.z + k*pitch );
+        sdf->val[l] = _zSDF3DPointDist( &rc, &p, &inside[l] );
+        if( inside[l] ) sdf->val[l] = HUGE_VAL; /* to be computed by sweeping */
+      }
+  _zSDF3DSweep( sdf, inside );
+  for( l=0; l<n[0]*n[1]*n[2]; l++ )
+    if( inside[l] ) sdf->val[l] = -sdf->val[l];
+
+ TERMINATE:
+  zFree( inside );
+  zMShape3DRaycasterDestroy( &rc );
+  return sdf;
+}
+
+/* create a signed distance field of a shape. */
+zSDF3D *zSDF3DFromShape(zSDF3D *sdf, zShape3D *shape, double pitch, double margin)
+{
+  zMShape3D ms;
+
+  zMShape3DInit( &ms );
+  zMShape3DSetShapeBuf( &ms, shape );
+  zMShape3DSetShapeNum( &ms, 1 );
+  return zSDF3DFromMShape( sdf, &ms, pitch, margin );
+}
+
+/* create a signed distance field of a polyhedron. */
+zSDF3D *zSDF3DFromPH(zSDF3D *sdf, zPH3D *ph, double pitch, double margin)
+{
+  zShape3D shape;
+
+  zShape3DInit( &shape );
+  shape.com = &zeo_shape3d_ph_com;
+  shape.body = ph;
+  return zSDF3DFromShape( sdf, &shape, pitch, margin );
+}
+
+/* signed distance and its gradient by the trilinear interpolation. */
+double zSDF3DDist(zSDF3D *sdf, zVec3D *p, zVec3D *grad)
+{
+  double g[3], f[3], v[8], d, dout;
+  zVec3D pc;
+  int c[3];
+  bool out = false;
+  register int l;
+
+  for( l=zX; l<=zZ; l++ ){
+    g[l] = ( p->e[l] - sdf->org.e[l] ) / sdf->pitch;
+    if( g[l] < 0 || g[l] > sdf->num[l]-1 ){
+      g[l] = _zLimit( g[l], 0, sdf->num[l]-1 );
+      out = true;
+    }
+    if( ( c[l] = (int)g[l] ) > sdf->num[l]-2 ) c[l] = sdf->num[l]-2;
+    f[l] = g[l] - c[l];
+  }
+  v[0] = zSDF3DVal( sdf, c[0],   c[1],   c[2]   );
+  v[1] = zSDF3DVal( sdf, c[0]+1, c[1],   c[2]   );
+  v[2] = zSDF3DVal( sdf, c[0],   c[1]+1, c[2]   );
+  v[3] = zSDF3DVal( sdf, c[0]+1, c[1]+1, c[2]   );
+  v[4] = zSDF3DVal( sdf, c[0],   c[1],   c[2]+1 );
+  v[5] = zSDF3DVal( sdf, c[0]+1, c[1],   c[2]+1 );
+  v[6] = zSDF3DVal( sdf, c[0],   c[1]+1, c[2]+1 );
+  v[7] = zSDF3DVal( sdf, c[0]+1, c[1]+1, c[2]+1 );
+  d = ( 1-f[2] )*( ( 1-f[1] )*( ( 1-f[0] )*v[0] + f[0]*v[1] ) + f[1]*( ( 1-f[0] )*v[2] + f[0]*v[3] ) )
+    +    f[2]  *( ( 1-f[1] )*( ( 1-f[0] )*v[4] + f[0]*v[5] ) + f[1]*( ( 1-f[0] )*v[6] + f[0]*v[7] ) );
+  if( out ){ /* out of the grid */
+    for( l=zX; l<=zZ; l++ )
+      pc.e[l] = sdf->org.e[l] + g[l]*sdf->pitch;
+    dout = zVec3DDist( p, &pc );
+    if( grad ){
+      zVec3DSub( p, &pc, grad );
+      zVec3DDivDRC( grad, dout );
+    }
+    return d + dout;
+  }
+  if( grad ){
+    grad->c.x = ( ( 1-f[2] )*( ( 1-f[1] )*( v[1]-v[0] ) + f[1]*( v[3]-v[2] ) )
+                +    f[2]  *( ( 1-f[1] )*( v[5]-v[4] ) + f[1]*( v[7]-v[6] ) ) ) / sdf->pitch;
+    grad->c.y = ( ( 1-f[2] )*( ( 1-f[0] )*( v[2]-v[0] ) + f[0]*( v[3]-v[1] ) )
+                +    f[2]  *( ( 1-f[0] )*( v[6]-v[4] ) + f[0]*( v[7]-v[5] ) ) ) / sdf->pitch;
+    grad->c.z = ( ( 1-f[1] )*( ( 1-f[0] )*( v[4]-v[0] ) + f[0]*( v[5]-v[1] ) )
+                +    f[1]  *( ( 1-f[0] )*( v[6]-v[2] ) + f[0]*( v[7]-v[3] ) ) ) / sdf->pitch;
+  }
+  return d;
+}
+
+/* identifier of the binary format of a signed distance field. */
+static const char __zeo_sdf_magic[] = "ZSDF";
+
+/* write a signed distance field to a file. */
+bool zSDF3DFWrite(FILE *fp, zSDF3D *sdf)
+{
+  size_t n;
+
+  n = _zSDF3DSize( sdf->num[0], sdf->num[1], sdf->num[2] );
+  if( fwrite( __zeo_sdf_magic, sizeof(char), 4, fp ) != 4 ||
+      fwrite( sdf->num, sizeof(int), 3, fp ) != 3 ||
+      fwrite( sdf->org.e, sizeof(double), 3, fp ) != 3 ||
+      fwrite( &sdf->pitch, sizeof(double), 1, fp ) != 1 ||
+      fwrite( sdf->val, sizeof(double), n, fp ) != n ){
+    ZRUNERROR( ZEO_ERR_SDF_WRITE );
+    return false;
+  }
+  return true;
+}
+
+/* read a signed distance field from a file. */
+zSDF3D *zSDF3DFRead(FILE *fp, zSDF3D *sdf)
+{
+  char magic[4];
+  int num[3];
+  zVec3D org;
+  double pitch;
+  size_t n;
+  long pos, end;
+
+  if( fread( magic, sizeof(char), 4, fp ) != 4 || memcmp( magic, __zeo_sdf_magic, 4 ) != 0 ||
+      fread( num, sizeof(int), 3, fp ) != 3 ||
+      fread( org.e, sizeof(double), 3, fp ) != 3 ||
+      fread( &pitch, sizeof(double), 1, fp ) != 1 ||
+      ( n = _zSDF3DSize( num[0], num[1], num[2] ) ) == 0 || !( pitch > 0 ) ){
+    ZRUNERROR( ZEO_ERR_SDF_READ );
+    return NULL;
+  }
+  /* refuse a header claiming more values than the file holds */
+  if( ( pos = ftell( fp ) ) >= 0 && fseek( fp, 0, SEEK_END ) == 0 ){
+    end = ftell( fp );
+    if( fseek( fp, pos, SEEK_SET ) != 0 || end < pos ||
+        (size_t)( end - pos ) / sizeof(double) < n ){
+      ZRUNERROR( ZEO_ERR_SDF_READ );
+      return NULL;
+    }
+  }
+  if( !zSDF3DAlloc( sdf, &org, pitch, num[0], num[1], num[2] ) ) return NULL;
+  if( fread( sdf->val, sizeof(double), n, fp ) != n ){
+    ZRUNERROR( ZEO_ERR_SDF_READ );
+    zSDF3DDestroy( sdf );
+    return NULL;
+  }
+  return sdf;
+}
+
+/* write a signed distance field to a file. */
+bool zSDF3DWriteFile(zSDF3D *sdf, char filename[])
+{
+  FILE *fp;
+  bool ret;
+
+  if( !( fp = zOpenFile( filename, ZEO_SDF_SUFFIX, "wb" ) ) ) return false;
+  ret = zSDF3DFWrite( fp, sdf );
+  fclose( fp );
+  return ret;
+}
+
+/* read a signed distance field from a file. */
+zSDF3D *zSDF3DReadFile(zSDF3D *sdf, char filename[])
+{
+  FILE *fp;
+
+  if( !( fp = zOpenFile( filename, ZEO_SDF_SUFFIX, "rb" ) ) ) return NULL;
+  sdf = zSDF3DFRead( fp, sdf );
+  fclose( fp );
+  return sdf;
+}
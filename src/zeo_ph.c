@@ -179,6 +179,17 @@ bool zPH3DPointIsInside(zPH3D *ph, zVec3D *p, bool rim)
   return true;
 }
 
+/* intersection of a ray and a 3D polyhedron. */
+bool zPH3DRaycast(zPH3D *ph, zRay3D *ray, double *t, zVec3D *norm)
+{
+  register int i;
+  bool hit = false;
+
+  for( i=0; i<zPH3DFaceNum(ph); i++ )
+    if( zTri3DRaycast( zPH3DFace(ph,i), ray, t, norm ) ) hit = true;
+  return hit;
+}
+
 /* volume of a 3D polyhedron. */
 double zPH3DVolume(zPH3D *ph)
 {
@@ -0,0 +1,443 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_ph_bvh - bounding volume hierarchy of faces of a polyhedron.
+ */
+
+#include <zeo/zeo_ph.h>
+
+/* ********************************************************** */
+/* CLASS: zPH3DBVH
+ * bounding volume hierarchy of faces of a polyhedron
+ * ********************************************************** */
+
+#define ZEO_PH_BVH_BIN_NUM  16 /* number of bins to estimate SAH cost */
+#define ZEO_PH_BVH_LEAF_MAX  8 /* maximum number of faces of a leaf unless unsplittable */
+
+/* initialize an axis-aligned box to be empty. */
+static void _zPH3DBVHBoxInit(zVec3D *vmin, zVec3D *vmax)
+{
+  zVec3DCreate( vmin, HUGE_VAL, HUGE_VAL, HUGE_VAL );
+  zVec3DCreate( vmax,-HUGE_VAL,-HUGE_VAL,-HUGE_VAL );
+}
+
+/* expand an axis-aligned box to include another box. */
+static void _zPH3DBVHBoxMerge(zVec3D *vmin, zVec3D *vmax, zVec3D *bmin, zVec3D *bmax)
+{
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( bmin->e[i] < vmin->e[i] ) vmin->e[i] = bmin->e[i];
+    if( bmax->e[i] > vmax->e[i] ) vmax->e[i] = bmax->e[i];
+  }
+}
+
+/* half of the surface area of an axis-aligned box. */
+static double _zPH3DBVHBoxArea(zVec3D *vmin, zVec3D *vmax)
+{
+  zVec3D d;
+
+  if( vmin->c.x > vmax->c.x ) return 0; /* empty box */
+  zVec3DSub( vmax, vmin, &d );
+  return d.c.x*d.c.y + d.c.y*d.c.z + d.c.z*d.c.x;
+}
+
+/* squared distance from a point to an axis-aligned box. */
+static double _zPH3DBVHBoxSqrDist(zVec3D *vmin, zVec3D *vmax, zVec3D *p)
+{
+  register int i;
+  double d = 0;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( p->e[i] < vmin->e[i] )
+      d += zSqr( vmin->e[i] - p->e[i] );
+    else if( p->e[i] > vmax->e[i] )
+      d += zSqr( p->e[i] - vmax->e[i] );
+  }
+  return d;
+}
+
+/* workspace to build a bounding volume hierarchy. */
+typedef struct{
+  zPH3DBVH *bvh;
+  zVec3D *c;    /* centroids of faces */
+  zVec3D *bmin; /* minimum corners of faces */
+  zVec3D *bmax; /* maximum corners of faces */
+} _zPH3DBVHBuilder;
+
+/* bin to estimate SAH cost. */
+typedef struct{
+  zVec3D vmin, vmax;
+  int n;
+} _zPH3DBVHBin;
+
+/* index of a bin in which a centroid is put. */
+static int _zPH3DBVHBinIndex(double c, double cmin, double scale)
+{
+  int k;
+
+  k = (int)( ( c - cmin ) * scale );
+  return k < 0 ? 0 : ( k >= ZEO_PH_BVH_BIN_NUM ? ZEO_PH_BVH_BIN_NUM - 1 : k );
+}
+
+/* find the best split by binned SAH; returns the cost relative to the parent. */
+static double _zPH3DBVHFindSplit(_zPH3DBVHBuilder *b, int start, int num, zVec3D *cmin, zVec3D *cmax, double area, zAxis *axis, int *split)
+{
+  _zPH3DBVHBin bin[ZEO_PH_BVH_BIN_NUM];
+  zVec3D lmin, lmax, rmin, rmax;
+  double scale, cost, best = HUGE_VAL, larea[ZEO_PH_BVH_BIN_NUM];
+  int lnum[ZEO_PH_BVH_BIN_NUM], n, f;
+  register int i, k;
+
+  for( i=zX; i<=zZ; i++ ){
+    if( zIsTiny( cmax->e[i] - cmin->e[i] ) ) continue;
+    scale = ZEO_PH_BVH_BIN_NUM / ( cmax->e[i] - cmin->e[i] );
+    for( k=0; k<ZEO_PH_BVH_BIN_NUM; k++ ){
+      _zPH3DBVHBoxInit( &bin[k].vmin, &bin[k].vmax );
+      bin[k].n = 0;
+    }
+    for( k=start; k<start+num; k++ ){
+      f = b->bvh->face[k];
+      n = _zPH3DBVHBinIndex( b->c[f].e[i], cmin->e[i], scale );
+      _zPH3DBVHBoxMerge( &bin[n].vmin, &bin[n].vmax, &b->bmin[f], &b->bmax[f] );
+      bin[n].n++;
+    }
+    /* sweep from the left and then from the right */
+    _zPH3DBVHBoxInit( &lmin, &lmax );
+    for( n=0, k=0; k<ZEO_PH_BVH_BIN_NUM-1; k++ ){
+      _zPH3DBVHBoxMerge( &lmin, &lmax, &bin[k].vmin, &bin[k].vmax );
+      larea[k] = _zPH3DBVHBoxArea( &lmin, &lmax );
+      lnum[k] = ( n += bin[k].n );
+    }
+    _zPH3DBVHBoxInit( &rmin, &rmax );
+    for( n=0, k=ZEO_PH_BVH_BIN_NUM-1; k>0; k-- ){
+      _zPH3DBVHBoxMerge( &rmin, &rmax, &bin[k].vmin, &bin[k].vmax );
+      n += bin[k].n;
+      if( lnum[k-1] == 0 || n == 0 ) continue;
+      cost = 1 + ( larea[k-1]*lnum[k-1] + _zPH3DBVHBoxArea( &rmin, &rmax )*n ) / area;
+      if( cost < best ){
+        best = cost;
+        *axis = i;
+        *split = k - 1;
+      }
+    }
+  }
+  return best;
+}
+
+/* partition faces of a node; returns the number of faces of the left child. */
+static int _zPH3DBVHPartition(_zPH3DBVHBuilder *b, int start, int num, double cmin, double cmax, zAxis axis, int split)
+{
+  double scale;
+  int *face;
+  register int i, j;
+
+  scale = ZEO_PH_BVH_BIN_NUM / ( cmax - cmin );
+  face = b->bvh->face + start;
+  for( i=0, j=num-1; i<=j; ){
+    if( _zPH3DBVHBinIndex( b->c[face[i]].e[axis], cmin, scale ) <= split )
+      i++;
+    else{
+      zSwap( int, face[i], face[j] );
+      j--;
+    }
+  }
+  return i;
+}
+
+/* build a node of a bounding volume hierarchy and recursively its children. */
+static void _zPH3DBVHBuildNode(_zPH3DBVHBuilder *b, int id, int start, int num)
+{
+  zPH3DBVHNode *node;
+  zVec3D cmin, cmax;
+  double cost;
+  zAxis axis = zX;
+  int split = 0, nl, f;
+  register int i;
+
+  node = &b->bvh->node[id];
+  _zPH3DBVHBoxInit( &node->vmin, &node->vmax );
+  _zPH3DBVHBoxInit( &cmin, &cmax );
+  for( i=start; i<start+num; i++ ){
+    f = b->bvh->face[i];
+    _zPH3DBVHBoxMerge( &node->vmin, &node->vmax, &b->bmin[f], &b->bmax[f] );
+    _zPH3DBVHBoxMerge( &cmin, &cmax, &b->c[f], &b->c[f] );
+  }
+  node->child = start;
+  node->num = num;
+  if( num <= 2 ) return;
+  cost = _zPH3DBVHFindSplit( b, start, num, &cmin, &cmax, _zPH3DBVHBoxArea( &node->vmin, &node->vmax ), &axis, &split );
+  if( cost >= num && num <= ZEO_PH_BVH_LEAF_MAX ) return;
+  if( cost == HUGE_VAL ) /* all centroids coincide */
+    nl = num / 2;
+  else
+  if( ( nl = _zPH3DBVHPartition( b, start, num, cmin.e[axis], cmax.e[axis], axis, split ) ) == 0 || nl == num )
+    nl = num / 2;
+  node->child = b->bvh->nodenum;
+  node->num = 0;
+  b->bvh->nodenum += 2;
+  _zPH3DBVHBuildNode( b, node->child,   start,    nl );
+  _zPH3DBVHBuildNode( b, node->child+1, start+nl, num-nl );
+}
+
+/* build a bounding volume hierarchy of a polyhedron. */
+zPH3DBVH *zPH3DBVHBuild(zPH3DBVH *bvh, zPH3D *ph)
+{
+  _zPH3DBVHBuilder b;
+  zTri3D *t;
+  register int i, j;
+
+  bvh->ph = ph;
+  bvh->nodenum = 0;
+  bvh->node = NULL;
+  bvh->face = NULL;
+  if( zPH3DFaceNum(ph) == 0 ){
+    ZRUNWARN( ZEO_ERR_NOFACE );
+    return bvh;
+  }
+  bvh->node = zAlloc( zPH3DBVHNode, 2*zPH3DFaceNum(ph)-1 );
+  bvh->face = zAlloc( int, zPH3DFaceNum(ph) );
+  b.bvh = bvh;
+  b.c = zAlloc( zVec3D, zPH3DFaceNum(ph) );
+  b.bmin = zAlloc( zVec3D, zPH3DFaceNum(ph) );
+  b.bmax = zAlloc( zVec3D, zPH3DFaceNum(ph) );
+  if( !bvh->node || !bvh->face || !b.c || !b.bmin || !b.bmax ){
+    ZALLOCERROR();
+    zPH3DBVHDestroy( bvh );
+    bvh = NULL;
+    goto TERMINATE;
+  }
+  for( i=0; i<zPH3DFaceNum(ph); i++ ){
+    t = zPH3DFace(ph,i);
+    zVec3DCopy( zTri3DVert(t,0), &b.bmin[i] );
+    zVec3DCopy( zTri3DVert(t,0), &b.bmax[i] );
+    for( j=1; j<3; j++ )
+      _zPH3DBVHBoxMerge( &b.bmin[i], &b.bmax[i], zTri3DVert(t,j), zTri3DVert(t,j) );
+    zTri3DBarycenter( t, &b.c[i] );
+    bvh->face[i] = i;
+  }
+  bvh->nodenum = 1;
+  _zPH3DBVHBuildNode( &b, 0, 0, zPH3DFaceNum(ph) );
+
+ TERMINATE:
+  zFree( b.c );
+  zFree( b.bmin );
+  zFree( b.bmax );
+  return bvh;
+}
+
+/* destroy a bounding volume hierarchy of a polyhedron. */
+void zPH3DBVHDestroy(zPH3DBVH *bvh)
+{
+  zFree( bvh->node );
+  zFree( bvh->face );
+  bvh->nodenum = 0;
+  bvh->ph = NULL;
+}
+
+/* closest point query */
+
+/* find the closest point on faces under a node by branch-and-bound. */
+static void _zPH3DBVHClosest(zPH3DBVH *bvh, int id, zVec3D *p, zVec3D *cp, double *dmin)
+{
+  zPH3DBVHNode *node, *child;
+  zVec3D ncp;
+  double d, d0, d1;
+  register int i;
+
+  node = &bvh->node[id];
+  if( node->num > 0 ){
+    for( i=node->child; i<node->child+node->num; i++ )
+      if( ( d = zTri3DClosest( zPH3DFace(bvh->ph,bvh->face[i]), p, &ncp ) ) < *dmin ){
+        zVec3DCopy( &ncp, cp );
+        *dmin = d;
+      }
+    return;
+  }
+  child = &bvh->node[node->child];
+  d0 = _zPH3DBVHBoxSqrDist( &child[0].vmin, &child[0].vmax, p );
+  d1 = _zPH3DBVHBoxSqrDist( &child[1].vmin, &child[1].vmax, p );
+  if( d0 <= d1 ){
+    if( d0 < zSqr(*dmin) ) _zPH3DBVHClosest( bvh, node->child,   p, cp, dmin );
+    if( d1 < zSqr(*dmin) ) _zPH3DBVHClosest( bvh, node->child+1, p, cp, dmin );
+  } else{
+    if( d1 < zSqr(*dmin) ) _zPH3DBVHClosest( bvh, node->child+1, p, cp, dmin );
+    if( d0 < zSqr(*dmin) ) _zPH3DBVHClosest( bvh, node->child,   p, cp, dmin );
+  }
+}
+
+/* closest point on a polyhedron by a bounding volume hierarchy. */
+double zPH3DBVHClosest(zPH3DBVH *bvh, zVec3D *p, zVec3D *cp)
+{
+  double dmin = HUGE_VAL;
+
+  if( bvh->nodenum == 0 ){
+    ZRUNWARN( ZEO_ERR_NOFACE );
+    zVec3DCopy( p, cp );
+    return 0;
+  }
+  _zPH3DBVHClosest( bvh, 0, p, cp, &dmin );
+  return dmin;
+}
+
+/* distance from a point to a polyhedron by a bounding volume hierarchy. */
+double zPH3DBVHPointDist(zPH3DBVH *bvh, zVec3D *p)
+{
+  zVec3D cp;
+  return zPH3DBVHClosest( bvh, p, &cp );
+}
+
+/* point inclusion test */
+
+#define ZEO_PH_BVH_RAY_TOL 1.0e-9 /* tolerance of barycentric coordinates to detect degenerate crossings */
+
+/* directions of rays to count crossings, chosen not to be aligned with typical faces. */
+static const double __zeo_ph_bvh_ray_dir[][3] = {
+  { 0.5773502692, 0.3090169944, 0.7557613141 },
+  {-0.2588190451, 0.8660254038,-0.4275550934 },
+  { 0.1045284633,-0.6427876097, 0.7587581774 },
+};
+#define ZEO_PH_BVH_RAY_NUM ( (int)( sizeof(__zeo_ph_bvh_ray_dir) / sizeof(__zeo_ph_bvh_ray_dir[0]) ) )
+
+/* check if a half-line intersects with an axis-aligned box by the slab method. */
+static bool _zPH3DBVHRayIsOverlap(zPH3DBVHNode *node, zVec3D *org, zVec3D *idir)
+{
+  double t1, t2, tmin = 0, tmax = HUGE_VAL;
+  register int i;
+
+  for( i=zX; i<=zZ; i++ ){
+    t1 = ( node->vmin.e[i] - org->e[i] ) * idir->e[i];
+    t2 = ( node->vmax.e[i] - org->e[i] ) * idir->e[i];
+    if( t1 > t2 ) zSwap( double, t1, t2 );
+    if( t1 > tmin ) tmin = t1;
+    if( t2 < tmax ) tmax = t2;
+    if( tmin > tmax ) return false;
+  }
+  return true;
+}
+
+/* count crossings of a half-line and a triangle; returns -1 if the crossing is degenerate. */
+static int _zPH3DBVHRayCrossTri(zTri3D *t, zVec3D *org, zVec3D *dir)
+{
+  zVec3D e1, e2, s, pv, qv;
+  double det, u, v;
+
+  zVec3DSub( zTri3DVert(t,1), zTri3DVert(t,0), &e1 );
+  zVec3DSub( zTri3DVert(t,2), zTri3DVert(t,0), &e2 );
+  zVec3DSub( org, zTri3DVert(t,0), &s );
+  zVec3DOuterProd( dir, &e2, &pv );
+  if( zIsTiny( ( det = zVec3DInnerProd( &e1, &pv ) ) ) ) /* parallel */
+    return zIsTiny( zVec3DInnerProd( &s, zTri3DNorm(t) ) ) ? -1 : 0;
+  u = zVec3DInnerProd( &s, &pv ) / det;
+  if( u < -ZEO_PH_BVH_RAY_TOL || u > 1 + ZEO_PH_BVH_RAY_TOL ) return 0;
+  zVec3DOuterProd( &s, &e1, &qv );
+  v = zVec3DInnerProd( dir, &qv ) / det;
+  if( v < -ZEO_PH_BVH_RAY_TOL || u + v > 1 + ZEO_PH_BVH_RAY_TOL ) return 0;
+  if( zVec3DInnerProd( &e2, &qv ) / det < 0 ) return 0; /* behind the origin */
+  if( u < ZEO_PH_BVH_RAY_TOL || v < ZEO_PH_BVH_RAY_TOL || u + v > 1 - ZEO_PH_BVH_RAY_TOL )
+    return -1; /* crossing at an edge or a vertex */
+  return 1;
+}
+
+/* count crossings of a half-line and faces under a node; returns -1 if any crossing is degenerate. */
+static int _zPH3DBVHRayCross(zPH3DBVH *bvh, int id, zVec3D *org, zVec3D *dir, zVec3D *idir)
+{
+  zPH3DBVHNode *node;
+  int n = 0, c;
+  register int i;
+
+  node = &bvh->node[id];
+  if( !_zPH3DBVHRayIsOverlap( node, org, idir ) ) return 0;
+  if( node->num > 0 ){
+    for( i=node->child; i<node->child+node->num; i++ ){
+      if( ( c = _zPH3DBVHRayCrossTri( zPH3DFace(bvh->ph,bvh->face[i]), org, dir ) ) < 0 ) return -1;
+      n += c;
+    }
+    return n;
+  }
+  if( ( n = _zPH3DBVHRayCross( bvh, node->child, org, dir, idir ) ) < 0 ||
+      ( c = _zPH3DBVHRayCross( bvh, node->child+1, org, dir, idir ) ) < 0 ) return -1;
+  return n + c;
+}
+
+/* check if a point is inside of a polyhedron by a bounding volume hierarchy. */
+bool zPH3DBVHPointIsInside(zPH3DBVH *bvh, zVec3D *p, bool rim)
+{
+  zVec3D dir, idir;
+  int n = 0;
+  register int i;
+
+  if( bvh->nodenum == 0 ) return false;
+  if( zPH3DBVHPointDist( bvh, p ) < zTOL ) return rim;
+  for( i=0; i<ZEO_PH_BVH_RAY_NUM; i++ ){
+    zVec3DCreate( &dir, __zeo_ph_bvh_ray_dir[i][0], __zeo_ph_bvh_ray_dir[i][1], __zeo_ph_bvh_ray_dir[i][2] );
+    zVec3DCreate( &idir, 1.0/dir.c.x, 1.0/dir.c.y, 1.0/dir.c.z );
+    if( ( n = _zPH3DBVHRayCross( bvh, 0, p, &dir, &idir ) ) >= 0 ) break;
+  }
+  return n > 0 && n % 2 == 1;
+}
+
+/* check if points are inside of a polyhedron by a bounding volume hierarchy. */
+int zPH3DBVHPointArrayIsInside(zPH3DBVH *bvh, zVec3D p[], int num, bool rim, bool inside[])
+{
+  register int i;
+  int n = 0;
+
+  for( i=0; i<num; i++ )
+    if( ( inside[i] = zPH3DBVHPointIsInside( bvh, &p[i], rim ) ) ) n++;
+  return n;
+}
+
+/* distance to enter an axis-aligned box along a ray within a range; returns false if the ray misses it. */
+static bool _zPH3DBVHRayEnter(zPH3DBVHNode *node, zRay3D *ray, double tmax, double *tmin)
+{
+  double t1, t2;
+  register int i;
+
+  for( *tmin=0, i=zX; i<=zZ; i++ ){
+    t1 = ( node->vmin.e[i] - zRay3DOrg(ray)->e[i] ) * zRay3DIDir(ray)->e[i];
+    t2 = ( node->vmax.e[i] - zRay3DOrg(ray)->e[i] ) * zRay3DIDir(ray)->e[i];
+    if( t1 > t2 ) zSwap( double, t1, t2 );
+    if( t1 > *tmin ) *tmin = t1;
+    if( t2 < tmax ) tmax = t2;
+    if( *tmin > tmax ) return false;
+  }
+  return true;
+}
+
+/* find the nearest intersection of a ray and faces under a node. */
+static bool _zPH3DBVHRaycast(zPH3DBVH *bvh, int id, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zPH3DBVHNode *node;
+  double tn, tf;
+  int cn, cf;
+  bool hit = false;
+  register int i;
+
+  node = &bvh->node[id];
+  if( node->num > 0 ){
+    for( i=node->child; i<node->child+node->num; i++ )
+      if( zTri3DRaycast( zPH3DFace(bvh->ph,bvh->face[i]), ray, t, norm ) ) hit = true;
+    return hit;
+  }
+  cn = node->child;
+  cf = node->child + 1;
+  if( !_zPH3DBVHRayEnter( &bvh->node[cn], ray, *t, &tn ) ) tn = HUGE_VAL;
+  if( !_zPH3DBVHRayEnter( &bvh->node[cf], ray, *t, &tf ) ) tf = HUGE_VAL;
+  if( tf < tn ){ /* visit the nearer child first */
+    zSwap( int, cn, cf );
+    zSwap( double, tn, tf );
+  }
+  if( tn < *t && _zPH3DBVHRaycast( bvh, cn, ray, t, norm ) ) hit = true;
+  if( tf < *t && _zPH3DBVHRaycast( bvh, cf, ray, t, norm ) ) hit = true;
+  return hit;
+}
+
+/* intersection of a ray and a polyhedron by a bounding volume hierarchy. */
+bool zPH3DBVHRaycast(zPH3DBVH *bvh, zRay3D *ray, double *t, zVec3D *norm)
+{
+  double t0;
+
+  if( bvh->nodenum == 0 || !_zPH3DBVHRayEnter( &bvh->node[0], ray, *t, &t0 ) ) return false;
+  return _zPH3DBVHRaycast( bvh, 0, ray, t, norm );
+}
@@ -0,0 +1,229 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_ph_he - half-edge adjacency of a polyhedron.
+ */
+
+#include <zeo/zeo_ph.h>
+
+/* a half-edge not paired yet */
+#define ZEO_PH3DHE_UNPAIRED -3
+
+/* hash key of an edge, which is independent of its direction. */
+static unsigned int _zPH3DHEHash(int v1, int v2)
+{
+  return v1 < v2 ?
+    (unsigned int)v1 * 73856093U ^ (unsigned int)v2 * 19349663U :
+    (unsigned int)v2 * 73856093U ^ (unsigned int)v1 * 19349663U;
+}
+
+/* check if a face of a half-edge is degenerate, namely, it has coincident vertices. */
+static bool _zPH3DHEIsDegenerate(zPH3DHE *he, int h)
+{
+  h = 3 * zPH3DHEFace(h);
+  return zPH3DHEOrg(he,h) == zPH3DHEOrg(he,h+1) ||
+         zPH3DHEOrg(he,h+1) == zPH3DHEOrg(he,h+2) ||
+         zPH3DHEOrg(he,h+2) == zPH3DHEOrg(he,h);
+}
+
+/* pair a half-edge with another sharing the same edge. */
+static void _zPH3DHEPair(zPH3DHE *he, int h, int head[], int next[], unsigned int mask)
+{
+  int v1, v2, twin = -1, num = 0;
+  bool manifold = true;
+  register int g;
+
+  v1 = zPH3DHEOrg(he,h);
+  v2 = zPH3DHEDest(he,h);
+  for( g=head[_zPH3DHEHash(v1,v2)&mask]; g>=0; g=next[g] ){
+    if( zPH3DHEOrg(he,g) == v2 && zPH3DHEDest(he,g) == v1 && g != h ){
+      twin = g;
+      num++;
+    } else
+    if( zPH3DHEOrg(he,g) == v1 && zPH3DHEDest(he,g) == v2 && g != h )
+      manifold = false; /* shared in the same direction */
+  }
+  if( num == 0 && manifold ){
+    zPH3DHETwin(he,h) = ZEO_PH3DHE_BOUNDARY;
+  } else
+  if( num == 1 && manifold && zPH3DHETwin(he,twin) == ZEO_PH3DHE_UNPAIRED ){
+    zPH3DHETwin(he,h) = twin;
+    zPH3DHETwin(he,twin) = h;
+  } else{ /* all half-edges on the edge are marked */
+    for( g=head[_zPH3DHEHash(v1,v2)&mask]; g>=0; g=next[g] )
+      if( ( zPH3DHEOrg(he,g) == v1 && zPH3DHEDest(he,g) == v2 ) ||
+          ( zPH3DHEOrg(he,g) == v2 && zPH3DHEDest(he,g) == v1 ) )
+        zPH3DHETwin(he,g) = ZEO_PH3DHE_NONMANIFOLD;
+  }
+}
+
+/* build the half-edge adjacency of a polyhedron. */
+zPH3DHE *zPH3DHEBuild(zPH3DHE *he, zPH3D *ph)
+{
+  int n, *head, *next;
+  unsigned int mask, key;
+  register int h;
+
+  he->ph = ph;
+  n = zPH3DHENum(he);
+  for( mask=1; mask<(unsigned int)n; mask<<=1 );
+  he->org = zAlloc( int, _zMax(n,1) );
+  he->twin = zAlloc( int, _zMax(n,1) );
+  he->vhe = zAlloc( int, _zMax(zPH3DVertNum(ph),1) );
+  head = zAlloc( int, mask );
+  next = zAlloc( int, _zMax(n,1) );
+  if( !he->org || !he->twin || !he->vhe || !head || !next ){
+    ZALLOCERROR();
+    goto FAILURE;
+  }
+  for( h=0; h<n; h++ ){
+    zPH3DHEOrg(he,h) = zPH3DFaceVert(ph,zPH3DHEFace(h),h%3) - zPH3DVertBuf(ph);
+    if( zPH3DHEOrg(he,h) < 0 || zPH3DHEOrg(he,h) >= zPH3DVertNum(ph) ){
+      ZRUNERROR( ZEO_ERR_INVINDEX );
+      goto FAILURE;
+    }
+  }
+  /* register half-edges to a hash table keyed by their end vertices;
+     those of degenerate faces are excluded from the adjacency. */
+  for( h=0; h<(int)mask; h++ ) head[h] = -1;
+  mask--;
+  for( h=0; h<n; h++ ){
+    if( _zPH3DHEIsDegenerate( he, h ) ){
+      zPH3DHETwin(he,h) = ZEO_PH3DHE_NONMANIFOLD;
+      continue;
+    }
+    key = _zPH3DHEHash( zPH3DHEOrg(he,h), zPH3DHEDest(he,h) ) & mask;
+    next[h] = head[key];
+    head[key] = h;
+    zPH3DHETwin(he,h) = ZEO_PH3DHE_UNPAIRED;
+  }
+  for( h=0; h<n; h++ )
+    if( zPH3DHETwin(he,h) == ZEO_PH3DHE_UNPAIRED )
+      _zPH3DHEPair( he, h, head, next, mask );
+  /* outgoing half-edges of vertices; those from the boundary are preferred */
+  for( h=0; h<zPH3DVertNum(ph); h++ ) zPH3DHEVertHE(he,h) = -1;
+  for( h=0; h<n; h++ )
+    if( !_zPH3DHEIsDegenerate( he, h ) &&
+        ( zPH3DHEVertHE(he,zPH3DHEOrg(he,h)) < 0 ||
+          zPH3DHETwin(he,zPH3DHEPrev(h)) < 0 ) )
+      zPH3DHEVertHE(he,zPH3DHEOrg(he,h)) = h;
+  zFree( head );
+  zFree( next );
+  return he;
+
+ FAILURE:
+  zFree( head );
+  zFree( next );
+  zPH3DHEDestroy( he );
+  return NULL;
+}
+
+/* destroy the half-edge adjacency of a polyhedron. */
+void zPH3DHEDestroy(zPH3DHE *he)
+{
+  zFree( he->org );
+  zFree( he->twin );
+  zFree( he->vhe );
+  he->ph = NULL;
+}
+
+/* a face adjacent to a face across an edge. */
+int zPH3DHEFaceNeighbor(zPH3DHE *he, int i, int j)
+{
+  int twin;
+
+  return ( twin = zPH3DHETwin(he,3*i+j) ) < 0 ? -1 : zPH3DHEFace(twin);
+}
+
+/* traverse a fan of faces around a vertex. */
+static int _zPH3DHEVertFan(zPH3DHE *he, int v, int nb[], int f[], int size)
+{
+  int n = 0;
+  register int h;
+
+  if( ( h = zPH3DHEVertHE(he,v) ) < 0 ) return 0;
+  if( nb && zPH3DHETwin(he,zPH3DHEPrev(h)) < 0 ){
+    /* the fan is open, and the first vertex is on the previous edge */
+    if( n < size ) nb[n] = zPH3DHEOrg(he,zPH3DHEPrev(h));
+    n++;
+  }
+  do{
+    if( n < size ){
+      if( nb ) nb[n] = zPH3DHEDest(he,h);
+      if( f ) f[n] = zPH3DHEFace(h);
+    }
+    n++;
+  } while( zPH3DHETwin(he,h) >= 0 &&
+           ( h = zPH3DHENext(zPH3DHETwin(he,h)) ) != zPH3DHEVertHE(he,v) );
+  return n;
+}
+
+/* vertices adjacent to a vertex. */
+int zPH3DHEVertNeighbor(zPH3DHE *he, int v, int nb[], int size)
+{
+  return _zPH3DHEVertFan( he, v, nb, NULL, size );
+}
+
+/* faces which share a vertex. */
+int zPH3DHEVertFace(zPH3DHE *he, int v, int f[], int size)
+{
+  return _zPH3DHEVertFan( he, v, NULL, f, size );
+}
+
+/* the boundary half-edge which follows a boundary half-edge. */
+int zPH3DHEBoundaryNext(zPH3DHE *he, int h)
+{
+  if( !zPH3DHEIsBoundary(he,h) ) return -1;
+  for( h=zPH3DHENext(h); zPH3DHETwin(he,h) >= 0; h=zPH3DHENext(zPH3DHETwin(he,h)) );
+  return zPH3DHEIsBoundary(he,h) ? h : -1;
+}
+
+/* classify boundary half-edges into loops. */
+int zPH3DHEBoundaryLoop(zPH3DHE *he, int loop[])
+{
+  int num = 0;
+  register int h, g;
+
+  for( h=0; h<zPH3DHENum(he); h++ ) loop[h] = -1;
+  for( h=0; h<zPH3DHENum(he); h++ ){
+    if( !zPH3DHEIsBoundary(he,h) || loop[h] >= 0 ) continue;
+    for( g=h; g>=0 && loop[g]<0; g=zPH3DHEBoundaryNext(he,g) )
+      loop[g] = num;
+    num++;
+  }
+  return num;
+}
+
+/* check if a polyhedron is manifold. */
+bool zPH3DHEIsManifold(zPH3DHE *he)
+{
+  int *deg;
+  bool ret = true;
+  register int i;
+
+  for( i=0; i<zPH3DHENum(he); i++ )
+    if( zPH3DHETwin(he,i) == ZEO_PH3DHE_NONMANIFOLD ) return false;
+  /* faces around each vertex have to form a single fan */
+  if( !( deg = zAlloc( int, _zMax(zPH3DVertNum(he->ph),1) ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  for( i=0; i<zPH3DHENum(he); i++ ) deg[zPH3DHEOrg(he,i)]++;
+  for( i=0; i<zPH3DVertNum(he->ph); i++ )
+    if( zPH3DHEVertFace( he, i, NULL, 0 ) != deg[i] ){
+      ret = false;
+      break;
+    }
+  zFree( deg );
+  return ret;
+}
+
+/* check if a polyhedron is closed. */
+bool zPH3DHEIsClosed(zPH3DHE *he)
+{
+  register int i;
+
+  for( i=0; i<zPH3DHENum(he); i++ )
+    if( zPH3DHEIsBoundary(he,i) ) return false;
+  return zPH3DHEIsManifold( he );
+}
@@ -0,0 +1,203 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_ph_idx - compact indexed representation of a polyhedron.
+ */
+
+#include <zeo/zeo_ph.h>
+
+/* initialize a compact indexed polyhedron. */
+zPH3DIdx *zPH3DIdxInit(zPH3DIdx *ph)
+{
+  ph->vertnum = ph->facenum = 0;
+  ph->vert = NULL;
+  ph->idx = NULL;
+  ph->norm = NULL;
+  return ph;
+}
+
+/* allocate arrays of a compact indexed polyhedron. */
+zPH3DIdx *zPH3DIdxAlloc(zPH3DIdx *ph, int vn, int fn, bool norm)
+{
+  zPH3DIdxInit( ph );
+  if( vn > 0 && !( ph->vert = zAlloc( zVec3D, vn ) ) ) goto ERROR;
+  if( fn > 0 ){
+    if( !( ph->idx = zAlloc( int32_t, fn*3 ) ) ) goto ERROR;
+    if( norm && !( ph->norm = zAlloc( float, fn*3 ) ) ) goto ERROR;
+  }
+  ph->vertnum = vn;
+  ph->facenum = fn;
+  return ph;
+
+ ERROR:
+  ZALLOCERROR();
+  zPH3DIdxDestroy( ph );
+  return NULL;
+}
+
+/* destroy a compact indexed polyhedron. */
+void zPH3DIdxDestroy(zPH3DIdx *ph)
+{
+  if( !ph ) return;
+  zFree( ph->vert );
+  zFree( ph->idx );
+  zFree( ph->norm );
+  zPH3DIdxInit( ph );
+}
+
+/* check if indices of vertices of a compact indexed polyhedron are valid. */
+static bool _zPH3DIdxIsValid(zPH3DIdx *ph)
+{
+  register int i;
+
+  for( i=0; i<zPH3DIdxFaceNum(ph)*3; i++ )
+    if( ph->idx[i] < 0 || ph->idx[i] >= zPH3DIdxVertNum(ph) ){
+      ZRUNERROR( ZEO_ERR_INVINDEX );
+      return false;
+    }
+  return true;
+}
+
+/* convert a polyhedron to a compact indexed polyhedron. */
+zPH3DIdx *zPH3DToIdx(zPH3D *src, zPH3DIdx *dest, bool norm)
+{
+  register int i, j;
+
+  if( !zPH3DIdxAlloc( dest, zPH3DVertNum(src), zPH3DFaceNum(src), norm ) ) return NULL;
+  memcpy( dest->vert, zPH3DVertBuf(src), sizeof(zVec3D)*zPH3DVertNum(src) );
+  for( i=0; i<zPH3DFaceNum(src); i++ ){
+    for( j=0; j<3; j++ )
+      zPH3DIdxFaceVertID(dest,i,j) = zPH3DFaceVert(src,i,j) - zPH3DVertBuf(src);
+    if( norm )
+      for( j=0; j<3; j++ )
+        dest->norm[3*i+j] = zPH3DFaceNorm(src,i)->e[j];
+  }
+  if( !_zPH3DIdxIsValid( dest ) ){
+    zPH3DIdxDestroy( dest );
+    return NULL;
+  }
+  return dest;
+}
+
+/* convert a compact indexed polyhedron to a polyhedron. */
+zPH3D *zPH3DIdxToPH3D(zPH3DIdx *src, zPH3D *dest)
+{
+  register int i;
+
+  if( !_zPH3DIdxIsValid( src ) ||
+      !zPH3DAlloc( dest, zPH3DIdxVertNum(src), zPH3DIdxFaceNum(src) ) ) return NULL;
+  memcpy( zPH3DVertBuf(dest), src->vert, sizeof(zVec3D)*zPH3DIdxVertNum(src) );
+  for( i=0; i<zPH3DIdxFaceNum(src); i++ )
+    zTri3DCreate( zPH3DFace(dest,i),
+      zPH3DVert(dest,zPH3DIdxFaceVertID(src,i,0)),
+      zPH3DVert(dest,zPH3DIdxFaceVertID(src,i,1)),
+      zPH3DVert(dest,zPH3DIdxFaceVertID(src,i,2)) );
+  return dest;
+}
+
+/* a face of a compact indexed polyhedron with the normal vector calculated. */
+static zTri3D *_zPH3DIdxFaceCalc(zPH3DIdx *ph, int i, zTri3D *tri)
+{
+  zTri3DCreate( tri, zPH3DIdxFaceVert(ph,i,0), zPH3DIdxFaceVert(ph,i,1), zPH3DIdxFaceVert(ph,i,2) );
+  return tri;
+}
+
+/* calculate normal vectors of faces of a compact indexed polyhedron. */
+zPH3DIdx *zPH3DIdxCalcNorm(zPH3DIdx *ph)
+{
+  zTri3D tri;
+  register int i, j;
+
+  if( !_zPH3DIdxIsValid( ph ) ) return NULL;
+  if( !ph->norm && zPH3DIdxFaceNum(ph) > 0 &&
+      !( ph->norm = zAlloc( float, zPH3DIdxFaceNum(ph)*3 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  for( i=0; i<zPH3DIdxFaceNum(ph); i++ ){
+    _zPH3DIdxFaceCalc( ph, i, &tri );
+    for( j=0; j<3; j++ )
+      ph->norm[3*i+j] = zTri3DNorm(&tri)->e[j];
+  }
+  return ph;
+}
+
+/* a face of a compact indexed polyhedron as a triangle. */
+zTri3D *zPH3DIdxFace(zPH3DIdx *ph, int i, zTri3D *tri)
+{
+  if( !zPH3DIdxHasNorm(ph) ) return _zPH3DIdxFaceCalc( ph, i, tri );
+  zTri3DSetVert( tri, 0, zPH3DIdxFaceVert(ph,i,0) );
+  zTri3DSetVert( tri, 1, zPH3DIdxFaceVert(ph,i,1) );
+  zTri3DSetVert( tri, 2, zPH3DIdxFaceVert(ph,i,2) );
+  zVec3DCreate( zTri3DNorm(tri), ph->norm[3*i], ph->norm[3*i+1], ph->norm[3*i+2] );
+  return tri;
+}
+
+/* closest point on a compact indexed polyhedron. */
+double zPH3DIdxClosest(zPH3DIdx *ph, zVec3D *p, zVec3D *cp)
+{
+  zTri3D tri;
+  zVec3D ncp;
+  double d, dmin;
+  register int i;
+
+  if( zPH3DIdxFaceNum(ph) == 0 ){
+    ZRUNWARN( ZEO_ERR_NOFACE );
+    zVec3DCopy( p, cp );
+    return 0;
+  }
+  /* normal vectors in single precision are not used for accuracy. */
+  dmin = zTri3DClosest( _zPH3DIdxFaceCalc( ph, 0, &tri ), p, cp );
+  for( i=1; i<zPH3DIdxFaceNum(ph); i++ )
+    if( ( d = zTri3DClosest( _zPH3DIdxFaceCalc( ph, i, &tri ), p, &ncp ) ) < dmin ){
+      zVec3DCopy( &ncp, cp );
+      dmin = d;
+    }
+  return dmin;
+}
+
+/* distance from a point to a compact indexed polyhedron. */
+double zPH3DIdxPointDist(zPH3DIdx *ph, zVec3D *p)
+{
+  zVec3D cp;
+  return zPH3DIdxClosest( ph, p, &cp );
+}
+
+/* volume of a cone which consists of a face and the original point. */
+static double _zPH3DIdxConeVolume(zPH3DIdx *ph, int i)
+{
+  zVec3D *v1, *v2, *v3;
+
+  v1 = zPH3DIdxFaceVert(ph,i,0);
+  v2 = zPH3DIdxFaceVert(ph,i,1);
+  v3 = zPH3DIdxFaceVert(ph,i,2);
+  return v1->c.x * ( v2->c.y*v3->c.z - v2->c.z*v3->c.y )
+       + v1->c.y * ( v2->c.z*v3->c.x - v2->c.x*v3->c.z )
+       + v1->c.z * ( v2->c.x*v3->c.y - v2->c.y*v3->c.x );
+}
+
+/* volume of a compact indexed polyhedron. */
+double zPH3DIdxVolume(zPH3DIdx *ph)
+{
+  double v = 0;
+  register int i;
+
+  for( i=0; i<zPH3DIdxFaceNum(ph); i++ )
+    v += _zPH3DIdxConeVolume( ph, i );
+  return v / 6;
+}
+
+/* barycenter of a compact indexed polyhedron. */
+zVec3D *zPH3DIdxBarycenter(zPH3DIdx *ph, zVec3D *c)
+{
+  double v, vol = 0;
+  register int i, j;
+
+  zVec3DZero( c );
+  for( i=0; i<zPH3DIdxFaceNum(ph); i++ ){
+    vol += ( v = _zPH3DIdxConeVolume( ph, i ) );
+    for( j=0; j<3; j++ )
+      zVec3DCatDRC( c, v, zPH3DIdxFaceVert(ph,i,j) );
+  }
+  return zVec3DMulDRC( c, 0.25 / vol );
+}
@@ -61,21 +61,22 @@ typedef enum{
 typedef struct{
   const char *typestr;
   zPLYDATA type;
+  int size; /* size in binary format */
   double (* read_double)(FILE*);
   int (* read_int)(FILE*);
 } zPLYPrp;
 
 static zPLYPrp z_ply_prp[] = {
-  { "char",   ZEO_PLY_DATA_CHAR,   NULL, NULL },
-  { "uchar",  ZEO_PLY_DATA_UCHAR,  NULL, NULL },
-  { "short",  ZEO_PLY_DATA_SHORT,  NULL, NULL },
-  { "ushort", ZEO_PLY_DATA_USHORT, NULL, NULL },
-  { "int",    ZEO_PLY_DATA_INT,    NULL, NULL },
-  { "uint",   ZEO_PLY_DATA_UINT,   NULL, NULL },
-  { "float",  ZEO_PLY_DATA_FLOAT,  NULL, NULL },
-  { "double", ZEO_PLY_DATA_DOUBLE, NULL, NULL },
-  { "list",   ZEO_PLY_DATA_LIST,   NULL, NULL },
-  { NULL,     ZEO_PLY_DATA_NONE,   NULL, NULL },
+  { "char",   ZEO_PLY_DATA_CHAR,   1, NULL, NULL },
+  { "uchar",  ZEO_PLY_DATA_UCHAR,  1, NULL, NULL },
+  { "short",  ZEO_PLY_DATA_SHORT,  2, NULL, NULL },
+  { "ushort", ZEO_PLY_DATA_USHORT, 2, NULL, NULL },
+  { "int",    ZEO_PLY_DATA_INT,    4, NULL, NULL },
+  { "uint",   ZEO_PLY_DATA_UINT,   4, NULL, NULL },
+  { "float",  ZEO_PLY_DATA_FLOAT,  4, NULL, NULL },
+  { "double", ZEO_PLY_DATA_DOUBLE, 8, NULL, NULL },
+  { "list",   ZEO_PLY_DATA_LIST,   0, NULL, NULL },
+  { NULL,     ZEO_PLY_DATA_NONE,   0, NULL, NULL },
 };
 
 static const zPLYPrp *_zPLYPrpFind(char *str)
@@ -391,33 +392,73 @@ static bool _zPH3DFReadPLYVert(FILE *fp, zPH3D *ph, zPLY *ply, zPLYElement *elem
   return true;
 }
 
-static bool _zPH3DFReadPLYFace(FILE *fp, zPH3D *ph, zPLY *ply, zPLYElement *elem)
+/* buffer of vertex indices of triangles */
+typedef struct{
+  int num;  /* number of triangles */
+  int size; /* size of buffer */
+  int *idx; /* vertex indices (three for each triangle) */
+} _zPLYTriBuf;
+
+static void _zPLYTriBufInit(_zPLYTriBuf *tb)
 {
-  register int i, j, k;
-  int nv; /* number of vertices of a face */
-  int nf = 0; /* number of faces */
-  int v1, v2, v3; /* vertex indices */
-  long pos;
+  tb->num = tb->size = 0;
+  tb->idx = NULL;
+}
 
-  pos = ftell( fp );
-  for( i=0; i<elem->num; i++ ){
-    for( j=0; j<elem->prpnum; j++ ){
-      if( elem->prp[j]->type != ZEO_PLY_DATA_LIST ){
-        elem->prp[j]->read_double( fp ); /* discard data */
-        continue;
-      }
-      nv = ply->facelistnum->read_int( fp );
-      for( k=0; k<nv; k++ )
-        ply->facelistelem->read_int( fp );
-      nf += zMax( nv - 2, 0 );
+static void _zPLYTriBufDestroy(_zPLYTriBuf *tb)
+{
+  zFree( tb->idx );
+  _zPLYTriBufInit( tb );
+}
+
+static bool _zPLYTriBufAdd(_zPLYTriBuf *tb, int v1, int v2, int v3)
+{
+  int *idx;
+
+  if( tb->num == tb->size ){
+    if( !( idx = zRealloc( tb->idx, int, ( tb->size*2+64 )*3 ) ) ){
+      ZALLOCERROR();
+      return false;
     }
+    tb->idx = idx;
+    tb->size = tb->size*2 + 64;
   }
-  if( nf > 0 ){
-    zArrayAlloc( &ph->face, zTri3D, nf );
+  tb->idx[3*tb->num]   = v1;
+  tb->idx[3*tb->num+1] = v2;
+  tb->idx[3*tb->num+2] = v3;
+  tb->num++;
+  return true;
+}
+
+/* create faces of a polyhedron from a buffer of vertex indices. */
+static bool _zPLYTriBufToPH3D(_zPLYTriBuf *tb, zPH3D *ph)
+{
+  register int i;
+
+  for( i=0; i<tb->num*3; i++ )
+    if( tb->idx[i] < 0 || tb->idx[i] >= zPH3DVertNum(ph) ){
+      ZRUNERROR( ZEO_ERR_INVINDEX );
+      return false;
+    }
+  if( tb->num > 0 ){
+    zArrayAlloc( &ph->face, zTri3D, tb->num );
     if( !zPH3DFaceBuf(ph) ) return false;
   }
-  fseek( fp, pos, SEEK_SET );
-  nf = 0;
+  for( i=0; i<tb->num; i++ )
+    zTri3DCreate( zPH3DFace(ph,i),
+      zPH3DVert(ph,tb->idx[3*i]), zPH3DVert(ph,tb->idx[3*i+1]), zPH3DVert(ph,tb->idx[3*i+2]) );
+  return true;
+}
+
+static bool _zPH3DFReadPLYFace(FILE *fp, zPH3D *ph, zPLY *ply, zPLYElement *elem)
+{
+  register int i, j, k;
+  int nv; /* number of vertices of a face */
+  int v1, v2, v3; /* vertex indices */
+  _zPLYTriBuf tb;
+  bool ret = false;
+
+  _zPLYTriBufInit( &tb );
   for( i=0; i<elem->num; i++ ){
     for( j=0; j<elem->prpnum; j++ ){
       if( elem->prp[j]->type != ZEO_PLY_DATA_LIST ){
@@ -431,11 +472,15 @@ static bool _zPH3DFReadPLYFace(FILE *fp, zPH3D *ph, zPLY *ply, zPLYElement *elem
       v2 = ply->facelistelem->read_int( fp );
       for( k=0; k<nv; k++ ){
         v3 = ply->facelistelem->read_int( fp );
-        zTri3DCreate( zPH3DFace(ph,nf++), zPH3DVert(ph,v1), zPH3DVert(ph,v2), zPH3DVert(ph,v3) );
+        if( !_zPLYTriBufAdd( &tb, v1, v2, v3 ) ) goto TERMINATE;
+        v2 = v3;
       }
     }
   }
-  return true;
+  ret = _zPLYTriBufToPH3D( &tb, ph );
+ TERMINATE:
+  _zPLYTriBufDestroy( &tb );
+  return ret;
 }
 
 static bool _zPH3DFReadPLYElem(FILE *fp, zPH3D *ph, zPLY *ply, zPLYElement *elem)
@@ -454,10 +499,200 @@ static bool _zPH3DFReadPLYElem(FILE *fp, zPH3D *ph, zPLY *ply, zPLYElement *elem
   return true;
 }
 
+/* binary data section, which is read by chunks */
+
+#define ZEO_PLY_BIN_BUFSIZ 65536
+
+typedef struct{
+  FILE *fp;
+  bool rev;            /* whether bytes have to be reverted */
+  unsigned char *buf;  /* buffer */
+  int head;            /* head of unread data */
+  int tail;            /* tail of unread data */
+} _zPLYBin;
+
+static bool _zPLYBinInit(_zPLYBin *bin, FILE *fp, zPLY *ply)
+{
+  bin->fp = fp;
+  bin->rev = ply->format == ZEO_PLY_FORMAT_BIN_REV ? true : false;
+  bin->head = bin->tail = 0;
+  if( !( bin->buf = zAlloc( unsigned char, ZEO_PLY_BIN_BUFSIZ ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  return true;
+}
+
+/* get a pointer to the next data of a given size. */
+static unsigned char *_zPLYBinGet(_zPLYBin *bin, int size)
+{
+  unsigned char *p;
+
+  if( bin->tail - bin->head < size ){
+    memmove( bin->buf, bin->buf + bin->head, bin->tail - bin->head );
+    bin->tail -= bin->head;
+    bin->head = 0;
+    bin->tail += fread( bin->buf + bin->tail, sizeof(unsigned char), ZEO_PLY_BIN_BUFSIZ - bin->tail, bin->fp );
+    if( bin->tail < size ){
+      ZRUNERROR( ZEO_ERR_PLY_INCOMPLETE );
+      return NULL;
+    }
+  }
+  p = bin->buf + bin->head;
+  bin->head += size;
+  return p;
+}
+
+/* decode a value of binary data. */
+static double _zPLYBinDecode(_zPLYBin *bin, zPLYPrp *prp, unsigned char *p)
+{
+  union{
+    int8_t c; uint8_t uc; int16_t s; uint16_t us; int32_t i; uint32_t ui;
+    float f; double d; unsigned char b[8];
+  } val;
+  register int i;
+
+  if( bin->rev )
+    for( i=0; i<prp->size; i++ ) val.b[i] = p[prp->size-1-i];
+  else
+    memcpy( val.b, p, prp->size );
+  switch( prp->type ){
+  case ZEO_PLY_DATA_CHAR:   return val.c;
+  case ZEO_PLY_DATA_UCHAR:  return val.uc;
+  case ZEO_PLY_DATA_SHORT:  return val.s;
+  case ZEO_PLY_DATA_USHORT: return val.us;
+  case ZEO_PLY_DATA_INT:    return val.i;
+  case ZEO_PLY_DATA_UINT:   return val.ui;
+  case ZEO_PLY_DATA_FLOAT:  return val.f;
+  case ZEO_PLY_DATA_DOUBLE: return val.d;
+  default: ;
+  }
+  return 0;
+}
+
+/* read an integer from binary data. */
+static bool _zPLYBinReadInt(_zPLYBin *bin, zPLYPrp *prp, int *val)
+{
+  unsigned char *p;
+
+  if( !( p = _zPLYBinGet( bin, prp->size ) ) ) return false;
+  *val = (int)_zPLYBinDecode( bin, prp, p );
+  return true;
+}
+
+static bool _zPH3DFReadPLYVertBin(_zPLYBin *bin, zPH3D *ph, zPLY *ply, zPLYElement *elem)
+{
+  int stride = 0, offset[3];
+  unsigned char *p;
+  register int i, j;
+
+  if( ply->vertidx[0] >= elem->prpnum ||
+      ply->vertidx[1] >= elem->prpnum ||
+      ply->vertidx[2] >= elem->prpnum ){
+    ZRUNERROR( ZEO_ERR_PLY_UNSUPPORTED );
+    return false;
+  }
+  /* offsets of x, y and z and the stride of records are fixed */
+  for( j=0; j<elem->prpnum; j++ ){
+    if( elem->prp[j]->type == ZEO_PLY_DATA_LIST ){
+      ZRUNERROR( ZEO_ERR_PLY_UNSUPPORTED );
+      return false;
+    }
+    for( i=0; i<3; i++ )
+      if( j == ply->vertidx[i] ) offset[i] = stride;
+    stride += elem->prp[j]->size;
+  }
+  if( elem->num > 0 ){ /* vertices */
+    zArrayAlloc( &ph->vert, zVec3D, elem->num );
+    if( !zPH3DVertBuf(ph) ) return false;
+  }
+  for( i=0; i<elem->num; i++ ){
+    if( !( p = _zPLYBinGet( bin, stride ) ) ) return false;
+    for( j=0; j<3; j++ )
+      zPH3DVert(ph,i)->e[j] = _zPLYBinDecode( bin, elem->prp[ply->vertidx[j]], p + offset[j] );
+  }
+  return true;
+}
+
+static bool _zPH3DFReadPLYFaceBin(_zPLYBin *bin, zPH3D *ph, zPLY *ply, zPLYElement *elem)
+{
+  register int i, j, k;
+  int nv; /* number of vertices of a face */
+  int v1, v2, v3; /* vertex indices */
+  _zPLYTriBuf tb;
+  bool ret = false;
+
+  _zPLYTriBufInit( &tb );
+  for( i=0; i<elem->num; i++ ){
+    for( j=0; j<elem->prpnum; j++ ){
+      if( elem->prp[j]->type != ZEO_PLY_DATA_LIST ){
+        if( !_zPLYBinGet( bin, elem->prp[j]->size ) ) goto TERMINATE; /* discard data */
+        continue;
+      }
+      if( !_zPLYBinReadInt( bin, ply->facelistnum, &nv ) ) goto TERMINATE;
+      if( --nv < 0 ) continue;
+      if( !_zPLYBinReadInt( bin, ply->facelistelem, &v1 ) ) goto TERMINATE;
+      if( --nv < 0 ) continue;
+      if( !_zPLYBinReadInt( bin, ply->facelistelem, &v2 ) ) goto TERMINATE;
+      for( k=0; k<nv; k++ ){
+        if( !_zPLYBinReadInt( bin, ply->facelistelem, &v3 ) ||
+            !_zPLYTriBufAdd( &tb, v1, v2, v3 ) ) goto TERMINATE;
+        v2 = v3;
+      }
+    }
+  }
+  ret = _zPLYTriBufToPH3D( &tb, ph );
+ TERMINATE:
+  _zPLYTriBufDestroy( &tb );
+  return ret;
+}
+
+static bool _zPH3DFReadPLYElemBin(_zPLYBin *bin, zPH3D *ph, zPLY *ply, zPLYElement *elem)
+{
+  int stride = 0;
+  register int i, j;
+
+  for( j=0; j<elem->prpnum; j++ ){
+    if( elem->prp[j]->type == ZEO_PLY_DATA_LIST ){
+      ZRUNERROR( ZEO_ERR_PLY_UNSUPPORTED );
+      return false;
+    }
+    stride += elem->prp[j]->size;
+  }
+  for( i=0; i<elem->num; i++ )
+    if( !_zPLYBinGet( bin, stride ) ) return false; /* discard data */
+  return true;
+}
+
+static bool _zPH3DFReadPLYDataBin(FILE *fp, zPH3D *ph, zPLY *ply)
+{
+  _zPLYBin bin;
+  bool ret = true;
+  register int i;
+
+  if( !_zPLYBinInit( &bin, fp, ply ) ) return false;
+  for( i=0; i<=ply->elemnum && ret; i++ ){
+    switch( ply->elem[i].type ){
+    case ZEO_PLY_ELEM_VERTEX:
+      ret = _zPH3DFReadPLYVertBin( &bin, ph, ply, &ply->elem[i] ); break;
+    case ZEO_PLY_ELEM_FACE:
+      ret = _zPH3DFReadPLYFaceBin( &bin, ph, ply, &ply->elem[i] ); break;
+    default:
+      ret = _zPH3DFReadPLYElemBin( &bin, ph, ply, &ply->elem[i] );
+    }
+  }
+  /* data read ahead are pushed back */
+  fseek( fp, bin.head - bin.tail, SEEK_CUR );
+  zFree( bin.buf );
+  return ret;
+}
+
 static bool _zPH3DFReadPLYData(FILE *fp, zPH3D *ph, zPLY *ply)
 {
   register int i;
 
+  if( ply->format != ZEO_PLY_FORMAT_ASCII )
+    return _zPH3DFReadPLYDataBin( fp, ph, ply );
   for( i=0; i<=ply->elemnum; i++ ){
     switch( ply->elem[i].type ){
     case ZEO_PLY_ELEM_VERTEX:
@@ -6,121 +6,258 @@
 
 #include <zeo/zeo_ph.h>
 
-/* STL vertex list */
-typedef struct{
-  int id;
-  zVec3D v;
-} _zSTLVert;
-zListClass( _zSTLVertList, _zSTLVertListCell, _zSTLVert );
+/* tolerance to weld vertices of STL */
+static double __z_stl_weld_tol = zTOL;
+
+/* set the tolerance to weld vertices of STL. */
+void zSTLSetWeldTol(double tol)
+{
+  __z_stl_weld_tol = fabs( tol );
+}
 
-static void _zSTLVertListInit(_zSTLVertList *list);
-static _zSTLVertListCell *_zSTLVertListReg(_zSTLVertList *list, zVec3D *v);
-static zVec3DArray *_zSTLVertListToVec3DArray(_zSTLVertList *list, zVec3DArray *array);
+/* the tolerance to weld vertices of STL. */
+double zSTLWeldTol(void)
+{
+  return __z_stl_weld_tol;
+}
+
+/* STL facet buffer */
+typedef struct{
+  int num;        /* number of facets */
+  int size;       /* size of buffer */
+  zVec3D *v;      /* vertices (three for each facet) */
+  zVec3D *normal; /* normal vectors */
+} _zSTLFacetBuf;
+
+/* initialize a STL facet buffer. */
+static void _zSTLFacetBufInit(_zSTLFacetBuf *fb)
+{
+  fb->num = fb->size = 0;
+  fb->v = fb->normal = NULL;
+}
 
-/* initialize a STL vertex list. */
-void _zSTLVertListInit(_zSTLVertList *list)
+/* destroy a STL facet buffer. */
+static void _zSTLFacetBufDestroy(_zSTLFacetBuf *fb)
 {
-  zListInit( list );
-  zListRoot(list)->data.id = -1;
+  zFree( fb->v );
+  zFree( fb->normal );
+  _zSTLFacetBufInit( fb );
 }
 
-/* register a vector to a STL vertex list. */
-_zSTLVertListCell *_zSTLVertListReg(_zSTLVertList *list, zVec3D *v)
+/* reserve a STL facet buffer for a given number of facets. */
+static bool _zSTLFacetBufReserve(_zSTLFacetBuf *fb, int size)
 {
-  _zSTLVertListCell *cp;
+  zVec3D *v, *normal;
 
-  zListForEach( list, cp )
-    if( zVec3DEqual( &cp->data.v, v ) ) return cp;
-  if( !( cp = zAlloc( _zSTLVertListCell, 1 ) ) ){
+  if( size <= fb->size ) return true;
+  if( !( v = zRealloc( fb->v, zVec3D, size*3 ) ) ){
     ZALLOCERROR();
-    return NULL;
+    return false;
   }
-  cp->data.id = zListHead(list)->data.id + 1;
-  zVec3DCopy( v, &cp->data.v );
-  zListInsertHead( list, cp );
-  return cp;
+  fb->v = v;
+  if( !( normal = zRealloc( fb->normal, zVec3D, size ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  fb->normal = normal;
+  fb->size = size;
+  return true;
 }
 
-/* convert a STL vertex list to an array of vertices. */
-zVec3DArray *_zSTLVertListToVec3DArray(_zSTLVertList *list, zVec3DArray *array)
+/* add a facet to a STL facet buffer. */
+static bool _zSTLFacetBufAdd(_zSTLFacetBuf *fb, zVec3D *normal, zVec3D v[])
 {
-  _zSTLVertListCell *cp;
-  register int i = 0;
+  if( fb->num == fb->size &&
+      !_zSTLFacetBufReserve( fb, fb->size*2+64 ) ) return false;
+  zVec3DCopy( &v[0], &fb->v[3*fb->num] );
+  zVec3DCopy( &v[1], &fb->v[3*fb->num+1] );
+  zVec3DCopy( &v[2], &fb->v[3*fb->num+2] );
+  zVec3DCopy( normal, &fb->normal[fb->num++] );
+  return true;
+}
 
-  zArrayAlloc( array, zVec3D, zListSize(list) );
-  if( zArraySize(array) < zListSize(list) ){
-    zArrayFree( array );
-    return NULL;
+/* vertex welding by a spatial hash */
+
+/* ratio of the size of a cell of the spatial hash to the tolerance */
+#define ZEO_STL_WELD_CELL_RATIO 8
+
+/* maximum number of cells of the spatial hash along an axis */
+#define ZEO_STL_WELD_CELL_NUM 0x100000
+
+/* spatial hash to weld vertices */
+typedef struct{
+  zVec3D min;        /* minimum corner of the bounding box of vertices */
+  double h;          /* size of a cell */
+  double tol;        /* tolerance to weld vertices */
+  unsigned int mask; /* mask of hash keys */
+  int *head, *next;  /* chains of vertices in buckets */
+} _zSTLWeldGrid;
+
+/* initialize a spatial hash for vertices of a STL facet buffer. */
+static bool _zSTLWeldGridInit(_zSTLWeldGrid *g, zVec3D v[], int n)
+{
+  zVec3D max;
+  bool found = false;
+  register int i, k;
+
+  zVec3DZero( &g->min );
+  zVec3DZero( &max );
+  for( i=0; i<n; i++ ){
+    if( zVec3DIsNan( &v[i] ) ) continue;
+    if( !found ){
+      zVec3DCopy( &v[i], &g->min );
+      zVec3DCopy( &v[i], &max );
+      found = true;
+      continue;
+    }
+    for( k=zX; k<=zZ; k++ ){
+      if( v[i].e[k] < g->min.e[k] ) g->min.e[k] = v[i].e[k];
+      if( v[i].e[k] > max.e[k] ) max.e[k] = v[i].e[k];
+    }
   }
-  zListForEach( list, cp )
-    zVec3DCopy( &cp->data.v, zArrayElemNC(array,i++) );
-  return array;
+  g->tol = zSTLWeldTol();
+  /* the cell is enlarged for a large model so that indices of cells
+     are bounded. */
+  g->h = _zMax( g->tol, zTOL ) * ZEO_STL_WELD_CELL_RATIO;
+  for( k=zX; k<=zZ; k++ )
+    g->h = _zMax( g->h, ( max.e[k] - g->min.e[k] ) / ZEO_STL_WELD_CELL_NUM );
+  for( g->mask=1; g->mask<(unsigned int)n; g->mask<<=1 );
+  g->head = zAlloc( int, g->mask );
+  g->next = zAlloc( int, _zMax(n,1) );
+  if( !g->head || !g->next ){
+    ZALLOCERROR();
+    return false;
+  }
+  for( i=0; i<(int)g->mask; i++ ) g->head[i] = -1;
+  g->mask--;
+  return true;
 }
 
-/* STL facet list */
-typedef struct{
-  _zSTLVert *v1, *v2, *v3;
-  zVec3D normal;
-} _zSTLFacet;
-zListClass( _zSTLFacetList, _zSTLFacetListCell, _zSTLFacet );
+/* destroy a spatial hash to weld vertices. */
+static void _zSTLWeldGridDestroy(_zSTLWeldGrid *g)
+{
+  zFree( g->head );
+  zFree( g->next );
+}
+
+/* index of a cell of a spatial hash along an axis. */
+static int _zSTLWeldCell(_zSTLWeldGrid *g, double x, int k)
+{
+  double d;
 
-static _zSTLFacetListCell *_zSTLFacetListReg(_zSTLFacetList *flist, _zSTLVertList *vlist, zVec3D *normal, zVec3D v[]);
-static zTri3DArray *_zSTLFacetListToTri3DArray(_zSTLFacetList *list, zVec3DArray *varray, zTri3DArray *array);
+  d = floor( ( x - g->min.e[k] ) / g->h );
+  /* the negated comparison also catches NaN */
+  if( !( d > 0 ) ) return 0;
+  return d < ZEO_STL_WELD_CELL_NUM ? (int)d : ZEO_STL_WELD_CELL_NUM;
+}
 
-/* register a facet to a STL facet list. */
-_zSTLFacetListCell *_zSTLFacetListReg(_zSTLFacetList *flist, _zSTLVertList *vlist, zVec3D *normal, zVec3D v[])
+/* hash key of a cell of a spatial hash. */
+static unsigned int _zSTLWeldHash(_zSTLWeldGrid *g, int cx, int cy, int cz)
 {
-  zTri3D facet;
-  _zSTLVertListCell *vc1, *vc2, *vc3;
-  _zSTLFacetListCell *cp;
-
-  if( !( vc1 = _zSTLVertListReg( vlist, &v[0] ) ) ||
-      !( vc2 = _zSTLVertListReg( vlist, &v[1] ) ) ||
-      !( vc3 = _zSTLVertListReg( vlist, &v[2] ) ) ) return NULL;
-  if( !( cp = zAlloc( _zSTLFacetListCell, 1 ) ) ){
-    ZALLOCERROR();
-    return NULL;
+  return ( (unsigned int)cx * 73856093U ^
+           (unsigned int)cy * 19349663U ^
+           (unsigned int)cz * 83492791U ) & g->mask;
+}
+
+/* find a vertex within the tolerance from a vertex in a spatial hash. */
+static int _zSTLWeldFind(_zSTLWeldGrid *g, zVec3D *v, zVec3D vert[])
+{
+  int cmin[3], cmax[3], cx, cy, cz;
+  register int i, k;
+
+  /* clamping indices of cells is monotonic, so that no cell which
+     may contain vertices within the tolerance is missed. */
+  for( k=zX; k<=zZ; k++ ){
+    cmin[k] = _zSTLWeldCell( g, v->e[k] - g->tol, k );
+    cmax[k] = _zSTLWeldCell( g, v->e[k] + g->tol, k );
+  }
+  for( cx=cmin[zX]; cx<=cmax[zX]; cx++ )
+    for( cy=cmin[zY]; cy<=cmax[zY]; cy++ )
+      for( cz=cmin[zZ]; cz<=cmax[zZ]; cz++ )
+        for( i=g->head[_zSTLWeldHash(g,cx,cy,cz)]; i>=0; i=g->next[i] )
+          if( fabs( vert[i].c.x - v->c.x ) <= g->tol &&
+              fabs( vert[i].c.y - v->c.y ) <= g->tol &&
+              fabs( vert[i].c.z - v->c.z ) <= g->tol ) return i;
+  return -1;
+}
+
+/* weld vertices of a STL facet buffer.
+ * Identifiers of welded vertices are stored in id, and the welded
+ * vertices are packed at the head of fb->v. The number of welded
+ * vertices is returned, or -1 if it fails to allocate memory. */
+static int _zSTLWeld(_zSTLFacetBuf *fb, int id[])
+{
+  _zSTLWeldGrid g;
+  int n, vnum = 0;
+  unsigned int key;
+  register int i;
+
+  n = fb->num * 3;
+  if( !_zSTLWeldGridInit( &g, fb->v, n ) ){
+    vnum = -1;
+    goto TERMINATE;
   }
-  cp->data.v1 = &vc1->data;
-  cp->data.v2 = &vc2->data;
-  cp->data.v3 = &vc3->data;
-  zTri3DCreate( &facet, &vc1->data.v, &vc2->data.v, &vc3->data.v );
-  if( !zVec3DEqual( zTri3DNorm(&facet), normal ) ){
-    ZRUNWARN( ZEO_WARN_STL_WRONGNORMAL );
+  for( i=0; i<n; i++ ){
+    if( ( id[i] = _zSTLWeldFind( &g, &fb->v[i], fb->v ) ) >= 0 ) continue;
+    /* vertices already welded are never referred again, so that
+       the new vertex can be packed to the head of the buffer. */
+    zVec3DCopy( &fb->v[i], &fb->v[vnum] );
+    key = _zSTLWeldHash( &g,
+      _zSTLWeldCell( &g, fb->v[vnum].c.x, zX ),
+      _zSTLWeldCell( &g, fb->v[vnum].c.y, zY ),
+      _zSTLWeldCell( &g, fb->v[vnum].c.z, zZ ) );
+    g.next[vnum] = g.head[key];
+    g.head[key] = vnum;
+    id[i] = vnum++;
   }
-  zVec3DCopy( zTri3DNorm(&facet), &cp->data.normal );
-  zListInsertHead( flist, cp );
-  return cp;
+ TERMINATE:
+  _zSTLWeldGridDestroy( &g );
+  return vnum;
 }
 
-/* convert a STL facet list to an array of faces. */
-zTri3DArray *_zSTLFacetListToTri3DArray(_zSTLFacetList *list, zVec3DArray *varray, zTri3DArray *array)
+/* convert a STL facet buffer to a polyhedron. */
+static zPH3D *_zSTLFacetBufToPH3D(_zSTLFacetBuf *fb, zPH3D *ph)
 {
-  _zSTLFacetListCell *cp;
-  register int i = 0;
+  int *id, vnum;
+  zTri3D *face;
+  register int i;
 
-  zArrayAlloc( array, zTri3D, zListSize(list) );
-  if( zArraySize(array) < zListSize(list) ){
-    zArrayFree( array );
+  if( fb->num == 0 ) return ph;
+  if( !( id = zAlloc( int, fb->num*3 ) ) ){
+    ZALLOCERROR();
     return NULL;
   }
-  zListForEach( list, cp ){
-    zTri3DSetVert( zArrayElemNC(array,i), 0, zArrayElemNC(varray,cp->data.v1->id) );
-    zTri3DSetVert( zArrayElemNC(array,i), 1, zArrayElemNC(varray,cp->data.v2->id) );
-    zTri3DSetVert( zArrayElemNC(array,i), 2, zArrayElemNC(varray,cp->data.v3->id) );
-    zTri3DSetNorm( zArrayElemNC(array,i), &cp->data.normal );
-    i++;
+  if( ( vnum = _zSTLWeld( fb, id ) ) < 0 ){
+    ph = NULL;
+    goto TERMINATE;
+  }
+  zArrayAlloc( &ph->vert, zVec3D, vnum );
+  zArrayAlloc( &ph->face, zTri3D, fb->num );
+  if( zPH3DVertNum(ph) < vnum || zPH3DFaceNum(ph) < fb->num ){
+    zPH3DDestroy( ph );
+    ph = NULL;
+    goto TERMINATE;
+  }
+  memcpy( zPH3DVertBuf(ph), fb->v, sizeof(zVec3D)*vnum );
+  for( i=0; i<fb->num; i++ ){
+    face = zPH3DFace(ph,i);
+    zTri3DCreate( face, zPH3DVert(ph,id[3*i]), zPH3DVert(ph,id[3*i+1]), zPH3DVert(ph,id[3*i+2]) );
+    if( !zVec3DEqual( zTri3DNorm(face), &fb->normal[i] ) ){
+      ZRUNWARN( ZEO_WARN_STL_WRONGNORMAL );
+    }
   }
-  return array;
+ TERMINATE:
+  zFree( id );
+  return ph;
 }
 
 /* read/write in STL format */
 
 static bool _zPH3DFReadSTL_ASCIIloop(FILE *fp, char buf[], zVec3D v[]);
-static zPH3D *_zPH3DFReadSTL_ASCIIfacet(FILE *fp, char buf[], zPH3D *ph, _zSTLVertList *vert_list, _zSTLFacetList *facet_list);
+static zPH3D *_zPH3DFReadSTL_ASCIIfacet(FILE *fp, char buf[], zPH3D *ph, _zSTLFacetBuf *fb);
 static zPH3D *_zPH3DFReadSTL_ASCIIsolid(FILE *fp, zPH3D *ph, char name[], size_t namesize);
 
-static zVec3D *_zPH3DFReadSTL_BinVec(FILE *fp, zVec3D *v);
+static zVec3D *_zPH3DFReadSTL_BinVec(unsigned char *buf, zVec3D *v);
 static void _zPH3DFWriteSTL_BinVec(FILE *fp, zVec3D *v);
 
 /* scan an outer loop of a face of a 3D polyhedron from ASCII STL format */
@@ -160,7 +297,7 @@ bool _zPH3DFReadSTL_ASCIIloop(FILE *fp, char buf[], zVec3D v[])
 }
 
 /* scan a facet of a 3D polyhedron from ASCII STL format */
-zPH3D *_zPH3DFReadSTL_ASCIIfacet(FILE *fp, char buf[], zPH3D *ph, _zSTLVertList *vert_list, _zSTLFacetList *facet_list)
+zPH3D *_zPH3DFReadSTL_ASCIIfacet(FILE *fp, char buf[], zPH3D *ph, _zSTLFacetBuf *fb)
 {
   zVec3D normal, v[3];
 
@@ -176,7 +313,7 @@ zPH3D *_zPH3DFReadSTL_ASCIIfacet(FILE *fp, char buf[], zPH3D *ph, _zSTLVertList
       _zPH3DFReadSTL_ASCIIloop( fp, buf, v );
     } else
     if( strcmp( buf, "endfacet" ) == 0 ){
-      if( !_zSTLFacetListReg( facet_list, vert_list, &normal, v ) ) break;
+      if( !_zSTLFacetBufAdd( fb, &normal, v ) ) break;
       return ph;
     }
   }
@@ -187,11 +324,9 @@ zPH3D *_zPH3DFReadSTL_ASCIIfacet(FILE *fp, char buf[], zPH3D *ph, _zSTLVertList
 zPH3D *_zPH3DFReadSTL_ASCIIsolid(FILE *fp, zPH3D *ph, char name[], size_t namesize)
 {
   char buf[BUFSIZ];
-  _zSTLVertList vert_list;
-  _zSTLFacetList facet_list;
+  _zSTLFacetBuf fb;
 
-  _zSTLVertListInit( &vert_list );
-  zListInit( &facet_list );
+  _zSTLFacetBufInit( &fb );
   if( !zFToken( fp, name, namesize ) ) return NULL; /* no name */
   while( !feof( fp ) ){
     if( !zFToken( fp, buf, BUFSIZ ) ){
@@ -199,16 +334,14 @@ zPH3D *_zPH3DFReadSTL_ASCIIsolid(FILE *fp, zPH3D *ph, char name[], size_t namesi
       break;
     }
     if( strcmp( buf, "endsolid" ) == 0 ){
-      if( !_zSTLVertListToVec3DArray( &vert_list, &ph->vert ) ||
-          !_zSTLFacetListToTri3DArray( &facet_list, &ph->vert, &ph->face ) )
-        ph = NULL;
-      zListDestroy( _zSTLVertListCell, &vert_list );
-      zListDestroy( _zSTLFacetListCell, &facet_list );
+      ph = _zSTLFacetBufToPH3D( &fb, ph );
+      _zSTLFacetBufDestroy( &fb );
       return ph;
     } else
     if( strcmp( buf, "facet" ) != 0 ) continue; /* skip as a comment */
-    if( !_zPH3DFReadSTL_ASCIIfacet( fp, buf, ph, &vert_list, &facet_list ) ) break; /* read a facet */
+    if( !_zPH3DFReadSTL_ASCIIfacet( fp, buf, ph, &fb ) ) break; /* read a facet */
   }
+  _zSTLFacetBufDestroy( &fb );
   return NULL;
 }
 
@@ -247,15 +380,13 @@ void zPH3DFWriteSTL_ASCII(FILE *fp, zPH3D *ph, char name[])
   fprintf( fp, "endsolid\n" );
 }
 
-/* read a 3D vector from binary STL format */
-zVec3D *_zPH3DFReadSTL_BinVec(FILE *fp, zVec3D *v)
+/* read a 3D vector from a record of binary STL format */
+zVec3D *_zPH3DFReadSTL_BinVec(unsigned char *buf, zVec3D *v)
 {
-  float val1, val2, val3;
+  float val[3];
 
-  if( fread( &val1, sizeof(float), 1, fp ) < 1 );
-  if( fread( &val2, sizeof(float), 1, fp ) < 1 );
-  if( fread( &val3, sizeof(float), 1, fp ) < 1 );
-  return zVec3DCreate( v, val1, val2, val3 );
+  memcpy( val, buf, sizeof(float)*3 );
+  return zVec3DCreate( v, val[0], val[1], val[2] );
 }
 
 /* write a 3D vector to binary STL format */
@@ -272,38 +403,56 @@ void _zPH3DFWriteSTL_BinVec(FILE *fp, zVec3D *v)
 }
 
 #define ZEO_STL_HEADSIZ 80
+/* size of a record of a facet (a normal vector, three vertices and two empty bytes) */
+#define ZEO_STL_RECSIZ  50
+/* number of records to be read at once */
+#define ZEO_STL_RECNUM  4096
 
 /* read a 3D polyhedron from binary STL format */
 zPH3D *zPH3DFReadSTL_Bin(FILE *fp, zPH3D *ph, char name[])
 {
-  uint32_t nf; /* number of facets */
-  uint16_t dummy;
-  zVec3D normal, v[3];
-  _zSTLVertList vert_list;
-  _zSTLFacetList facet_list;
-  register int i;
+  uint32_t nf = 0; /* number of facets */
+  unsigned char *buf, *rec;
+  _zSTLFacetBuf fb;
+  int n;
+  register int i, j;
 
-  _zSTLVertListInit( &vert_list );
-  zListInit( &facet_list );
+  _zSTLFacetBufInit( &fb );
   zPH3DInit( ph );
   if( fread( name, sizeof(char), ZEO_STL_HEADSIZ, fp ) < ZEO_STL_HEADSIZ )
     ZRUNWARN( ZEO_WARN_STL_MISSINGDATA );
   if( fread( &nf, sizeof(uint32_t), 1, fp ) < 1 ) ZRUNWARN( ZEO_WARN_STL_MISSINGDATA );
   if( nf <= 0 ) return NULL;
-  for( i=0; i<nf; i++ ){
-    _zPH3DFReadSTL_BinVec( fp, &normal );
-    _zPH3DFReadSTL_BinVec( fp, &v[0] );
-    _zPH3DFReadSTL_BinVec( fp, &v[1] );
-    _zPH3DFReadSTL_BinVec( fp, &v[2] );
-    if( fread( &dummy, sizeof(uint16_t), 1, fp ) < 1 )
-      ZRUNWARN( ZEO_WARN_STL_MISSINGDATA ); /* two empty bytes */
-    if( !_zSTLFacetListReg( &facet_list, &vert_list, &normal, v ) ) break;
+  if( !( buf = zAlloc( unsigned char, ZEO_STL_RECSIZ*ZEO_STL_RECNUM ) ) ){
+    ZALLOCERROR();
+    return NULL;
   }
-  if( !_zSTLVertListToVec3DArray( &vert_list, &ph->vert ) ||
-      !_zSTLFacetListToTri3DArray( &facet_list, &ph->vert, &ph->face ) )
-    ph = NULL;
-  zListDestroy( _zSTLVertListCell, &vert_list );
-  zListDestroy( _zSTLFacetListCell, &facet_list );
+  /* records are read by chunks and decoded in memory. the buffer grows
+   * along with records actually read, since the number of facets in the
+   * header is not trustworthy. */
+  for( i=0; i<nf; i+=n ){
+    n = fread( buf, ZEO_STL_RECSIZ, _zMin( ZEO_STL_RECNUM, nf - i ), fp );
+    if( fb.num + n > fb.size &&
+        !_zSTLFacetBufReserve( &fb, _zMax( fb.num + n, fb.size*2 ) ) ){
+      ph = NULL;
+      goto TERMINATE;
+    }
+    for( rec=buf, j=0; j<n; j++, rec+=ZEO_STL_RECSIZ ){
+      _zPH3DFReadSTL_BinVec( rec,    &fb.normal[fb.num] );
+      _zPH3DFReadSTL_BinVec( rec+12, &fb.v[3*fb.num] );
+      _zPH3DFReadSTL_BinVec( rec+24, &fb.v[3*fb.num+1] );
+      _zPH3DFReadSTL_BinVec( rec+36, &fb.v[3*fb.num+2] );
+      fb.num++;
+    }
+    if( n < _zMin( ZEO_STL_RECNUM, nf - i ) ){
+      ZRUNWARN( ZEO_WARN_STL_MISSINGDATA );
+      break;
+    }
+  }
+  ph = _zSTLFacetBufToPH3D( &fb, ph );
+ TERMINATE:
+  _zSTLFacetBufDestroy( &fb );
+  zFree( buf );
   return ph;
 }
 
@@ -494,3 +494,213 @@ bool zVec3DListReadPCDFile(zVec3DList *pc, char filename[])
   fclose( fp );
   return ret;
 }
+
+/* write point cloud to a stream of PCD file in binary format. */
+bool zVec3DArrayPCDFWrite(FILE *fp, zVec3D p[], int num)
+{
+  float v[3];
+  register int i;
+
+  fprintf( fp, "# .PCD v0.7 - Point Cloud Data file format\n" );
+  fprintf( fp, "VERSION 0.7\n" );
+  fprintf( fp, "FIELDS x y z\n" );
+  fprintf( fp, "SIZE 4 4 4\n" );
+  fprintf( fp, "TYPE F F F\n" );
+  fprintf( fp, "COUNT 1 1 1\n" );
+  fprintf( fp, "WIDTH %d\n", num );
+  fprintf( fp, "HEIGHT 1\n" );
+  fprintf( fp, "VIEWPOINT 0 0 0 1 0 0 0\n" );
+  fprintf( fp, "POINTS %d\n", num );
+  fprintf( fp, "DATA binary\n" );
+  for( i=0; i<num; i++ ){
+    v[0] = p[i].c.x; v[1] = p[i].c.y; v[2] = p[i].c.z;
+    if( fwrite( v, sizeof(float), 3, fp ) != 3 ){
+      ZRUNERROR( ZEO_ERR_PCD_WRITE );
+      return false;
+    }
+  }
+  return true;
+}
+
+/* write point cloud to a PCD file. */
+bool zVec3DArrayWritePCDFile(zVec3D p[], int num, char filename[])
+{
+  FILE *fp;
+  bool ret;
+
+  if( !( fp = zOpenFile( filename, ZEO_PCD_SUFFIX, "wb" ) ) )
+    return false;
+  ret = zVec3DArrayPCDFWrite( fp, p, num );
+  fclose( fp );
+  return ret;
+}
+
+/* ********************************************************** */
+/* normal vector estimation
+ * ********************************************************** */
+
+/* accumulator of moments of neighbor points. */
+typedef struct{
+  int n;
+  zVec3D c;
+  zMat3D m;
+} _zVec3DNormalMoment;
+
+/* accumulate moments of a neighbor point. */
+static void _zVec3DNormalMomentAdd(zVecTree3D *node, void *util)
+{
+  _zVec3DNormalMoment *moment;
+
+  moment = (_zVec3DNormalMoment *)util;
+  zVec3DAddDRC( &moment->c, &node->v );
+  zMat3DAddDyad( &moment->m, &node->v, &node->v );
+  moment->n++;
+}
+
+/* estimate a normal vector of a point from moments of its neighbors. */
+static zVec3D *_zVec3DNormalEstimate(zVecTree3D *tree, zVec3D *p, double r, zVec3D *norm)
+{
+  _zVec3DNormalMoment moment;
+  double eval[3];
+  zVec3D evec[3];
+  int i;
+
+  moment.n = 0;
+  zVec3DZero( &moment.c );
+  zMat3DZero( &moment.m );
+  zVecTree3DRange( tree, p, r, _zVec3DNormalMomentAdd, &moment );
+  if( moment.n < 3 ) return zVec3DZero( norm );
+  zVec3DDivDRC( &moment.c, moment.n );
+  zMat3DDivDRC( &moment.m, moment.n );
+  zMat3DSubDyad( &moment.m, &moment.c, &moment.c );
+  zMat3DSymEig( &moment.m, eval, evec );
+  if( eval[0] < eval[1] )
+    i = eval[0] < eval[2] ? 0 : 2;
+  else
+    i = eval[1] < eval[2] ? 1 : 2;
+  return zVec3DNormalize( &evec[i], norm ) > 0 ? norm : zVec3DZero( norm );
+}
+
+/* estimate normal vectors of a point cloud. */
+zVec3D *zVec3DNormalEstimate(zVec3D p[], int num, zVecTree3D *tree, double r, zVec3D norm[])
+{
+  zVecTree3D tree_tmp;
+  register int i;
+
+  if( !tree ){
+    if( !zVecTree3DFromArray( &tree_tmp, p, num ) ) return NULL;
+    zVec3DNormalEstimate( p, num, &tree_tmp, r, norm );
+    zVecTree3DDestroy( &tree_tmp );
+    return norm;
+  }
+  for( i=0; i<num; i++ )
+    _zVec3DNormalEstimate( tree, &p[i], r, &norm[i] );
+  return norm;
+}
+
+/* ********************************************************** */
+/* Euclidean clustering
+ * ********************************************************** */
+
+/* disjoint set forest of points. */
+typedef struct{
+  int i;       /* index of the query point */
+  int *parent; /* parents of points */
+  int *size;   /* sizes of trees */
+} _zVec3DClusterSet;
+
+/* find the root of a point with path halving. */
+static int _zVec3DClusterFind(int *parent, int i)
+{
+  while( parent[i] != i )
+    i = parent[i] = parent[parent[i]];
+  return i;
+}
+
+/* unite a neighbor point with the query point by size. */
+static void _zVec3DClusterUnite(zVecTree3D *node, void *util)
+{
+  _zVec3DClusterSet *set;
+  int a, b;
+
+  set = (_zVec3DClusterSet *)util;
+  if( node->id < 0 ) return;
+  a = _zVec3DClusterFind( set->parent, set->i );
+  b = _zVec3DClusterFind( set->parent, node->id );
+  if( a == b ) return;
+  if( set->size[a] < set->size[b] ) zSwap( int, a, b );
+  set->parent[b] = a;
+  set->size[a] += set->size[b];
+}
+
+/* Euclidean clustering of a point cloud. */
+int zVec3DCluster(zVec3D p[], int num, zVecTree3D *tree, double r, int min_size, int label[])
+{
+  zVecTree3D tree_tmp;
+  _zVec3DClusterSet set;
+  register int i;
+  int root, nc = 0;
+
+  if( !tree ){
+    if( !zVecTree3DFromArray( &tree_tmp, p, num ) ) return -1;
+    nc = zVec3DCluster( p, num, &tree_tmp, r, min_size, label );
+    zVecTree3DDestroy( &tree_tmp );
+    return nc;
+  }
+  set.parent = zAlloc( int, num );
+  set.size = zAlloc( int, num );
+  if( !set.parent || !set.size ){
+    ZALLOCERROR();
+    nc = -1;
+    goto TERMINATE;
+  }
+  for( i=0; i<num; i++ ){
+    set.parent[i] = i;
+    set.size[i] = 1;
+  }
+  for( set.i=0; set.i<num; set.i++ )
+    zVecTree3DRange( tree, &p[set.i], r, _zVec3DClusterUnite, &set );
+  /* label clusters in the order of their first points */
+  for( i=0; i<num; i++ ) label[i] = -2;
+  for( i=0; i<num; i++ ){
+    if( label[( root = _zVec3DClusterFind( set.parent, i ) )] == -2 )
+      label[root] = set.size[root] < min_size ? -1 : nc++;
+    label[i] = label[root];
+  }
+ TERMINATE:
+  zFree( set.parent );
+  zFree( set.size );
+  return nc;
+}
+
+/* create lists of addresses of points in clusters. */
+zVec3DAddrList *zVec3DClusterAddrList(zVec3D p[], int num, int label[], int nc)
+{
+  zVec3DAddrList *list;
+  register int i;
+
+  if( !( list = zAlloc( zVec3DAddrList, nc ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  for( i=0; i<nc; i++ ) zListInit( &list[i] );
+  for( i=num-1; i>=0; i-- ){
+    if( label[i] < 0 || label[i] >= nc ) continue;
+    if( !zVec3DAddrListInsert( &list[label[i]], &p[i] ) ){
+      zVec3DClusterAddrListDestroy( list, nc );
+      return NULL;
+    }
+  }
+  return list;
+}
+
+/* destroy lists of addresses of points in clusters. */
+void zVec3DClusterAddrListDestroy(zVec3DAddrList *list, int nc)
+{
+  register int i;
+
+  if( !list ) return;
+  for( i=0; i<nc; i++ )
+    zVec3DAddrListDestroy( &list[i] );
+  zFree( list );
+}
@@ -0,0 +1,322 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_pointcloud_icp - iterative closest point registration.
+ */
+
+#include <zeo/zeo_pointcloud.h>
+
+/* initialize parameters of iterative closest point registration. */
+zICPParam *zICPParamInit(zICPParam *param)
+{
+  param->metric = ZEO_ICP_POINT_TO_POINT;
+  param->iter = 0;
+  param->tol = zTOL;
+  param->dist_max = 0;
+  param->trim = 0;
+  return param;
+}
+
+/* workspace of iterative closest point registration. */
+typedef struct{
+  zVec3D *p;        /* transformed source points */
+  zVecTree3D **nn;  /* nearest neighbors */
+  double *d;        /* distances to the nearest neighbors */
+  double *buf;      /* buffer to select the trimming threshold */
+} _zICPWork;
+
+/* allocate workspace of iterative closest point registration. */
+static bool _zICPWorkAlloc(_zICPWork *work, int num)
+{
+  work->p = zAlloc( zVec3D, num );
+  work->nn = zAlloc( zVecTree3D*, num );
+  work->d = zAlloc( double, num );
+  work->buf = zAlloc( double, num );
+  if( !work->p || !work->nn || !work->d || !work->buf ){
+    ZALLOCERROR();
+    return false;
+  }
+  return true;
+}
+
+/* free workspace of iterative closest point registration. */
+static void _zICPWorkFree(_zICPWork *work)
+{
+  zFree( work->p );
+  zFree( work->nn );
+  zFree( work->d );
+  zFree( work->buf );
+}
+
+/* select the k-th smallest value in an array (the array is reordered). */
+static double _zICPSelect(double d[], int num, int k)
+{
+  int lo, hi, i, j;
+  double pivot;
+
+  for( lo=0, hi=num-1; lo<hi; ){
+    pivot = d[(lo+hi)/2];
+    for( i=lo, j=hi; i<=j; ){
+      while( d[i] < pivot ) i++;
+      while( d[j] > pivot ) j--;
+      if( i <= j ){
+        zSwap( double, d[i], d[j] );
+        i++; j--;
+      }
+    }
+    if( k <= j ) hi = j;
+    else if( k >= i ) lo = i;
+    else break;
+  }
+  return d[k];
+}
+
+/* find correspondences and the threshold of acceptance. */
+static double _zICPCorrespond(_zICPWork *work, zVec3D src[], int num, zVecTree3D *tree, zICPParam *param, zFrame3D *f)
+{
+  double th;
+  register int i;
+
+  for( i=0; i<num; i++ ){
+    zXform3D( f, &src[i], &work->p[i] );
+    work->d[i] = zVecTree3DNN( tree, &work->p[i], &work->nn[i] );
+  }
+  th = param->dist_max > 0 ? param->dist_max : HUGE_VAL;
+  if( param->trim > 0 && param->trim < 1 ){
+    memcpy( work->buf, work->d, sizeof(double)*num );
+    if( ( i = (int)( ( 1 - param->trim ) * num ) ) < 1 ) i = 1;
+    th = _zMin( th, _zICPSelect( work->buf, num, i-1 ) );
+  }
+  return th;
+}
+
+/* eigenvector of a symmetric 4x4 matrix for the maximum eigenvalue by Jacobi's method. */
+static void _zICPSymEig4Max(double a[4][4], double evec[4])
+{
+  double v[4][4], theta, t, c, s, tmp1, tmp2;
+  register int i, j, k, n;
+  bool ok;
+
+  for( i=0; i<4; i++ )
+    for( j=0; j<4; j++ ) v[i][j] = i == j ? 1 : 0;
+  for( n=0; n<Z_MAX_ITER_NUM; n++ ){
+    ok = true;
+    for( i=0; i<3; i++ )
+      for( j=i+1; j<4; j++ ){
+        if( zIsTiny( a[i][j] ) ) continue;
+        ok = false;
+        theta = 0.5 * ( a[j][j] - a[i][i] ) / a[i][j];
+        t = ( theta >= 0 ? 1 : -1 ) / ( fabs(theta) + sqrt( theta*theta + 1 ) );
+        c = 1 / sqrt( t*t + 1 );
+        s = t * c;
+        for( k=0; k<4; k++ ){
+          tmp1 = a[k][i]; tmp2 = a[k][j];
+          a[k][i] = c * tmp1 - s * tmp2;
+          a[k][j] = s * tmp1 + c * tmp2;
+        }
+        for( k=0; k<4; k++ ){
+          tmp1 = a[i][k]; tmp2 = a[j][k];
+          a[i][k] = c * tmp1 - s * tmp2;
+          a[j][k] = s * tmp1 + c * tmp2;
+        }
+        for( k=0; k<4; k++ ){
+          tmp1 = v[k][i]; tmp2 = v[k][j];
+          v[k][i] = c * tmp1 - s * tmp2;
+          v[k][j] = s * tmp1 + c * tmp2;
+        }
+      }
+    if( ok ) break;
+  }
+  if( n == Z_MAX_ITER_NUM ) ZITERWARN( Z_MAX_ITER_NUM );
+  for( j=0, i=1; i<4; i++ )
+    if( a[i][i] > a[j][j] ) j = i;
+  for( i=0; i<4; i++ ) evec[i] = v[i][j];
+}
+
+/* update of a frame for the point-to-point metric (Horn's method). */
+static bool _zICPUpdatePoint(_zICPWork *work, int num, double th, zFrame3D *df, int *n, double *sse)
+{
+  zVec3D pc, qc, dp, dq;
+  double s[3][3], a[4][4], ep[4];
+  zEP q;
+  register int i, j, k;
+
+  zVec3DZero( &pc );
+  zVec3DZero( &qc );
+  for( *n=0, *sse=0, i=0; i<num; i++ ){
+    if( !work->nn[i] || work->d[i] > th ) continue;
+    zVec3DAddDRC( &pc, &work->p[i] );
+    zVec3DAddDRC( &qc, &work->nn[i]->v );
+    *sse += zSqr( work->d[i] );
+    (*n)++;
+  }
+  if( *n < 3 ) return false;
+  zVec3DDivDRC( &pc, *n );
+  zVec3DDivDRC( &qc, *n );
+  for( j=0; j<3; j++ )
+    for( k=0; k<3; k++ ) s[j][k] = 0;
+  for( i=0; i<num; i++ ){
+    if( !work->nn[i] || work->d[i] > th ) continue;
+    zVec3DSub( &work->p[i], &pc, &dp );
+    zVec3DSub( &work->nn[i]->v, &qc, &dq );
+    for( j=0; j<3; j++ )
+      for( k=0; k<3; k++ ) s[j][k] += dp.e[j] * dq.e[k];
+  }
+  a[0][0] = s[0][0] + s[1][1] + s[2][2];
+  a[1][1] = s[0][0] - s[1][1] - s[2][2];
+  a[2][2] =-s[0][0] + s[1][1] - s[2][2];
+  a[3][3] =-s[0][0] - s[1][1] + s[2][2];
+  a[0][1] = a[1][0] = s[1][2] - s[2][1];
+  a[0][2] = a[2][0] = s[2][0] - s[0][2];
+  a[0][3] = a[3][0] = s[0][1] - s[1][0];
+  a[1][2] = a[2][1] = s[0][1] + s[1][0];
+  a[1][3] = a[3][1] = s[2][0] + s[0][2];
+  a[2][3] = a[3][2] = s[1][2] + s[2][1];
+  _zICPSymEig4Max( a, ep );
+  zEPCreate( &q, ep[0], ep[1], ep[2], ep[3] );
+  zMat3DFromEP( zFrame3DAtt(df), &q );
+  zMulMat3DVec3D( zFrame3DAtt(df), &pc, &dp );
+  zVec3DSub( &qc, &dp, zFrame3DPos(df) );
+  return true;
+}
+
+/* solve a 6x6 linear equation by Gaussian elimination with partial pivoting. */
+static bool _zICPSolve6(double a[6][6], double b[6], double x[6])
+{
+  double r;
+  register int i, j, k, p;
+
+  for( i=0; i<6; i++ ){
+    for( p=i, j=i+1; j<6; j++ )
+      if( fabs( a[j][i] ) > fabs( a[p][i] ) ) p = j;
+    if( zIsTiny( a[p][i] ) ) return false;
+    if( p != i ){
+      for( k=i; k<6; k++ ) zSwap( double, a[i][k], a[p][k] );
+      zSwap( double, b[i], b[p] );
+    }
+    for( j=i+1; j<6; j++ ){
+      r = a[j][i] / a[i][i];
+      for( k=i; k<6; k++ ) a[j][k] -= r * a[i][k];
+      b[j] -= r * b[i];
+    }
+  }
+  for( i=5; i>=0; i-- ){
+    for( x[i]=b[i], k=i+1; k<6; k++ ) x[i] -= a[i][k] * x[k];
+    x[i] /= a[i][i];
+  }
+  return true;
+}
+
+/* update of a frame for the point-to-plane metric (linearized least-square). */
+static bool _zICPUpdatePlane(_zICPWork *work, int num, zVec3D norm[], double th, zFrame3D *df, int *n, double *sse)
+{
+  double a[6][6], b[6], x[6], jac[6], r;
+  zVec3D d, pn, *nv;
+  register int i, j, k;
+
+  for( j=0; j<6; j++ ){
+    for( k=0; k<6; k++ ) a[j][k] = 0;
+    b[j] = 0;
+  }
+  for( *n=0, *sse=0, i=0; i<num; i++ ){
+    if( !work->nn[i] || work->d[i] > th ) continue;
+    if( work->nn[i]->id < 0 ){
+      ZRUNERROR( ZEO_ERR_INVINDEX );
+      return false;
+    }
+    nv = &norm[work->nn[i]->id];
+    zVec3DSub( &work->p[i], &work->nn[i]->v, &d );
+    r = zVec3DInnerProd( &d, nv );
+    zVec3DOuterProd( &work->p[i], nv, &pn );
+    for( j=0; j<3; j++ ){
+      jac[j] = pn.e[j];
+      jac[j+3] = nv->e[j];
+    }
+    for( j=0; j<6; j++ ){
+      for( k=0; k<6; k++ ) a[j][k] += jac[j] * jac[k];
+      b[j] -= jac[j] * r;
+    }
+    *sse += zSqr( work->d[i] );
+    (*n)++;
+  }
+  if( *n < 6 || !_zICPSolve6( a, b, x ) ) return false;
+  zVec3DCreate( &d, x[0], x[1], x[2] );
+  zMat3DFromAA( zFrame3DAtt(df), &d );
+  zVec3DCreate( zFrame3DPos(df), x[3], x[4], x[5] );
+  return true;
+}
+
+/* iterative closest point registration with a workspace. */
+static zFrame3D *_zICP(_zICPWork *work, zVec3D src[], int srcnum, zVecTree3D *tree, zVec3D norm[], zICPParam *param, zFrame3D *f, zICPReport *report)
+{
+  zFrame3D df, tmp;
+  zVec3D aa;
+  double th, sse = 0;
+  int iter, n = 0;
+  register int i;
+  bool ret = true;
+
+  report->converged = false;
+  iter = param->iter;
+  ZITERINIT( iter );
+  for( i=0; i<iter; i++ ){
+    th = _zICPCorrespond( work, src, srcnum, tree, param, f );
+    ret = param->metric == ZEO_ICP_POINT_TO_PLANE ?
+      _zICPUpdatePlane( work, srcnum, norm, th, &df, &n, &sse ) :
+      _zICPUpdatePoint( work, srcnum, th, &df, &n, &sse );
+    if( !ret ) break;
+    zFrame3DCascade( &df, f, &tmp );
+    zFrame3DCopy( &tmp, f );
+    zMat3DToAA( zFrame3DAtt(&df), &aa );
+    if( zVec3DNorm( zFrame3DPos(&df) ) < param->tol && zVec3DNorm( &aa ) < param->tol ){
+      report->converged = true;
+      i++;
+      break;
+    }
+  }
+  report->iter = i;
+  report->num = n;
+  report->rmse = n > 0 ? sqrt( sse / n ) : HUGE_VAL;
+  if( !ret ){
+    ZRUNWARN( ZEO_WARN_ICP_FEWCORR, n );
+    return NULL;
+  }
+  if( !report->converged ) ZITERWARN( iter );
+  return f;
+}
+
+/* iterative closest point registration. */
+zFrame3D *zICP(zVec3D src[], int srcnum, zVecTree3D *tree, zVec3D norm[], zICPParam *param, zFrame3D *f, zICPReport *report)
+{
+  _zICPWork work;
+  zICPParam param_default;
+  zICPReport report_dummy;
+
+  if( !param ) param = zICPParamInit( &param_default );
+  if( !report ) report = &report_dummy;
+  if( param->metric == ZEO_ICP_POINT_TO_PLANE && !norm ){
+    ZRUNERROR( ZEO_ERR_ICP_NONORM );
+    return NULL;
+  }
+  if( srcnum <= 0 || tree->split == -1 ){
+    ZRUNERROR( ZEO_ERR_EMPTYSET );
+    return NULL;
+  }
+  if( _zICPWorkAlloc( &work, srcnum ) )
+    f = _zICP( &work, src, srcnum, tree, norm, param, f, report );
+  else
+    f = NULL;
+  _zICPWorkFree( &work );
+  return f;
+}
+
+/* iterative closest point registration to an array of points. */
+zFrame3D *zICPArray(zVec3D src[], int srcnum, zVec3D dest[], int destnum, zVec3D norm[], zICPParam *param, zFrame3D *f, zICPReport *report)
+{
+  zVecTree3D tree;
+
+  if( !zVecTree3DFromArray( &tree, dest, destnum ) ) return NULL;
+  f = zICP( src, srcnum, &tree, norm, param, f, report );
+  zVecTree3DDestroy( &tree );
+  return f;
+}
@@ -0,0 +1,433 @@
+/* Zeo - Z/Geometry and optics computation library.
+ * Copyright (C) 2005 Tomomichi Sugihara (Zhidao)
+ *
+ * zeo_pointcloud_ransac - RANSAC segmentation of point clouds.
+ */
+
+#include <zeo/zeo_pointcloud.h>
+
+/* tolerance to reject degenerate samples */
+#define ZEO_RANSAC_DEG_TOL 1.0e-6
+
+/* initialize parameters of RANSAC segmentation. */
+zRANSACParam *zRANSACParamInit(zRANSACParam *param)
+{
+  param->type = ZEO_RANSAC_ALL;
+  param->tol = 0.01;
+  param->angle = zDeg2Rad( 20 );
+  param->prob = 0.99;
+  param->iter = 0;
+  param->min_inlier = 100;
+  param->max_prim = 0;
+  param->radius = 0;
+  return param;
+}
+
+/* workspace of RANSAC segmentation. */
+typedef struct{
+  zVec3D *p;     /* points */
+  zVec3D *norm;  /* normal vectors */
+  int num;       /* number of points */
+  int *rest;     /* indices of points not assigned to any primitives */
+  int nrest;     /* number of points not assigned */
+  zVec3D *buf;   /* buffer of inliers to be refitted */
+  zVec3D *nbuf;  /* buffer of normal vectors of inliers */
+  double cos_th; /* threshold of cosine of normal vectors (negative to be ignored) */
+  zRANSACParam *param;
+} _zRANSAC;
+
+/* hypotheses
+ * the axis of a cylinder is kept as the unit vector from center[0]
+ * to center[1] until the ends are determined from the inliers. */
+
+/* sample size of a type of primitive. */
+static int _zRANSACSampleSize(ubyte type)
+{
+  switch( type ){
+  case ZEO_RANSAC_PLANE:  return 3;
+  case ZEO_RANSAC_SPHERE: return 4;
+  case ZEO_RANSAC_CYL:    return 2;
+  default: ;
+  }
+  return 0;
+}
+
+/* sample distinct indices of points not assigned. */
+static void _zRANSACSample(_zRANSAC *r, int idx[], int n)
+{
+  register int i, j;
+
+  for( i=0; i<n; i++ ){
+    idx[i] = r->rest[zRandI(0,r->nrest-1)];
+    for( j=0; j<i; j++ )
+      if( idx[j] == idx[i] ){
+        i--; break;
+      }
+  }
+}
+
+/* plane hypothesis from three points. */
+static bool _zRANSACHypoPlane(_zRANSAC *r, int idx[], zRANSACPrim *prim)
+{
+  zVec3D e1, e2, n;
+
+  zVec3DSub( &r->p[idx[1]], &r->p[idx[0]], &e1 );
+  zVec3DSub( &r->p[idx[2]], &r->p[idx[0]], &e2 );
+  zVec3DOuterProd( &e1, &e2, &n );
+  if( zVec3DNorm( &n ) < ZEO_RANSAC_DEG_TOL * zVec3DNorm( &e1 ) * zVec3DNorm( &e2 ) )
+    return false;
+  zVec3DCopy( &r->p[idx[0]], &prim->org );
+  zPlane3DCreate( &prim->plane, &prim->org, &n );
+  return true;
+}
+
+/* sphere hypothesis from four points. */
+static bool _zRANSACHypoSphere(_zRANSAC *r, int idx[], zRANSACPrim *prim)
+{
+  zVec3D d[3], b, c;
+  zMat3D m;
+  register int i;
+
+  for( i=0; i<3; i++ ){
+    zVec3DSub( &r->p[idx[i+1]], &r->p[idx[0]], &d[i] );
+    b.e[i] = 0.5 * zVec3DSqrNorm( &d[i] );
+  }
+  zMat3DCreate( &m,
+    d[0].c.x, d[0].c.y, d[0].c.z,
+    d[1].c.x, d[1].c.y, d[1].c.z,
+    d[2].c.x, d[2].c.y, d[2].c.z );
+  if( fabs( zMat3DDet( &m ) ) < ZEO_RANSAC_DEG_TOL * zVec3DNorm( &d[0] ) * zVec3DNorm( &d[1] ) * zVec3DNorm( &d[2] ) )
+    return false;
+  zMulInvMat3DVec3D( &m, &b, &c );
+  zSphere3DSetRadius( &prim->sphere, zVec3DNorm( &c ) );
+  zVec3DAdd( &r->p[idx[0]], &c, zSphere3DCenter(&prim->sphere) );
+  zSphere3DSetDiv( &prim->sphere, 0 );
+  return true;
+}
+
+/* cylinder hypothesis from two points with normal vectors. */
+static bool _zRANSACHypoCyl(_zRANSAC *r, int idx[], zRANSACPrim *prim)
+{
+  zVec3D *p0, *p1, *n0, *n1, axis, w, c0, c1, c;
+  double b, d, e, den, t, s;
+
+  p0 = &r->p[idx[0]]; n0 = &r->norm[idx[0]];
+  p1 = &r->p[idx[1]]; n1 = &r->norm[idx[1]];
+  if( zVec3DIsTiny( n0 ) || zVec3DIsTiny( n1 ) ) return false; /* normal vector unknown */
+  zVec3DOuterProd( n0, n1, &axis );
+  if( zVec3DNorm( &axis ) < ZEO_RANSAC_DEG_TOL ) return false;
+  zVec3DNormalizeDRC( &axis );
+  /* closest points between two normal lines */
+  zVec3DSub( p0, p1, &w );
+  b = zVec3DInnerProd( n0, n1 );
+  d = zVec3DInnerProd( n0, &w );
+  e = zVec3DInnerProd( n1, &w );
+  if( zIsTiny( ( den = 1 - b*b ) ) ) return false;
+  t = ( b*e - d ) / den;
+  s = ( e - b*d ) / den;
+  zVec3DCat( p0, t, n0, &c0 );
+  zVec3DCat( p1, s, n1, &c1 );
+  zVec3DMid( &c0, &c1, &c );
+  /* radius as the mean distance to the axis */
+  zVec3DSub( p0, &c, &w );
+  zVec3DCatDRC( &w, -zVec3DInnerProd( &w, &axis ), &axis );
+  t = zVec3DNorm( &w );
+  zVec3DSub( p1, &c, &w );
+  zVec3DCatDRC( &w, -zVec3DInnerProd( &w, &axis ), &axis );
+  t = 0.5 * ( t + zVec3DNorm( &w ) );
+  zVec3DAdd( &c, &axis, &c1 );
+  zCyl3DCreate( &prim->cyl, &c, &c1, t, 0 );
+  return true;
+}
+
+/* create a hypothesis of a primitive. */
+static bool _zRANSACHypo(_zRANSAC *r, ubyte type, zRANSACPrim *prim)
+{
+  int idx[4];
+
+  if( r->nrest < _zRANSACSampleSize( type ) ) return false;
+  _zRANSACSample( r, idx, _zRANSACSampleSize( type ) );
+  prim->type = type;
+  switch( type ){
+  case ZEO_RANSAC_PLANE:  return _zRANSACHypoPlane( r, idx, prim );
+  case ZEO_RANSAC_SPHERE: return _zRANSACHypoSphere( r, idx, prim );
+  case ZEO_RANSAC_CYL:    return _zRANSACHypoCyl( r, idx, prim );
+  default: ;
+  }
+  return false;
+}
+
+/* check if a point is an inlier of a primitive. */
+static bool _zRANSACIsInlier(_zRANSAC *r, zRANSACPrim *prim, int i)
+{
+  zVec3D v, axis;
+  double d, l;
+
+  switch( prim->type ){
+  case ZEO_RANSAC_PLANE:
+    if( fabs( zPlane3DPointDist( &prim->plane, &r->p[i] ) ) > r->param->tol ) return false;
+    zVec3DCopy( zPlane3DNorm(&prim->plane), &v );
+    break;
+  case ZEO_RANSAC_SPHERE:
+    zVec3DSub( &r->p[i], zSphere3DCenter(&prim->sphere), &v );
+    if( fabs( ( l = zVec3DNorm( &v ) ) - zSphere3DRadius(&prim->sphere) ) > r->param->tol ) return false;
+    if( r->cos_th < 0 ) return true;
+    if( zIsTiny( l ) ) return false;
+    zVec3DDivDRC( &v, l );
+    break;
+  case ZEO_RANSAC_CYL:
+    zVec3DSub( zCyl3DCenter(&prim->cyl,1), zCyl3DCenter(&prim->cyl,0), &axis );
+    zVec3DSub( &r->p[i], zCyl3DCenter(&prim->cyl,0), &v );
+    zVec3DCatDRC( &v, -zVec3DInnerProd( &v, &axis ), &axis );
+    if( fabs( ( l = zVec3DNorm( &v ) ) - zCyl3DRadius(&prim->cyl) ) > r->param->tol ) return false;
+    if( r->cos_th < 0 ) return true;
+    if( zIsTiny( l ) ) return false;
+    zVec3DDivDRC( &v, l );
+    break;
+  default:
+    return false;
+  }
+  if( r->cos_th < 0 || zVec3DIsTiny( &r->norm[i] ) ) return true; /* normal vector unknown */
+  d = zVec3DInnerProd( &v, &r->norm[i] );
+  return fabs( d ) >= r->cos_th;
+}
+
+/* score a hypothesis; terminated as soon as it turns out not to beat the best score. */
+static int _zRANSACScore(_zRANSAC *r, zRANSACPrim *prim, int best)
+{
+  register int i;
+  int n = 0;
+
+  for( i=0; i<r->nrest; i++ ){
+    if( _zRANSACIsInlier( r, prim, r->rest[i] ) )
+      n++;
+    else
+    if( n + r->nrest - i - 1 <= best ) return -1;
+  }
+  return n;
+}
+
+/* copy a primitive. */
+static zRANSACPrim *_zRANSACPrimCopy(zRANSACPrim *src, zRANSACPrim *dest)
+{
+  *dest = *src;
+  zPlane3DSetVert( &dest->plane, &dest->org );
+  return dest;
+}
+
+/* find the best hypothesis of a primitive. */
+static int _zRANSACFindBest(_zRANSAC *r, zRANSACPrim *best)
+{
+  zRANSACPrim hypo;
+  ubyte type;
+  int iter, n, score = 0;
+  double w, niter;
+  register int i;
+
+  iter = r->param->iter;
+  ZITERINIT( iter );
+  for( i=0; i<iter; i++ )
+    for( type=ZEO_RANSAC_PLANE; type<=ZEO_RANSAC_CYL; type<<=1 ){
+      if( !( r->param->type & type ) || !_zRANSACHypo( r, type, &hypo ) ) continue;
+      if( ( n = _zRANSACScore( r, &hypo, score ) ) <= score ) continue;
+      _zRANSACPrimCopy( &hypo, best );
+      score = n;
+      /* adaptive termination */
+      w = pow( (double)score / r->nrest, _zRANSACSampleSize( type ) );
+      if( w >= 1 ){
+        iter = i + 1;
+        break;
+      }
+      if( ( niter = log( 1 - r->param->prob ) / log( 1 - w ) ) < iter )
+        iter = _zMax( (int)niter, i + 1 );
+    }
+  return score;
+}
+
+/* collect inliers of a primitive. */
+static int _zRANSACCollect(_zRANSAC *r, zRANSACPrim *prim)
+{
+  register int i;
+  int n = 0;
+
+  for( i=0; i<r->nrest; i++ )
+    if( _zRANSACIsInlier( r, prim, r->rest[i] ) ){
+      zVec3DCopy( &r->p[r->rest[i]], &r->buf[n] );
+      if( r->norm ) zVec3DCopy( &r->norm[r->rest[i]], &r->nbuf[n] );
+      n++;
+    }
+  return n;
+}
+
+/* refit a cylinder to inliers. */
+static void _zRANSACRefitCyl(_zRANSAC *r, int n, zRANSACPrim *prim)
+{
+  zMat3D m;
+  zVec3D evec[3], axis, u, w, c, d, x, b;
+  double eval[3], rr, l;
+  register int i;
+
+  /* axis perpendicular to normal vectors */
+  zMat3DZero( &m );
+  for( i=0; i<n; i++ )
+    zMat3DAddDyad( &m, &r->nbuf[i], &r->nbuf[i] );
+  zMat3DSymEig( &m, eval, evec );
+  if( eval[0] < eval[1] )
+    i = eval[0] < eval[2] ? 0 : 2;
+  else
+    i = eval[1] < eval[2] ? 1 : 2;
+  zVec3DCopy( &evec[i], &axis );
+  if( !zVec3DOrthoNormalSpace( &axis, &u, &w ) ) return;
+  /* algebraic circle fitting on the cross section */
+  zVec3DBarycenter( r->buf, n, &c );
+  zMat3DZero( &m );
+  zVec3DZero( &b );
+  for( i=0; i<n; i++ ){
+    zVec3DSub( &r->buf[i], &c, &d );
+    zVec3DCreate( &x, zVec3DInnerProd( &d, &u ), zVec3DInnerProd( &d, &w ), 1 );
+    zMat3DAddDyad( &m, &x, &x );
+    zVec3DCatDRC( &b, -( zSqr(x.c.x) + zSqr(x.c.y) ), &x );
+  }
+  l = zMat3DNorm( &m );
+  if( fabs( zMat3DDet( &m ) ) < ZEO_RANSAC_DEG_TOL * l*l*l ) return;
+  zMulInvMat3DVec3D( &m, &b, &x );
+  if( ( rr = 0.25 * ( zSqr(x.c.x) + zSqr(x.c.y) ) - x.c.z ) <= 0 ) return;
+  zVec3DCatDRC( &c, -0.5*x.c.x, &u );
+  zVec3DCatDRC( &c, -0.5*x.c.y, &w );
+  zVec3DAdd( &c, &axis, &d );
+  zCyl3DCreate( &prim->cyl, &c, &d, sqrt( rr ), 0 );
+}
+
+/* refit a primitive to inliers by the least square method. */
+static void _zRANSACRefit(_zRANSAC *r, zRANSACPrim *prim)
+{
+  int n;
+
+  if( ( n = _zRANSACCollect( r, prim ) ) < _zRANSACSampleSize( prim->type ) ) return;
+  switch( prim->type ){
+  case ZEO_RANSAC_PLANE:  zPlane3DMean( &prim->plane, &prim->org, r->buf, n ); break;
+  case ZEO_RANSAC_SPHERE: zSphere3DFitArray( &prim->sphere, r->buf, n ); break;
+  case ZEO_RANSAC_CYL:    _zRANSACRefitCyl( r, n, prim ); break;
+  default: ;
+  }
+}
+
+/* assign inliers to a primitive and remove them from the rest. */
+static bool _zRANSACAssign(_zRANSAC *r, zRANSACPrim *prim)
+{
+  zVec3D axis, c, v;
+  double t, tmin = HUGE_VAL, tmax = -HUGE_VAL;
+  register int i;
+  int n;
+
+  if( !( prim->inlier = zAlloc( bool, r->num ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  if( prim->type == ZEO_RANSAC_CYL ){
+    zVec3DSub( zCyl3DCenter(&prim->cyl,1), zCyl3DCenter(&prim->cyl,0), &axis );
+    zVec3DCopy( zCyl3DCenter(&prim->cyl,0), &c );
+  }
+  for( prim->num=n=0, i=0; i<r->nrest; i++ ){
+    if( !_zRANSACIsInlier( r, prim, r->rest[i] ) ){
+      r->rest[n++] = r->rest[i];
+      continue;
+    }
+    prim->inlier[r->rest[i]] = true;
+    prim->num++;
+    if( prim->type == ZEO_RANSAC_CYL ){
+      zVec3DSub( &r->p[r->rest[i]], &c, &v );
+      t = zVec3DInnerProd( &v, &axis );
+      if( t < tmin ) tmin = t;
+      if( t > tmax ) tmax = t;
+    }
+  }
+  r->nrest = n;
+  if( prim->type == ZEO_RANSAC_CYL && prim->num > 0 ){
+    zVec3DCat( &c, tmin, &axis, zCyl3DCenter(&prim->cyl,0) );
+    zVec3DCat( &c, tmax, &axis, zCyl3DCenter(&prim->cyl,1) );
+  }
+  return true;
+}
+
+/* extract a primitive; returns the false value if no primitive found. */
+static bool _zRANSACExtract(_zRANSAC *r, zRANSACPrimList *list)
+{
+  zRANSACPrimListCell *cell;
+  zRANSACPrim best;
+
+  if( r->nrest < r->param->min_inlier ||
+      _zRANSACFindBest( r, &best ) < r->param->min_inlier ) return false;
+  _zRANSACRefit( r, &best );
+  if( !( cell = zAlloc( zRANSACPrimListCell, 1 ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  _zRANSACPrimCopy( &best, &cell->data );
+  if( !_zRANSACAssign( r, &cell->data ) || cell->data.num < r->param->min_inlier ){
+    zFree( cell->data.inlier );
+    zFree( cell );
+    return false;
+  }
+  zListInsertHead( list, cell );
+  return true;
+}
+
+/* segment primitives from a point cloud by RANSAC. */
+zRANSACPrimList *zRANSACSegment(zRANSACPrimList *list, zVec3D p[], int num, zVec3D norm[], zRANSACParam *param)
+{
+  _zRANSAC r;
+  zRANSACParam param_default;
+  zVec3D *norm_est = NULL;
+  register int i;
+
+  zListInit( list );
+  if( num <= 0 ){
+    ZRUNWARN( ZEO_ERR_EMPTYSET );
+    return list;
+  }
+  if( !param ) param = zRANSACParamInit( &param_default );
+  if( ( param->type & ZEO_RANSAC_CYL ) && !norm ){
+    if( !( norm = norm_est = zAlloc( zVec3D, num ) ) ){
+      ZALLOCERROR();
+      return NULL;
+    }
+    if( !zVec3DNormalEstimate( p, num, NULL, param->radius > 0 ? param->radius : 5 * param->tol, norm ) ){
+      ZRUNWARN( ZEO_WARN_RANSAC_NONORM );
+      for( i=0; i<num; i++ ) zVec3DZero( &norm[i] );
+    }
+  }
+  r.p = p;
+  r.norm = norm;
+  r.num = r.nrest = num;
+  r.cos_th = norm && param->angle > 0 ? cos( param->angle ) : -1;
+  r.param = param;
+  r.rest = zAlloc( int, num );
+  r.buf = zAlloc( zVec3D, num );
+  r.nbuf = norm ? zAlloc( zVec3D, num ) : NULL;
+  if( !r.rest || !r.buf || ( norm && !r.nbuf ) ){
+    ZALLOCERROR();
+    list = NULL;
+    goto TERMINATE;
+  }
+  for( i=0; i<num; i++ ) r.rest[i] = i;
+  while( ( param->max_prim <= 0 || zListSize(list) < param->max_prim ) &&
+         _zRANSACExtract( &r, list ) );
+
+ TERMINATE:
+  zFree( r.rest );
+  zFree( r.buf );
+  zFree( r.nbuf );
+  zFree( norm_est );
+  return list;
+}
+
+/* destroy a list of primitives segmented by RANSAC. */
+void zRANSACPrimListDestroy(zRANSACPrimList *list)
+{
+  zRANSACPrimListCell *cell;
+
+  zListForEach( list, cell )
+    zFree( cell->data.inlier );
+  zListDestroy( zRANSACPrimListCell, list );
+}
@@ -19,6 +19,7 @@ zShape3D *zShape3DInit(zShape3D *shape)
   shape->com = NULL;
   zShape3DSetOptic( shape, NULL );
   zShape3DSetTexture( shape, NULL );
+  shape->bv = NULL;
   return shape;
 }
 
@@ -29,6 +30,7 @@ zShape3D *zShape3DQueryAssign(zShape3D *shape, char *str)
   register int k;
 
   shape->com = NULL;
+  zShape3DBVInvalidate( shape );
   for( k=0; _zeo_shape_com[k]; k++ )
     if( strcmp( _zeo_shape_com[k]->typestr, str ) == 0 )
       return ( shape->body = ( shape->com = _zeo_shape_com[k] )->_alloc() ) ? shape : NULL;
@@ -40,6 +42,7 @@ void zShape3DDestroy(zShape3D *shape)
 {
   if( !shape ) return;
   zNameFree( shape );
+  zShape3DBVDestroy( shape );
   shape->com->_destroy( shape->body );
   zFree( shape->body );
   zShape3DSetOptic( shape, NULL );
@@ -57,6 +60,7 @@ zShape3D *zShape3DClone(zShape3D *org, zShape3D *cln, zOpticalInfo *oi)
     return NULL;
   zShape3DSetOptic( cln, oi );
   zShape3DSetTexture( cln, zShape3DTexture(org) );
+  cln->bv = NULL;
   return cln;
 }
 
@@ -67,6 +71,7 @@ zShape3D *zShape3DMirror(zShape3D *src, zShape3D *dest, zAxis axis)
     return NULL;
   zShape3DSetOptic( dest, zShape3DOptic(src) );
   zShape3DSetTexture( dest, zShape3DTexture(src) );
+  dest->bv = NULL;
   return dest;
 }
 
@@ -74,6 +79,7 @@ zShape3D *zShape3DMirror(zShape3D *src, zShape3D *dest, zAxis axis)
 zShape3D *zShape3DXform(zShape3D *src, zFrame3D *f, zShape3D *dest)
 {
   src->com->_xform( src->body, f, dest->body );
+  zShape3DBVInvalidate( dest );
   return dest;
 }
 
@@ -81,6 +87,7 @@ zShape3D *zShape3DXform(zShape3D *src, zFrame3D *f, zShape3D *dest)
 zShape3D *zShape3DXformInv(zShape3D *src, zFrame3D *f, zShape3D *dest)
 {
   src->com->_xforminv( src->body, f, dest->body );
+  zShape3DBVInvalidate( dest );
   return dest;
 }
 
@@ -102,6 +109,12 @@ bool zShape3DPointIsInside(zShape3D *shape, zVec3D *p, bool rim)
   return shape->com->_pointisinside( shape->body, p, rim );
 }
 
+/* intersection of a ray and a 3D shape. */
+bool zShape3DRaycast(zShape3D *shape, zRay3D *ray, double *t, zVec3D *norm)
+{
+  return shape->com->_raycast( shape->body, ray, t, norm );
+}
+
 /* convert a shape to a polyhedron. */
 zShape3D *zShape3DToPH(zShape3D *shape)
 {
@@ -115,6 +128,7 @@ zShape3D *zShape3DToPH(zShape3D *shape)
   if( shape->com->_toph( shape->body, ph ) ){
     shape->body = ph;
     shape->com = &zeo_shape3d_ph_com;
+    zShape3DBVInvalidate( shape );
     return shape;
   }
   zPH3DDestroy( ph );
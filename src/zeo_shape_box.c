@@ -127,6 +127,40 @@ bool zBox3DPointIsInside(zBox3D *box, zVec3D *p, bool rim)
   return true;
 }
 
+/* intersection of a ray and a 3D box. */
+bool zBox3DRaycast(zBox3D *box, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D o, d;
+  double t1, t2, tmin = -HUGE_VAL, tmax = HUGE_VAL, h;
+  zDir i, imin = zX, imax = zX;
+
+  zXform3DInv( &box->f, zRay3DOrg(ray), &o );
+  zMulMat3DTVec3D( zFrame3DAtt(&box->f), zRay3DDir(ray), &d );
+  for( i=zX; i<=zZ; i++ ){
+    h = 0.5 * zBox3DDia(box,i);
+    if( zIsTiny( d.e[i] ) ){ /* parallel to the slab */
+      if( o.e[i] < -h || o.e[i] > h ) return false;
+      continue;
+    }
+    t1 = ( -h - o.e[i] ) / d.e[i];
+    t2 = (  h - o.e[i] ) / d.e[i];
+    if( t1 > t2 ) zSwap( double, t1, t2 );
+    if( t1 > tmin ){ tmin = t1; imin = i; }
+    if( t2 < tmax ){ tmax = t2; imax = i; }
+    if( tmin > tmax ) return false;
+  }
+  if( tmin >= 0 ){ /* entering */
+    if( tmin >= *t ) return false;
+    *t = tmin;
+    if( norm ) zVec3DMul( zBox3DAxis(box,imin), d.e[imin] > 0 ? -1 : 1, norm );
+  } else{ /* exiting from inside */
+    if( tmax < 0 || tmax >= *t ) return false;
+    *t = tmax;
+    if( norm ) zVec3DMul( zBox3DAxis(box,imax), d.e[imax] > 0 ? 1 : -1, norm );
+  }
+  return true;
+}
+
 /* volume of a 3D box. */
 double zBox3DVolume(zBox3D *box)
 {
@@ -293,6 +327,8 @@ static double _zShape3DBoxPointDist(void *shape, zVec3D *p){
   return zBox3DPointDist( shape, p ); }
 static bool _zShape3DBoxPointIsInside(void *shape, zVec3D *p, bool rim){
   return zBox3DPointIsInside( shape, p, rim ); }
+static bool _zShape3DBoxRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return zBox3DRaycast( shape, ray, t, norm ); }
 static double _zShape3DBoxVolume(void *shape){
   return zBox3DVolume( shape ); }
 static zVec3D *_zShape3DBoxBarycenter(void *shape, zVec3D *c){
@@ -324,6 +360,7 @@ zShape3DCom zeo_shape3d_box_com = {
   _zShape3DBoxClosest,
   _zShape3DBoxPointDist,
   _zShape3DBoxPointIsInside,
+  _zShape3DBoxRaycast,
   _zShape3DBoxVolume,
   _zShape3DBoxBarycenter,
   _zShape3DBoxInertia,
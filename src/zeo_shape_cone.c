@@ -159,6 +159,62 @@ bool zCone3DPointIsInside(zCone3D *cone, zVec3D *p, bool rim)
   return -d <= l + ( rim ? zTOL : 0 ) ? true : false;
 }
 
+/* intersection of a ray and a 3D cone. */
+bool zCone3DRaycast(zCone3D *cone, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D u, w, q;
+  double h, m, du, wu, aa, b, c, s, r[2], tmin;
+  int k, n = 0, face = -1; /* -1: no hit, 0: bottom, 2: side */
+
+  zVec3DSub( zCone3DCenter(cone), zCone3DVert(cone), &u );
+  if( ( h = zVec3DNormalizeDRC( &u ) ) < 0 ) return false;
+  m = 1 + zSqr( zCone3DRadius(cone) / h );
+  zVec3DSub( zRay3DOrg(ray), zCone3DVert(cone), &w );
+  du = zVec3DInnerProd( zRay3DDir(ray), &u );
+  wu = zVec3DInnerProd( &w, &u );
+  tmin = *t;
+  /* side: |w+td|^2 = m ((w+td).u)^2 with 0 <= (w+td).u <= h */
+  aa = 1 - m*du*du;
+  b = zVec3DInnerProd( &w, zRay3DDir(ray) ) - m*wu*du;
+  c = zVec3DSqrNorm( &w ) - m*wu*wu;
+  if( zIsTiny( aa ) ){
+    if( !zIsTiny( b ) ) r[n++] = -0.5 * c / b;
+  } else
+  if( ( s = b*b - aa*c ) >= 0 ){
+    s = sqrt( s );
+    r[0] = ( -b - s ) / aa;
+    r[1] = ( -b + s ) / aa;
+    if( r[0] > r[1] ) zSwap( double, r[0], r[1] );
+    n = 2;
+  }
+  for( k=0; k<n; k++ )
+    if( r[k] >= 0 && r[k] < tmin && wu + r[k]*du >= 0 && wu + r[k]*du <= h ){
+      tmin = r[k];
+      face = 2;
+      break;
+    }
+  /* bottom */
+  if( !zIsTiny( du ) && ( s = ( h - wu ) / du ) >= 0 && s < tmin ){
+    zVec3DCat( &w, s, zRay3DDir(ray), &q );
+    zVec3DCatDRC( &q, -h, &u );
+    if( zVec3DSqrNorm( &q ) <= zSqr( zCone3DRadius(cone) ) ){
+      tmin = s;
+      face = 0;
+    }
+  }
+  if( face < 0 ) return false;
+  *t = tmin;
+  if( norm ){
+    if( face == 2 ){
+      zVec3DCat( &w, tmin, zRay3DDir(ray), &q );
+      zVec3DCat( &q, -m*zVec3DInnerProd( &q, &u ), &u, norm );
+      zVec3DNormalizeDRC( norm );
+    } else
+      zVec3DCopy( &u, norm );
+  }
+  return true;
+}
+
 /* height of a 3D cone. */
 double zCone3DHeight(zCone3D *cone)
 {
@@ -300,6 +356,8 @@ static double _zShape3DConePointDist(void *shape, zVec3D *p){
   return zCone3DPointDist( shape, p ); }
 static bool _zShape3DConePointIsInside(void *shape, zVec3D *p, bool rim){
   return zCone3DPointIsInside( shape, p, rim ); }
+static bool _zShape3DConeRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return zCone3DRaycast( shape, ray, t, norm ); }
 static double _zShape3DConeVolume(void *shape){
   return zCone3DVolume( shape ); }
 static zVec3D *_zShape3DConeBarycenter(void *shape, zVec3D *c){
@@ -331,6 +389,7 @@ zShape3DCom zeo_shape3d_cone_com = {
   _zShape3DConeClosest,
   _zShape3DConePointDist,
   _zShape3DConePointIsInside,
+  _zShape3DConeRaycast,
   _zShape3DConeVolume,
   _zShape3DConeBarycenter,
   _zShape3DConeInertia,
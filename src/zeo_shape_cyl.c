@@ -142,6 +142,59 @@ bool zCyl3DPointIsInside(zCyl3D *cyl, zVec3D *p, bool rim)
   return d >= ( rim ? -zTOL : 0 ) && d <= ( rim ? l+zTOL : l ) ? true : false;
 }
 
+/* intersection of a ray and a 3D cylinder. */
+bool zCyl3DRaycast(zCyl3D *cyl, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D a, w, dp, wp, q;
+  double h, dd, wa, aa, b, c, s, r[2], tmin;
+  int k, face = -1; /* -1: no hit, 0/1: bottom/top, 2: side */
+
+  zCyl3DAxis( cyl, &a );
+  if( ( h = zVec3DNormalizeDRC( &a ) ) < 0 ) return false;
+  zVec3DSub( zRay3DOrg(ray), zCyl3DCenter(cyl,0), &w );
+  dd = zVec3DInnerProd( zRay3DDir(ray), &a );
+  wa = zVec3DInnerProd( &w, &a );
+  zVec3DCat( zRay3DDir(ray), -dd, &a, &dp );
+  zVec3DCat( &w, -wa, &a, &wp );
+  tmin = *t;
+  /* side */
+  if( !zIsTiny( aa = zVec3DSqrNorm( &dp ) ) ){
+    b = zVec3DInnerProd( &dp, &wp );
+    c = zVec3DSqrNorm( &wp ) - zSqr( zCyl3DRadius(cyl) );
+    if( ( s = b*b - aa*c ) >= 0 ){
+      s = sqrt( s );
+      r[0] = ( -b - s ) / aa;
+      r[1] = ( -b + s ) / aa;
+      for( k=0; k<2; k++ )
+        if( r[k] >= 0 && r[k] < tmin && wa + r[k]*dd >= 0 && wa + r[k]*dd <= h ){
+          tmin = r[k];
+          face = 2;
+          break;
+        }
+    }
+  }
+  /* caps */
+  if( !zIsTiny( dd ) )
+    for( k=0; k<2; k++ ){
+      if( ( s = ( k*h - wa ) / dd ) < 0 || s >= tmin ) continue;
+      zVec3DCat( &wp, s, &dp, &q );
+      if( zVec3DSqrNorm( &q ) <= zSqr( zCyl3DRadius(cyl) ) ){
+        tmin = s;
+        face = k;
+      }
+    }
+  if( face < 0 ) return false;
+  *t = tmin;
+  if( norm ){
+    if( face == 2 ){
+      zVec3DCat( &wp, tmin, &dp, norm );
+      zVec3DNormalizeDRC( norm );
+    } else
+      zVec3DMul( &a, face == 0 ? -1 : 1, norm );
+  }
+  return true;
+}
+
 /* height of a 3D cylinder. */
 double zCyl3DHeight(zCyl3D *cyl)
 {
@@ -283,6 +336,8 @@ static double _zShape3DCylPointDist(void *shape, zVec3D *p){
   return zCyl3DPointDist( shape, p ); }
 static bool _zShape3DCylPointIsInside(void *shape, zVec3D *p, bool rim){
   return zCyl3DPointIsInside( shape, p, rim ); }
+static bool _zShape3DCylRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return zCyl3DRaycast( shape, ray, t, norm ); }
 static double _zShape3DCylVolume(void *shape){
   return zCyl3DVolume( shape ); }
 static zVec3D *_zShape3DCylBarycenter(void *shape, zVec3D *c){
@@ -314,6 +369,7 @@ zShape3DCom zeo_shape3d_cyl_com = {
   _zShape3DCylClosest,
   _zShape3DCylPointDist,
   _zShape3DCylPointIsInside,
+  _zShape3DCylRaycast,
   _zShape3DCylVolume,
   _zShape3DCylBarycenter,
   _zShape3DCylInertia,
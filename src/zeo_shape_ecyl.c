@@ -182,6 +182,64 @@ bool zECyl3DPointIsInside(zECyl3D *cyl, zVec3D *p, bool rim)
   return zECyl3DPointDist( cyl, p ) < ( rim ? zTOL : 0 ) ? true : false;
 }
 
+/* intersection of a ray and a 3D elliptic cylinder. */
+bool zECyl3DRaycast(zECyl3D *cyl, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D a, w, o, d;
+  double h, aa, b, c, s, r[2], tmin;
+  int k, face = -1; /* -1: no hit, 0/1: bottom/top, 2: side */
+
+  zECyl3DAxis( cyl, &a );
+  if( ( h = zVec3DNormalizeDRC( &a ) ) < 0 ) return false;
+  /* transform the cross section to the unit circle */
+  zVec3DSub( zRay3DOrg(ray), zECyl3DCenter(cyl,0), &w );
+  zVec3DCreate( &o,
+    zVec3DInnerProd( &w, zECyl3DRadVec(cyl,0) ) / zECyl3DRadius(cyl,0),
+    zVec3DInnerProd( &w, zECyl3DRadVec(cyl,1) ) / zECyl3DRadius(cyl,1),
+    zVec3DInnerProd( &w, &a ) );
+  zVec3DCreate( &d,
+    zVec3DInnerProd( zRay3DDir(ray), zECyl3DRadVec(cyl,0) ) / zECyl3DRadius(cyl,0),
+    zVec3DInnerProd( zRay3DDir(ray), zECyl3DRadVec(cyl,1) ) / zECyl3DRadius(cyl,1),
+    zVec3DInnerProd( zRay3DDir(ray), &a ) );
+  tmin = *t;
+  /* side */
+  if( !zIsTiny( aa = zSqr(d.c.x) + zSqr(d.c.y) ) ){
+    b = o.c.x*d.c.x + o.c.y*d.c.y;
+    c = zSqr(o.c.x) + zSqr(o.c.y) - 1;
+    if( ( s = b*b - aa*c ) >= 0 ){
+      s = sqrt( s );
+      r[0] = ( -b - s ) / aa;
+      r[1] = ( -b + s ) / aa;
+      for( k=0; k<2; k++ )
+        if( r[k] >= 0 && r[k] < tmin && o.c.z + r[k]*d.c.z >= 0 && o.c.z + r[k]*d.c.z <= h ){
+          tmin = r[k];
+          face = 2;
+          break;
+        }
+    }
+  }
+  /* caps */
+  if( !zIsTiny( d.c.z ) )
+    for( k=0; k<2; k++ ){
+      if( ( s = ( k*h - o.c.z ) / d.c.z ) < 0 || s >= tmin ) continue;
+      if( zSqr( o.c.x + s*d.c.x ) + zSqr( o.c.y + s*d.c.y ) <= 1 ){
+        tmin = s;
+        face = k;
+      }
+    }
+  if( face < 0 ) return false;
+  *t = tmin;
+  if( norm ){
+    if( face == 2 ){
+      zVec3DMul( zECyl3DRadVec(cyl,0), ( o.c.x + tmin*d.c.x ) / zECyl3DRadius(cyl,0), norm );
+      zVec3DCatDRC( norm, ( o.c.y + tmin*d.c.y ) / zECyl3DRadius(cyl,1), zECyl3DRadVec(cyl,1) );
+      zVec3DNormalizeDRC( norm );
+    } else
+      zVec3DMul( &a, face == 0 ? -1 : 1, norm );
+  }
+  return true;
+}
+
 /* height of a 3D elliptic cylinder. */
 double zECyl3DHeight(zECyl3D *cyl)
 {
@@ -327,6 +385,8 @@ static double _zShape3DECylPointDist(void *shape, zVec3D *p){
   return zECyl3DPointDist( shape, p ); }
 static bool _zShape3DECylPointIsInside(void *shape, zVec3D *p, bool rim){
   return zECyl3DPointIsInside( shape, p, rim ); }
+static bool _zShape3DECylRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return zECyl3DRaycast( shape, ray, t, norm ); }
 static double _zShape3DECylVolume(void *shape){
   return zECyl3DVolume( shape ); }
 static zVec3D *_zShape3DECylBarycenter(void *shape, zVec3D *c){
@@ -358,6 +418,7 @@ zShape3DCom zeo_shape3d_ecyl_com = {
   _zShape3DECylClosest,
   _zShape3DECylPointDist,
   _zShape3DECylPointIsInside,
+  _zShape3DECylRaycast,
   _zShape3DECylVolume,
   _zShape3DECylBarycenter,
   _zShape3DECylInertia,
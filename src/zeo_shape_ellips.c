@@ -166,6 +166,37 @@ bool zEllips3DPointIsInside(zEllips3D *ellips, zVec3D *p, bool rim)
   return l < 1.0 ? true : false;
 }
 
+/* intersection of a ray and a 3D ellipsoid. */
+bool zEllips3DRaycast(zEllips3D *ellips, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D o, d, n;
+  double a, b, c, s;
+  zDir i;
+
+  /* transform the ellipsoid to the unit sphere */
+  zXform3DInv( &ellips->f, zRay3DOrg(ray), &o );
+  zMulMat3DTVec3D( zFrame3DAtt(&ellips->f), zRay3DDir(ray), &d );
+  for( i=zX; i<=zZ; i++ ){
+    o.e[i] /= zEllips3DRadius(ellips,i);
+    d.e[i] /= zEllips3DRadius(ellips,i);
+  }
+  a = zVec3DSqrNorm( &d );
+  b = zVec3DInnerProd( &o, &d );
+  c = zVec3DSqrNorm( &o ) - 1;
+  if( ( s = b*b - a*c ) < 0 ) return false;
+  s = sqrt( s );
+  if( ( s = ( c > 0 ? -b - s : -b + s ) / a ) < 0 || s >= *t ) return false;
+  *t = s;
+  if( norm ){
+    zVec3DCatDRC( &o, s, &d );
+    for( i=zX; i<=zZ; i++ )
+      n.e[i] = o.e[i] / zEllips3DRadius(ellips,i);
+    zMulMat3DVec3D( zFrame3DAtt(&ellips->f), &n, norm );
+    zVec3DNormalizeDRC( norm );
+  }
+  return true;
+}
+
 /* volume of a 3D ellipsoid. */
 double zEllips3DVolume(zEllips3D *ellips)
 {
@@ -330,6 +361,8 @@ static double _zShape3DEllipsPointDist(void *shape, zVec3D *p){
   return zEllips3DPointDist( shape, p ); }
 static bool _zShape3DEllipsPointIsInside(void *shape, zVec3D *p, bool rim){
   return zEllips3DPointIsInside( shape, p, rim ); }
+static bool _zShape3DEllipsRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return zEllips3DRaycast( shape, ray, t, norm ); }
 static double _zShape3DEllipsVolume(void *shape){
   return zEllips3DVolume( shape ); }
 static zVec3D *_zShape3DEllipsBarycenter(void *shape, zVec3D *c){
@@ -361,6 +394,7 @@ zShape3DCom zeo_shape3d_ellips_com = {
   _zShape3DEllipsClosest,
   _zShape3DEllipsPointDist,
   _zShape3DEllipsPointIsInside,
+  _zShape3DEllipsRaycast,
   _zShape3DEllipsVolume,
   _zShape3DEllipsBarycenter,
   _zShape3DEllipsInertia,
@@ -38,6 +38,8 @@ static double _zShape3DNURBSPointDist(void *shape, zVec3D *p){
 
 static bool _zShape3DNURBSPointIsInside(void *shape, zVec3D *p, bool rim){
   return false; }
+static bool _zShape3DNURBSRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return false; }
 static double _zShape3DNURBSVolume(void *shape){
   return 0; }
 static zVec3D *_zShape3DNURBSBarycenter(void *shape, zVec3D *c){
@@ -67,6 +69,7 @@ zShape3DCom zeo_shape3d_nurbs_com = {
   _zShape3DNURBSClosest,
   _zShape3DNURBSPointDist,
   _zShape3DNURBSPointIsInside,
+  _zShape3DNURBSRaycast,
   _zShape3DNURBSVolume,
   _zShape3DNURBSBarycenter,
   _zShape3DNURBSInertia,
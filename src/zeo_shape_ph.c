@@ -36,6 +36,8 @@ static double _zShape3DPHPointDist(void *shape, zVec3D *p){
   return zPH3DPointDist( shape, p ); }
 static bool _zShape3DPHPointIsInside(void *shape, zVec3D *p, bool rim){
   return zPH3DPointIsInside( shape, p, rim ); }
+static bool _zShape3DPHRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return zPH3DRaycast( shape, ray, t, norm ); }
 static double _zShape3DPHVolume(void *shape){
   return zPH3DVolume( shape ); }
 static zVec3D *_zShape3DPHBarycenter(void *shape, zVec3D *c){
@@ -65,6 +67,7 @@ zShape3DCom zeo_shape3d_ph_com = {
   _zShape3DPHClosest,
   _zShape3DPHPointDist,
   _zShape3DPHPointIsInside,
+  _zShape3DPHRaycast,
   _zShape3DPHVolume,
   _zShape3DPHBarycenter,
   _zShape3DPHInertia,
@@ -102,6 +102,26 @@ bool zSphere3DPointIsInside(zSphere3D *sphere, zVec3D *p, bool rim)
   return zSphere3DPointDist( sphere, p ) < ( rim ? zTOL : 0 ) ? true : false;
 }
 
+/* intersection of a ray and a 3D sphere. */
+bool zSphere3DRaycast(zSphere3D *sphere, zRay3D *ray, double *t, zVec3D *norm)
+{
+  zVec3D d;
+  double b, c, s;
+
+  zVec3DSub( zRay3DOrg(ray), zSphere3DCenter(sphere), &d );
+  b = zVec3DInnerProd( &d, zRay3DDir(ray) );
+  c = zVec3DSqrNorm( &d ) - zSqr( zSphere3DRadius(sphere) );
+  if( ( s = b*b - c ) < 0 ) return false;
+  s = sqrt( s );
+  if( ( s = c > 0 ? -b - s : -b + s ) < 0 || s >= *t ) return false;
+  *t = s;
+  if( norm ){
+    zVec3DCat( &d, s, zRay3DDir(ray), norm );
+    zVec3DDivDRC( norm, zSphere3DRadius(sphere) );
+  }
+  return true;
+}
+
 /* volume of a 3D sphere. */
 double zSphere3DVolume(zSphere3D *sphere)
 {
@@ -169,18 +189,64 @@ zPH3D *zSphere3DToPH(zSphere3D *sphere, zPH3D *ph)
   return ph;
 }
 
+/* accumulator of the normal equation to fit a sphere to point cloud. */
+typedef struct{
+  zMat3D m; /* sum of dyadic products of relative positions */
+  zVec3D q; /* sum of relative positions */
+  zVec3D b; /* sum of relative positions weighted by errors */
+  double e; /* sum of errors */
+} _zSphere3DFitAcc;
+
+/* initialize the accumulator. */
+static void _zSphere3DFitAccInit(_zSphere3DFitAcc *acc)
+{
+  zMat3DZero( &acc->m );
+  zVec3DZero( &acc->q );
+  zVec3DZero( &acc->b );
+  acc->e = 0;
+}
+
+/* accumulate a point to the normal equation. */
+static void _zSphere3DFitAccAdd(_zSphere3DFitAcc *acc, zSphere3D *s, zVec3D *p)
+{
+  zVec3D q;
+  double e;
+
+  zVec3DSub( p, zSphere3DCenter(s), &q );
+  e = zVec3DSqrNorm( &q ) - zSqr( zSphere3DRadius(s) );
+  zMat3DAddDyad( &acc->m, &q, &q );
+  zVec3DAddDRC( &acc->q, &q );
+  zVec3DCatDRC( &acc->b, e, &q );
+  acc->e += e;
+}
+
+/* update a sphere by a Gauss-Newton step; returns the true value if converged. */
+static bool _zSphere3DFitUpdate(zSphere3D *s, _zSphere3DFitAcc *acc, int n)
+{
+  zVec3D m, u, w;
+  double den, dr;
+
+  /* solve the 4x4 normal equation by the Schur complement */
+  zVec3DMul( &acc->q, zSphere3DRadius(s), &m );
+  zMulInvMat3DVec3D( &acc->m, &acc->b, &u );
+  zMulInvMat3DVec3D( &acc->m, &m, &w );
+  if( zIsTiny( ( den = n*zSqr(zSphere3DRadius(s)) - zVec3DInnerProd( &m, &w ) ) ) ) return true;
+  dr = ( zSphere3DRadius(s)*acc->e - zVec3DInnerProd( &m, &u ) ) / den;
+  zVec3DCatDRC( &u, -dr, &w );
+  if( zVec3DIsTiny( &u ) && zIsTiny( dr ) ) return true;
+  zVec3DCatDRC( zSphere3DCenter(s), 0.5, &u );
+  zSphere3DRadius(s) += 0.5*dr;
+  return false;
+}
+
 /* fit a sphere to point cloud. */
 zSphere3D *zSphere3DFit(zSphere3D *s, zVec3DList *pc)
 {
-  zMat c;
-  zVec e, d;
+  _zSphere3DFitAcc acc;
   zVec3DListCell *p;
   int iter = 0;
-  register int i, j;
+  register int i;
 
-  c = zMatAlloc( zListSize(pc), 4 );
-  e = zVecAlloc( zListSize(pc) );
-  d = zVecAlloc( 4 );
   /* initial guess */
   zSphere3DInit( s );
   zVec3DBarycenterPL( pc, zSphere3DCenter(s) );
@@ -191,24 +257,38 @@ zSphere3D *zSphere3DFit(zSphere3D *s, zVec3DList *pc)
   /* iterative fitting */
   ZITERINIT( iter );
   for( i=0; i<iter; i++ ){
-    j = 0;
-    zListForEach( pc, p ){
-      zMatElemNC(c,j,0) = p->data->e[zX] - zSphere3DCenter(s)->e[zX];
-      zMatElemNC(c,j,1) = p->data->e[zY] - zSphere3DCenter(s)->e[zY];
-      zMatElemNC(c,j,2) = p->data->e[zZ] - zSphere3DCenter(s)->e[zZ];
-      zMatElemNC(c,j,3) = zSphere3DRadius(s);
-      zVecElemNC(e,j)   = zVec3DSqrDist(p->data,zSphere3DCenter(s)) - zSqr(zSphere3DRadius(s));
-      j++;
-    }
-    zLESolveErrorMin( c, e, NULL, d );
-    if( zVecIsTiny( d ) ) goto TERMINATE;
-    zVec3DCatDRC( zSphere3DCenter(s), 0.5, (zVec3D*)&zVecElemNC(d,0) );
-    zSphere3DRadius(s) += 0.5*zVecElemNC(d,3);
+    _zSphere3DFitAccInit( &acc );
+    zListForEach( pc, p )
+      _zSphere3DFitAccAdd( &acc, s, p->data );
+    if( _zSphere3DFitUpdate( s, &acc, zListSize(pc) ) ) return s;
   }
   ZITERWARN( iter );
+  return s;
+}
+
+/* fit a sphere to an array of points. */
+zSphere3D *zSphere3DFitArray(zSphere3D *s, zVec3D v[], int n)
+{
+  _zSphere3DFitAcc acc;
+  int iter = 0;
+  register int i, j;
 
- TERMINATE:
-  zMatFree( c );
+  /* initial guess */
+  zSphere3DInit( s );
+  zVec3DBarycenter( v, n, zSphere3DCenter(s) );
+  zSphere3DSetRadius( s, 0 );
+  for( j=0; j<n; j++ )
+    zSphere3DRadius(s) += zVec3DDist( &v[j], zSphere3DCenter(s) );
+  zSphere3DRadius(s) /= n;
+  /* iterative fitting */
+  ZITERINIT( iter );
+  for( i=0; i<iter; i++ ){
+    _zSphere3DFitAccInit( &acc );
+    for( j=0; j<n; j++ )
+      _zSphere3DFitAccAdd( &acc, s, &v[j] );
+    if( _zSphere3DFitUpdate( s, &acc, n ) ) return s;
+  }
+  ZITERWARN( iter );
   return s;
 }
 
@@ -262,6 +342,8 @@ static double _zShape3DSpherePointDist(void *shape, zVec3D *p){
   return zSphere3DPointDist( shape, p ); }
 static bool _zShape3DSpherePointIsInside(void *shape, zVec3D *p, bool rim){
   return zSphere3DPointIsInside( shape, p, rim ); }
+static bool _zShape3DSphereRaycast(void *shape, zRay3D *ray, double *t, zVec3D *norm){
+  return zSphere3DRaycast( shape, ray, t, norm ); }
 static double _zShape3DSphereVolume(void *shape){
   return zSphere3DVolume( shape ); }
 static zVec3D *_zShape3DSphereBarycenter(void *shape, zVec3D *c){
@@ -293,6 +375,7 @@ zShape3DCom zeo_shape3d_sphere_com = {
   _zShape3DSphereClosest,
   _zShape3DSpherePointDist,
   _zShape3DSpherePointIsInside,
+  _zShape3DSphereRaycast,
   _zShape3DSphereVolume,
   _zShape3DSphereBarycenter,
   _zShape3DSphereInertia,
@@ -10,6 +10,7 @@
 zVecTree3D *zVecTree3DInit(zVecTree3D *tree)
 {
   tree->split = -1; /* invalid split axis */
+  tree->id = -1;
   tree->s[0] = tree->s[1] = NULL;
   zVec3DCreate( &tree->vmin,-HUGE_VAL,-HUGE_VAL,-HUGE_VAL );
   zVec3DCreate( &tree->vmax, HUGE_VAL, HUGE_VAL, HUGE_VAL );
@@ -30,7 +31,7 @@ void zVecTree3DDestroy(zVecTree3D *tree)
 }
 
 /* create a leaf of a 3D vector tree. */
-static zVecTree3D *_zVecTree3DCreateLeaf(zAxis split, zVec3D *v)
+static zVecTree3D *_zVecTree3DCreateLeaf(zAxis split, zVec3D *v, int id)
 {
   zVecTree3D *leaf;
 
@@ -40,6 +41,7 @@ static zVecTree3D *_zVecTree3DCreateLeaf(zAxis split, zVec3D *v)
   }
   leaf->split = split;
   zVec3DCopy( v, &leaf->v );
+  leaf->id = id;
   leaf->s[0] = leaf->s[1] = NULL;
   return leaf;
 }
@@ -51,14 +53,14 @@ static int _zVecTree3DChooseBranch(zVecTree3D *node, zVec3D *v)
 }
 
 /* add a new 3D vector to a tree. */
-static zVecTree3D *_zVecTree3DAdd(zVecTree3D *node, zVec3D *v)
+static zVecTree3D *_zVecTree3DAdd(zVecTree3D *node, zVec3D *v, int id)
 {
   int b;
   zVecTree3D *leaf;
 
   if( node->s[( b = _zVecTree3DChooseBranch( node, v ) )] )
-    return _zVecTree3DAdd( node->s[b], v );
-  if( !( leaf = _zVecTree3DCreateLeaf( ( node->split + 1 ) % 3, v ) ) )
+    return _zVecTree3DAdd( node->s[b], v, id );
+  if( !( leaf = _zVecTree3DCreateLeaf( ( node->split + 1 ) % 3, v, id ) ) )
     return NULL;
   node->s[b] = leaf;
   zVec3DCopy( &node->vmin, &leaf->vmin );
@@ -70,15 +72,84 @@ static zVecTree3D *_zVecTree3DAdd(zVecTree3D *node, zVec3D *v)
   return leaf;
 }
 
-/* add a new 3D vector to a tree. */
-zVecTree3D *zVecTree3DAdd(zVecTree3D *tree, zVec3D *v)
+/* add a new 3D vector with an identifier to a tree. */
+zVecTree3D *zVecTree3DAddID(zVecTree3D *tree, zVec3D *v, int id)
 {
   if( tree->split == -1 ){
     tree->split = zX;
     zVec3DCopy( v, &tree->v );
+    tree->id = id;
     return tree;
   }
-  return _zVecTree3DAdd( tree, v );
+  return _zVecTree3DAdd( tree, v, id );
+}
+
+/* add a new 3D vector to a tree. */
+zVecTree3D *zVecTree3DAdd(zVecTree3D *tree, zVec3D *v)
+{
+  return zVecTree3DAddID( tree, v, -1 );
+}
+
+/* balanced tree construction */
+
+typedef struct{
+  zVec3D *v;
+  zAxis axis;
+} _zVecTree3DSortData;
+
+/* comparison function of indices of vectors along an axis. */
+static int _zVecTree3DCmp(void *i1, void *i2, void *priv)
+{
+  _zVecTree3DSortData *data;
+  double d1, d2;
+
+  data = (_zVecTree3DSortData *)priv;
+  d1 = data->v[*(int *)i1].e[data->axis];
+  d2 = data->v[*(int *)i2].e[data->axis];
+  if( d1 > d2 ) return 1;
+  if( d1 < d2 ) return -1;
+  return 0;
+}
+
+/* add the median of a subset of vectors and recursively the rest. */
+static bool _zVecTree3DFromArray(zVecTree3D *tree, zVec3D v[], int idx[], int num, zAxis axis)
+{
+  _zVecTree3DSortData data;
+  int m;
+
+  if( num <= 0 ) return true;
+  data.v = v;
+  data.axis = axis;
+  zQuickSort( idx, num, sizeof(int), _zVecTree3DCmp, &data );
+  /* vectors on the split plane have to go to the upper branch. */
+  for( m=num/2; m>0 && v[idx[m-1]].e[axis] == v[idx[m]].e[axis]; m-- );
+  if( !zVecTree3DAddID( tree, &v[idx[m]], idx[m] ) ) return false;
+  axis = ( axis + 1 ) % 3;
+  return _zVecTree3DFromArray( tree, v, idx, m, axis ) &&
+         _zVecTree3DFromArray( tree, v, idx+m+1, num-m-1, axis );
+}
+
+/* create a balanced 3D vector tree from an array. */
+zVecTree3D *zVecTree3DFromArray(zVecTree3D *tree, zVec3D v[], int num)
+{
+  int *idx;
+  register int i;
+  bool ret;
+
+  zVecTree3DInit( tree );
+  if( num <= 0 ) return tree;
+  if( !( idx = zAlloc( int, num ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  for( i=0; i<num; i++ ) idx[i] = i;
+  ret = _zVecTree3DFromArray( tree, v, idx, num, zX );
+  zFree( idx );
+  if( !ret ){
+    zVecTree3DDestroy( tree );
+    return NULL;
+  }
+  return tree;
 }
 
 /* find the partition in which a 3D vector is contained (for debug). */
@@ -154,3 +225,28 @@ double zVecTree3DNN(zVecTree3D *tree, zVec3D *v, zVecTree3D **nn)
   *nn = NULL;
   return _zVecTree3DNN( tree, v, nn, &dmin );
 }
+
+/* range search */
+
+/* an internal recursive call of the range search. */
+static int _zVecTree3DRange(zVecTree3D *node, zVec3D *v, double r, void (* f)(zVecTree3D*,void*), void *util)
+{
+  int n = 0;
+
+  if( zVec3DSqrDist( &node->v, v ) <= r*r ){
+    f( node, util );
+    n++;
+  }
+  if( node->s[0] && _zVecTree3DIsOverlap( node->s[0], v, r ) )
+    n += _zVecTree3DRange( node->s[0], v, r, f, util );
+  if( node->s[1] && _zVecTree3DIsOverlap( node->s[1], v, r ) )
+    n += _zVecTree3DRange( node->s[1], v, r, f, util );
+  return n;
+}
+
+/* find vectors in a tree within a radius from a 3D vector. */
+int zVecTree3DRange(zVecTree3D *tree, zVec3D *v, double r, void (* f)(zVecTree3D*,void*), void *util)
+{
+  if( tree->split == -1 ) return 0;
+  return _zVecTree3DRange( tree, v, r, f, util );
+}
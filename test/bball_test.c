@@ -2,19 +2,23 @@
 
 #define N 2000
 
-int main(void)
+void generate_points_rand(zVec3D v[], int n)
+{
+  register int i;
+
+  for( i=0; i<n; i++ )
+    zVec3DCreatePolar( &v[i], zRandF(-5,5), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+}
+
+void assert_bball(zVec3D v[])
 {
   zSphere3D bb;
-  zVec3D v[N];
   zVec3D *vp[4]; /* vertices on the sphere up to four. */
   register int i, n;
   double r1, r;
   int count;
   int errcode = 0;
 
-  zRandInit();
-  for( i=0; i<N; i++ )
-    zVec3DCreatePolar( &v[i], zRandF(-5,5), zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
   n = zBBall( &bb, v, N, vp );
   r = zSphere3DRadius(&bb);
 
@@ -32,5 +36,42 @@ int main(void)
   }
   printf( "error code = %d\n", errcode );
   zAssert( zBBall, errcode == 0 );
+}
+
+void assert_bball_fast(zVec3D v[])
+{
+  zSphere3D bb, bbf;
+  register int i;
+  bool ret = true;
+
+  zBBall( &bb, v, N, NULL );
+  if( !zBBallFast( &bbf, v, N ) ) ret = false;
+  for( i=0; ret && i<N; i++ )
+    if( zVec3DDist( zSphere3DCenter(&bbf), &v[i] ) > zSphere3DRadius(&bbf) + zTOL ) ret = false;
+  zAssert( zBBallFast (bounding), ret );
+  zAssert( zBBallFast (not smaller than zBBall), zSphere3DRadius(&bbf) >= zSphere3DRadius(&bb) - zTOL );
+}
+
+void assert_bball_reproducible(zVec3D v[])
+{
+  zSphere3D bb1, bb2;
+  int n1, n2;
+
+  n1 = zBBall( &bb1, v, N, NULL );
+  n2 = zBBall( &bb2, v, N, NULL );
+  zAssert( zBBall (reproducible), n1 == n2 &&
+    zVec3DEqual( zSphere3DCenter(&bb1), zSphere3DCenter(&bb2) ) &&
+    zSphere3DRadius(&bb1) == zSphere3DRadius(&bb2) );
+}
+
+int main(void)
+{
+  zVec3D v[N];
+
+  zRandInit();
+  generate_points_rand( v, N );
+  assert_bball( v );
+  assert_bball_fast( v );
+  assert_bball_reproducible( v );
   return 0;
 }
@@ -113,11 +113,43 @@ void assert_inside(void)
   zAssert( zBox3DPointIsInside, nitest == ni && notest == no );
 }
 
+void assert_colchk_batch(void)
+{
+  zBox3D b1[100], b2[100];
+  zBox3DSoA soa1, soa2;
+  zVec3D center, ax, ay, az, v;
+  bool result[100], result_one[100], ret_vert = true, ret_batch = true;
+  register int i, j;
+  int n = 100;
+
+  zBox3DSoAAlloc( &soa1, n );
+  zBox3DSoAAlloc( &soa2, n );
+  for( i=0; i<n; i++ ){
+    generate_box_rand( &b1[i], &center, &ax, &ay, &az );
+    generate_box_rand( &b2[i], &center, &ax, &ay, &az );
+    zBox3DSoASet( &soa1, i, &b1[i] );
+    zBox3DSoASet( &soa2, i, &b2[i] );
+  }
+  zColChkBox3DBatch( &soa1, &soa2, result );
+  zColChkBox3DBatchOne( &b1[0], &soa2, result_one );
+  for( i=0; i<n; i++ ){
+    if( result[i] != zColChkBox3D( &b1[i], &b2[i] ) ||
+        result_one[i] != zColChkBox3D( &b1[0], &b2[i] ) ) ret_batch = false;
+    for( j=0; j<8; j++ )
+      if( zBox3DPointIsInside( &b1[i], zBox3DVert( &b2[i], j, &v ), false ) && !zColChkBox3D( &b1[i], &b2[i] ) ) ret_vert = false;
+  }
+  zBox3DSoAFree( &soa1 );
+  zBox3DSoAFree( &soa2 );
+  zAssert( zColChkBox3D, ret_vert );
+  zAssert( zColChkBox3DBatch, ret_batch );
+}
+
 int main(void)
 {
   zRandInit();
   assert_vert();
   assert_volume_inertia();
   assert_inside();
+  assert_colchk_batch();
   return EXIT_SUCCESS;
 }
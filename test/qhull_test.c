@@ -0,0 +1,115 @@
+#include <zeo/zeo.h>
+
+#define N 1000
+
+void generate_points_rand(zVec3D p[], int n)
+{
+  register int i;
+
+  for( i=0; i<n; i++ )
+    zVec3DCreate( &p[i], zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+}
+
+/* every point is inside of or on the convex hull */
+
+void assert_inside(void)
+{
+  zPH3D ch;
+  zVec3D p[N];
+  register int i;
+  bool ret = true;
+
+  generate_points_rand( p, N );
+  if( !zCH3D( &ch, p, N ) ) ret = false;
+  for( i=0; ret && i<N; i++ )
+    if( !zPH3DPointIsInside( &ch, &p[i], true ) ) ret = false;
+  zPH3DDestroy( &ch );
+  zAssert( zCH3D (inside), ret );
+}
+
+/* Euler's formula of a convex polyhedron, where every edge is shared by two triangles */
+
+void assert_euler(void)
+{
+  zPH3D ch;
+  zVec3D p[N];
+  int v, e, f;
+  bool ret = true;
+
+  generate_points_rand( p, N );
+  if( !zCH3D( &ch, p, N ) ) ret = false;
+  v = zPH3DVertNum(&ch);
+  f = zPH3DFaceNum(&ch);
+  e = f * 3 / 2;
+  if( f % 2 != 0 || v - e + f != 2 ) ret = false;
+  zPH3DDestroy( &ch );
+  zAssert( zCH3D (Euler characteristic), ret );
+}
+
+/* volume of the convex hull of points inside of and on a cube */
+
+void assert_cube(void)
+{
+  zPH3D ch;
+  zVec3D p[N];
+  double a;
+  register int i;
+  bool ret = true;
+
+  a = zRandF(0.1,5);
+  for( i=0; i<8; i++ )
+    zVec3DCreate( &p[i], i & 0x1 ? a : -a, i & 0x2 ? a : -a, i & 0x4 ? a : -a );
+  for( ; i<N; i++ ){
+    zVec3DCreate( &p[i], zRandF(-a,a), zRandF(-a,a), zRandF(-a,a) );
+    if( i % 2 == 0 ) p[i].e[i%3] = zRandI(0,1) ? a : -a; /* on a face */
+  }
+  if( !zCH3D( &ch, p, N ) ) ret = false;
+  if( !zIsTol( zPH3DVolume(&ch) - 8*a*a*a, zTOL*a*a*a ) ) ret = false;
+  zPH3DDestroy( &ch );
+  zAssert( zCH3D (volume of cube), ret );
+}
+
+/* degenerate sets of points */
+
+void assert_degenerate(void)
+{
+  zPH3D ch;
+  zVec3D p[N], d;
+  register int i;
+  bool ret1, ret2, ret3 = true;
+
+  /* a single point */
+  zVec3DCreate( &p[0], zRandF(-3,3), zRandF(-3,3), zRandF(-3,3) );
+  ret1 = zCH3D( &ch, p, 1 ) == NULL;
+  zPH3DDestroy( &ch );
+  /* collinear points */
+  zVec3DCreate( &d, zRandF(-1,1), zRandF(-1,1), zRandF(-1,1) );
+  for( i=1; i<N; i++ )
+    zVec3DCat( &p[0], zRandF(-3,3), &d, &p[i] );
+  ret2 = zCH3D( &ch, p, N ) == NULL;
+  zPH3DDestroy( &ch );
+  /* coplanar points on z=0 in a square */
+  for( i=0; i<4; i++ )
+    zVec3DCreate( &p[i], i & 0x1 ? 1 : -1, i & 0x2 ? 1 : -1, 0 );
+  for( ; i<N; i++ )
+    zVec3DCreate( &p[i], zRandF(-1,1), zRandF(-1,1), 0 );
+  if( !zCH3D( &ch, p, N ) || zPH3DVertNum(&ch) != 4 )
+    ret3 = false;
+  else
+    for( i=0; i<zPH3DVertNum(&ch); i++ )
+      if( !zIsTiny( zPH3DVert(&ch,i)->c.z ) ) ret3 = false;
+  zPH3DDestroy( &ch );
+  zAssert( zCH3D (single point), ret1 );
+  zAssert( zCH3D (collinear points), ret2 );
+  zAssert( zCH3D (coplanar points), ret3 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_inside();
+  assert_euler();
+  assert_cube();
+  assert_degenerate();
+  return EXIT_SUCCESS;
+}
@@ -84,10 +84,33 @@ void assert_inside(void)
   zAssert( zSphere3DPointIsInside, nitest == ni && notest == no );
 }
 
+/* fitting test */
+
+void assert_fit(void)
+{
+  zSphere3D sphere, fit;
+  zVec3D v[1000];
+  double r, noise;
+  register int i;
+
+  generate_sphere_rand( &sphere );
+  noise = 0.01 * zSphere3DRadius(&sphere);
+  for( i=0; i<1000; i++ ){
+    r = zSphere3DRadius(&sphere) + zRandF(-noise,noise);
+    zVec3DCreatePolar( &v[i], r, zRandF(-zPI,zPI), zRandF(-0.5*zPI,0.5*zPI) );
+    zVec3DAddDRC( &v[i], zSphere3DCenter(&sphere) );
+  }
+  zSphere3DFitArray( &fit, v, 1000 );
+  zAssert( zSphere3DFitArray,
+    zVec3DDist( zSphere3DCenter(&fit), zSphere3DCenter(&sphere) ) < noise &&
+    fabs( zSphere3DRadius(&fit) - zSphere3DRadius(&sphere) ) < noise );
+}
+
 int main(void)
 {
   zRandInit();
   assert_volume_inertia();
   assert_inside();
+  assert_fit();
   return EXIT_SUCCESS;
 }